@@ -0,0 +1,62 @@
+#ifndef PERFVECT_BENCH_HELPER_H
+#define PERFVECT_BENCH_HELPER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <thread>
+#include <vector>
+
+// Minimal timing helpers shared by the benchmark executables, free of dependencies like the library itself.
+
+// prevents the compiler from discarding a computed value
+template<typename T>
+inline auto do_not_optimize(const T& value) {
+	#if defined(_MSC_VER) && !defined(__clang__)
+	static const volatile void* sink;
+	sink = &value;
+	#else
+	asm volatile("" : : "r"(&value) : "memory");
+	#endif
+}
+
+// best wall time of several runs of func, in milliseconds
+template<typename Func>
+inline auto time_ms(Func&& func, const int runs = 5) {
+	auto best = std::numeric_limits<double>::max();
+	for (auto run = 0; run < runs; ++run) {
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+		best = std::min(best, elapsed.count());
+	}
+	return best;
+}
+
+// millions of operations per second for count operations taking ms milliseconds
+inline auto mops(const double count, const double ms) {
+	return ms > 0 ? count / ms / 1000.0 : 0.0;
+}
+
+// repetitions of an operation over size elements adding up to at least total elements, so that the timings of short
+// inputs stay long enough to measure
+inline auto repetitions(const std::size_t size, const std::size_t total) {
+	return std::max<std::size_t>(total / size, 1);
+}
+
+// powers of two from 1 up to and including max_threads, defaulting to the hardware concurrency
+inline auto thread_counts(unsigned max_threads = std::thread::hardware_concurrency()) {
+	max_threads = std::max(1u, max_threads);
+	std::vector<unsigned> counts;
+	for (auto threads = 1u; threads < max_threads; threads *= 2) counts.push_back(threads);
+	counts.push_back(max_threads);
+	return counts;
+}
+
+inline auto print_header(const char* title) {
+	std::printf("\n%s\n", title);
+}
+
+#endif
\ No newline at end of file
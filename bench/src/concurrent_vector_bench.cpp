@@ -0,0 +1,64 @@
+#include "bench.h"
+#include <perfvect/concurrent_vector.h>
+#include <perfvect/vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Appends a fixed total number of elements split across 1..N producer threads, comparing a mutex-protected
+// perfvect::vector against concurrent_vector::push_back and concurrent_vector::grow_by in batches.
+
+namespace {
+	constexpr std::size_t total_elements = 1 << 22;
+	constexpr std::size_t batch_size = 64;
+
+	template<typename Producer>
+	auto run_producers(const unsigned threads, Producer&& producer) {
+		std::vector<std::thread> workers;
+		const auto per_thread = total_elements / threads;
+		for (unsigned t = 0; t < threads; ++t) {
+			workers.emplace_back([&producer, per_thread, t] { producer(per_thread, t); });
+		}
+		for (auto& worker : workers) worker.join();
+	}
+}
+
+int main() {
+	print_header("concurrent append, Mops/s");
+	std::printf("%8s %16s %16s %16s\n", "threads", "mutex+vector", "push_back", "grow_by(64)");
+
+	for (const auto threads : thread_counts()) {
+		const auto locked_ms = time_ms([&] {
+			perfvect::vector<std::uint64_t> vec;
+			std::mutex mutex;
+			run_producers(threads, [&](const std::size_t count, const unsigned t) {
+				for (std::size_t i = 0; i < count; ++i) {
+					std::lock_guard lock(mutex);
+					vec.push_back(t * count + i);
+				}
+			});
+			do_not_optimize(vec.size());
+		});
+
+		const auto push_ms = time_ms([&] {
+			perfvect::concurrent_vector<std::uint64_t> vec;
+			run_producers(threads, [&](const std::size_t count, const unsigned t) {
+				for (std::size_t i = 0; i < count; ++i) vec.push_back(t * count + i);
+			});
+			do_not_optimize(vec.size());
+		});
+
+		const auto grow_ms = time_ms([&] {
+			perfvect::concurrent_vector<std::uint64_t> vec;
+			run_producers(threads, [&](const std::size_t count, const unsigned t) {
+				for (std::size_t i = 0; i < count; i += batch_size) vec.grow_by(batch_size, t);
+			});
+			do_not_optimize(vec.size());
+		});
+
+		std::printf("%8u %16.1f %16.1f %16.1f\n", threads,
+			mops(total_elements, locked_ms), mops(total_elements, push_ms), mops(total_elements, grow_ms));
+	}
+}
\ No newline at end of file
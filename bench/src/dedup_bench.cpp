@@ -0,0 +1,75 @@
+#include "bench.h"
+#include <perfvect/small_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+// Deduplication of a small_vector<std::uint64_t> drawn from a quarter as many distinct values as elements. dedup() on
+// sorted input is compared with std::unique and erase, and dedup_unordered() with the sort, std::unique and erase it
+// replaces (which loses the order) and with filtering through a std::unordered_set (which keeps it). Every timing
+// includes copying the input to work on.
+
+namespace {
+	using vec_t = perfvect::small_vector<std::uint64_t, 16>;
+
+	auto report(const char* op, const std::size_t size, const char* how, const double ms) {
+		std::printf("%16s %9zu %18s %12.1f\n", op, size, how, mops(static_cast<double>(size), ms));
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(17);
+
+	print_header("deduplication of small_vector<uint64_t>, Melem/s");
+	std::printf("%16s %9s %18s %12s\n", "operation", "size", "version", "Melem/s");
+
+	for (const std::size_t size : {std::size_t{64}, std::size_t{1000}, std::size_t{1} << 16, std::size_t{1} << 22}) {
+		vec_t values;
+		for (std::size_t i = 0; i < size; ++i) values.push_back(rng() % (size / 4 + 1));
+		auto sorted = values;
+		std::sort(sorted.begin(), sorted.end());
+		const auto reps = repetitions(size, std::size_t{1} << 22);
+		const auto elements = reps * size;
+
+		report("sorted", size, "std::unique", time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) {
+				auto vec = sorted;
+				vec.erase(std::unique(vec.begin(), vec.end()), vec.end());
+				do_not_optimize(vec.size());
+			}
+		}) * static_cast<double>(size) / static_cast<double>(elements));
+		report("sorted", size, "dedup", time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) {
+				auto vec = sorted;
+				vec.dedup();
+				do_not_optimize(vec.size());
+			}
+		}) * static_cast<double>(size) / static_cast<double>(elements));
+
+		report("unsorted", size, "sort+unique", time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) {
+				auto vec = values;
+				std::sort(vec.begin(), vec.end());
+				vec.erase(std::unique(vec.begin(), vec.end()), vec.end());
+				do_not_optimize(vec.size());
+			}
+		}) * static_cast<double>(size) / static_cast<double>(elements));
+		report("unsorted", size, "unordered_set", time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) {
+				auto vec = values;
+				std::unordered_set<std::uint64_t> seen;
+				vec.erase_if([&seen](const std::uint64_t value) { return !seen.insert(value).second; });
+				do_not_optimize(vec.size());
+			}
+		}) * static_cast<double>(size) / static_cast<double>(elements));
+		report("unsorted", size, "dedup_unordered", time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) {
+				auto vec = values;
+				vec.dedup_unordered();
+				do_not_optimize(vec.size());
+			}
+		}) * static_cast<double>(size) / static_cast<double>(elements));
+	}
+}
@@ -0,0 +1,68 @@
+#include "bench.h"
+#include <perfvect/intern_pool.h>
+#include <perfvect/small_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Memory footprint and equality throughput of many small label sets held as small_vector values against the same
+// sets interned into an intern_pool and held as handles, with few distinct sets among many values.
+
+namespace {
+	using labels = perfvect::small_vector<std::uint32_t, 8>;
+
+	auto make_values(const std::size_t count, const std::uint32_t distinct) {
+		std::mt19937 rng(1);
+		std::vector<labels> values;
+		values.reserve(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto set = static_cast<std::uint32_t>(rng() % distinct);
+			labels vec;
+			for (std::uint32_t j = 0; j < 4 + set % 5; ++j) vec.push_back(set * 16 + j);
+			values.push_back(std::move(vec));
+		}
+		return values;
+	}
+
+	auto same(const labels& a, const labels& b) {
+		return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+	}
+}
+
+int main() {
+	constexpr std::size_t count = std::size_t{1} << 20;
+
+	print_header("equality of neighbouring label sets");
+	std::printf("%10s %20s %12s %12s\n", "distinct", "representation", "MiB", "Mcmp/s");
+
+	for (const std::uint32_t distinct : {16u, 1024u, 65536u}) {
+		const auto values = make_values(count, distinct);
+		const auto report = [distinct](const char* name, const std::size_t bytes, const double ms) {
+			std::printf("%10u %20s %12.2f %12.1f\n", distinct, name, static_cast<double>(bytes) / (1 << 20), mops(static_cast<double>(count), ms));
+		};
+
+		std::size_t equal = 0;
+		const auto vector_ms = time_ms([&] {
+			for (std::size_t i = 1; i < count; ++i) equal += same(values[i - 1], values[i]);
+		});
+		report("small_vector", count * sizeof(labels), vector_ms);
+
+		perfvect::intern_pool<labels> pool;
+		std::vector<perfvect::intern_handle> handles;
+		handles.reserve(count);
+		const auto intern_ms = time_ms([&] {
+			handles.clear();
+			for (const auto& value : values) handles.push_back(pool.intern(value));
+		}, 1);
+
+		const auto handle_ms = time_ms([&] {
+			for (std::size_t i = 1; i < count; ++i) equal += handles[i - 1] == handles[i];
+		});
+		do_not_optimize(equal);
+		// arena elements plus an entry record and index slots per distinct set
+		const auto pool_bytes = pool.element_count() * sizeof(std::uint32_t) + pool.size() * 24;
+		report("intern_handle", count * sizeof(perfvect::intern_handle) + pool_bytes, handle_ms);
+		std::printf("%10u %20s %12s %12.1f\n", distinct, "(interning)", "", mops(static_cast<double>(count), intern_ms));
+	}
+}
\ No newline at end of file
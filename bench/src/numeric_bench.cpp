@@ -0,0 +1,105 @@
+#include "bench.h"
+#include <perfvect/numeric.h>
+#include <perfvect/small_vector.h>
+#include <perfvect/static_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// The numeric layer against the loops it replaces: a fused a = b * s + c, sum, dot, min and argmin over a float
+// small_vector, and dot products of many short static_vector feature vectors, where the fully unrolled kernels apply.
+// The loops are plain scalar code, which the compiler is free to vectorize for the baseline instruction set.
+
+namespace {
+	template<typename Perfvect, typename Loop>
+	auto compare(const char* op, const std::size_t size, const double elements, Perfvect&& perfvect_op, Loop&& loop_op) {
+		const auto loop_ms = time_ms(loop_op);
+		const auto perfvect_ms = time_ms(perfvect_op);
+		std::printf("%16s %9zu %14.1f %14.1f %9.2fx\n", op, size, mops(elements, loop_ms), mops(elements, perfvect_ms), loop_ms / perfvect_ms);
+	}
+
+	template<std::size_t Dims>
+	auto compare_features(std::mt19937& rng) {
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+		std::vector<perfvect::static_vector<float, Dims>> features(1 << 14);
+		for (auto& feature : features) {
+			for (std::size_t dim = 0; dim < Dims; ++dim) feature.push_back(dist(rng));
+		}
+		const auto query = features[7];
+
+		compare("feature dot", Dims, static_cast<double>(features.size() * Dims), [&] {
+			auto best = 0.0f;
+			for (const auto& feature : features) best = std::max(best, perfvect::dot(query, feature));
+			do_not_optimize(best);
+		}, [&] {
+			auto best = 0.0f;
+			for (const auto& feature : features) {
+				auto dot = 0.0f;
+				for (std::size_t dim = 0; dim < feature.size(); ++dim) dot += query[dim] * feature[dim];
+				best = std::max(best, dot);
+			}
+			do_not_optimize(best);
+		});
+	}
+}
+
+int main() {
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	print_header("numeric layer over float containers, Melem/s");
+	std::printf("%16s %9s %14s %14s %10s\n", "operation", "size", "scalar loop", "perfvect", "speedup");
+
+	for (const std::size_t size : {std::size_t{1000}, std::size_t{1} << 16, std::size_t{1} << 22}) {
+		using vec_t = perfvect::small_vector<float, 16>;
+		vec_t a(size, 0.0f);
+		vec_t b;
+		vec_t c;
+		for (std::size_t i = 0; i < size; ++i) {
+			b.push_back(dist(rng));
+			c.push_back(dist(rng));
+		}
+		const auto scale = 1.5f;
+		const auto reps = repetitions(size, std::size_t{1} << 22);
+		const auto elements = static_cast<double>(reps * size);
+
+		compare("a = b * s + c", size, elements, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) {
+				a = b * scale + c;
+				do_not_optimize(a.data());
+			}
+		}, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) {
+				for (std::size_t i = 0; i < size; ++i) a[i] = b[i] * scale + c[i];
+				do_not_optimize(a.data());
+			}
+		});
+		compare("sum", size, elements, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) do_not_optimize(perfvect::sum(b));
+		}, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) do_not_optimize(std::accumulate(b.begin(), b.end(), 0.0f));
+		});
+		compare("dot", size, elements, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) do_not_optimize(perfvect::dot(b, c));
+		}, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) do_not_optimize(std::inner_product(b.begin(), b.end(), c.begin(), 0.0f));
+		});
+		compare("min", size, elements, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) do_not_optimize(perfvect::min(b));
+		}, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) do_not_optimize(*std::min_element(b.begin(), b.end()));
+		});
+		compare("argmin", size, elements, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) do_not_optimize(perfvect::argmin(b));
+		}, [&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) do_not_optimize(std::min_element(b.begin(), b.end()) - b.begin());
+		});
+	}
+
+	compare_features<8>(rng);
+	compare_features<16>(rng);
+	compare_features<64>(rng);
+	compare_features<100>(rng);
+}
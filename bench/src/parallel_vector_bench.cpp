@@ -0,0 +1,64 @@
+#include "bench.h"
+#include <perfvect/parallel.h>
+#include <perfvect/vector.h>
+#include <cstdint>
+#include <vector>
+
+// Scaling of vector's parallel bulk operations from 1 to 32 workers of a thread_pool, over 2^25 64-bit elements
+// (256 MiB), against the serial member on the same data. Worker counts above the hardware concurrency oversubscribe
+// the cores and are shown for completeness. insert_range and erase_if rows include copying the source to work on,
+// which is done in parallel in the parallel rows.
+
+namespace {
+	constexpr std::size_t count = std::size_t{1} << 25;
+
+	using vec_t = perfvect::vector<std::uint64_t>;
+}
+
+int main() {
+	const vec_t source(count, 1);
+	const std::vector<std::uint64_t> range(count / 4, 2);
+
+	const auto report = [](const char* op, const char* workers, const double ms) {
+		std::printf("%16s %8s %10.1f %12.1f\n", op, workers, ms, mops(static_cast<double>(count), ms));
+	};
+
+	print_header("parallel bulk operations");
+	std::printf("%16s %8s %10s %12s\n", "operation", "workers", "ms", "Melem/s");
+
+	report("assign", "serial", time_ms([] { vec_t vec; vec.assign(count, 3); do_not_optimize(vec[0]); }));
+	auto filled = source;
+	report("fill", "serial", time_ms([&] { filled.fill(3); do_not_optimize(filled[0]); }));
+	report("resize", "serial", time_ms([] { vec_t vec; vec.resize(count); do_not_optimize(vec[0]); }));
+	report("copy", "serial", time_ms([&] { const vec_t vec(source); do_not_optimize(vec[0]); }));
+	report("insert_range", "serial", time_ms([&] {
+		auto vec = source;
+		vec.insert(vec.begin() + count / 2, range.begin(), range.end());
+		do_not_optimize(vec[0]);
+	}));
+	report("erase_if", "serial", time_ms([&] { auto vec = source; vec.erase_if([](const std::uint64_t value) { return value & 1; }); do_not_optimize(vec.size()); }));
+
+	for (const auto threads : {1u, 2u, 4u, 8u, 16u, 32u}) {
+		perfvect::thread_pool pool(threads);
+		const perfvect::parallel_policy policy(pool);
+		char workers[16];
+		std::snprintf(workers, sizeof(workers), "%u", threads);
+
+		report("assign", workers, time_ms([&] { vec_t vec; vec.assign(policy, count, 3); do_not_optimize(vec[0]); }));
+		const vec_t touched(policy, source);
+		filled = touched;
+		report("fill", workers, time_ms([&] { filled.fill(policy, 3); do_not_optimize(filled[0]); }));
+		report("resize", workers, time_ms([&] { vec_t vec; vec.resize(policy, count); do_not_optimize(vec[0]); }));
+		report("copy", workers, time_ms([&] { const vec_t vec(policy, source); do_not_optimize(vec[0]); }));
+		report("insert_range", workers, time_ms([&] {
+			vec_t vec(policy, source);
+			vec.insert_range(policy, vec.begin() + count / 2, range.begin(), range.end());
+			do_not_optimize(vec[0]);
+		}));
+		report("erase_if", workers, time_ms([&] {
+			vec_t vec(policy, source);
+			vec.erase_if(policy, [](const std::uint64_t value) { return value & 1; });
+			do_not_optimize(vec.size());
+		}));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "bench.h"
+#include <perfvect/parallel.h>
+#include <perfvect/scan.h>
+#include <perfvect/vector.h>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Scans, delta coding and a 256-bin histogram over a perfvect::vector<std::uint32_t>, in place, against the std::
+// algorithms over the vector's own iterators and a plain counting loop. The histogram is taken of uniform values and of
+// skewed ones, seven in eight of which are the same. The serial rows use sizes that fit the L1 and L2 caches and one
+// that does not; the parallel rows repeat the largest size with 1 to 16 workers of a thread_pool.
+
+namespace {
+	using vec_t = perfvect::vector<std::uint32_t>;
+
+	auto report(const char* op, const std::size_t size, const char* how, const double elements, const double ms) {
+		std::printf("%16s %9zu %10s %12.1f\n", op, size, how, mops(elements, ms));
+	}
+}
+
+int main() {
+	std::mt19937 rng(3);
+
+	print_header("scan kernels over vector<uint32_t>, Melem/s");
+	std::printf("%16s %9s %10s %12s\n", "operation", "size", "version", "Melem/s");
+
+	for (const std::size_t size : {std::size_t{4096}, std::size_t{1} << 16, std::size_t{1} << 24}) {
+		vec_t values;
+		vec_t skewed;
+		for (std::size_t i = 0; i < size; ++i) {
+			values.push_back(rng() % 256);
+			skewed.push_back(rng() % 8 ? 7 : rng() % 256);
+		}
+		auto work = values;
+		vec_t counts(256, 0);
+		const auto reps = repetitions(size, std::size_t{1} << 24);
+		const auto elements = static_cast<double>(reps * size);
+
+		report("inclusive_scan", size, "std", elements, time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) std::inclusive_scan(work.begin(), work.end(), work.begin());
+			do_not_optimize(work[0]);
+		}));
+		report("inclusive_scan", size, "perfvect", elements, time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) perfvect::inclusive_scan(work);
+			do_not_optimize(work[0]);
+		}));
+		report("exclusive_scan", size, "std", elements, time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) std::exclusive_scan(work.begin(), work.end(), work.begin(), 0u);
+			do_not_optimize(work[0]);
+		}));
+		report("exclusive_scan", size, "perfvect", elements, time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) perfvect::exclusive_scan(work);
+			do_not_optimize(work[0]);
+		}));
+		report("delta_encode", size, "std", elements, time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) std::adjacent_difference(work.begin(), work.end(), work.begin());
+			do_not_optimize(work[0]);
+		}));
+		report("delta_encode", size, "perfvect", elements, time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) perfvect::delta_encode(work);
+			do_not_optimize(work[0]);
+		}));
+		for (const auto* data : {&values, &skewed}) {
+			const auto name = data == &values ? "histogram" : "skewed histogram";
+			report(name, size, "loop", elements, time_ms([&] {
+				for (std::size_t rep = 0; rep < reps; ++rep) {
+					for (const auto value : *data) {
+						if (value < counts.size()) ++counts[value];
+					}
+				}
+				do_not_optimize(counts[0]);
+			}));
+			report(name, size, "perfvect", elements, time_ms([&] {
+				for (std::size_t rep = 0; rep < reps; ++rep) do_not_optimize(perfvect::histogram(*data, counts));
+			}));
+		}
+	}
+
+	const std::size_t size = std::size_t{1} << 24;
+	vec_t values;
+	for (std::size_t i = 0; i < size; ++i) values.push_back(rng() % 256);
+	auto work = values;
+	vec_t counts(256, 0);
+	for (const auto threads : {1u, 2u, 4u, 8u, 16u}) {
+		perfvect::thread_pool pool(threads);
+		const perfvect::parallel_policy policy(pool);
+		char workers[16];
+		std::snprintf(workers, sizeof(workers), "%u thr", threads);
+
+		report("inclusive_scan", size, workers, static_cast<double>(size), time_ms([&] { perfvect::inclusive_scan(policy, work); do_not_optimize(work[0]); }));
+		report("delta_encode", size, workers, static_cast<double>(size), time_ms([&] { perfvect::delta_encode(policy, work); do_not_optimize(work[0]); }));
+		report("histogram", size, workers, static_cast<double>(size), time_ms([&] { do_not_optimize(perfvect::histogram(policy, values, counts)); }));
+	}
+}
@@ -0,0 +1,97 @@
+#include "bench.h"
+#include <perfvect/set_operations.h>
+#include <perfvect/small_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+// Sorted-set algebra over posting lists of 32-bit document ids held in small_vector: intersect_into, union_into,
+// difference_into and merge_into against the std:: algorithm writing through a back_inserter into a destination
+// reserved up front, for lists of equal size and for skewed pairs of a short list against a long one.
+
+namespace {
+	using list_t = perfvect::small_vector<std::uint32_t, 16>;
+
+	auto make_list(std::mt19937& rng, const std::size_t count, const std::uint32_t stride) {
+		list_t list;
+		std::uint32_t id = 0;
+		for (std::size_t i = 0; i < count; ++i) {
+			id += 1 + rng() % stride;
+			list.push_back(id);
+		}
+		return list;
+	}
+
+	// pairs of lists of the given sizes, enough of them that short lists are not the same few the branch predictor
+	// learns by heart; ids of both lists are spread evenly over the same range
+	auto make_pairs(std::mt19937& rng, const std::size_t size_a, const std::size_t size_b) {
+		const auto count = std::clamp<std::size_t>((std::size_t{1} << 20) / (size_a + size_b), 1, 256);
+		std::vector<std::pair<list_t, list_t>> pairs;
+		for (std::size_t pair = 0; pair < count; ++pair) {
+			pairs.emplace_back(
+				make_list(rng, size_a, static_cast<std::uint32_t>(8 * (std::size_t{1} << 20) / size_a)),
+				make_list(rng, size_b, static_cast<std::uint32_t>(8 * (std::size_t{1} << 20) / size_b))
+			);
+		}
+		return pairs;
+	}
+
+	template<typename Perfvect, typename Std>
+	auto compare(const char* op, const std::vector<std::pair<list_t, list_t>>& pairs, Perfvect&& perfvect_op, Std&& std_op) {
+		const auto size_a = pairs.front().first.size();
+		const auto size_b = pairs.front().second.size();
+		list_t out;
+		out.reserve(size_a + size_b);
+
+		// the pairs are gone through repeatedly, so each timing covers a few million elements
+		const auto reps = std::max<std::size_t>((std::size_t{1} << 22) / (pairs.size() * (size_a + size_b)), 1);
+		const auto elements = static_cast<double>(reps * pairs.size() * (size_a + size_b));
+
+		const auto std_ms = time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) {
+				for (const auto& pair : pairs) {
+					out.clear();
+					std_op(pair.first, pair.second, std::back_inserter(out));
+					do_not_optimize(out.size());
+				}
+			}
+		});
+		const auto perfvect_ms = time_ms([&] {
+			for (std::size_t rep = 0; rep < reps; ++rep) {
+				for (const auto& pair : pairs) {
+					out.clear();
+					perfvect_op(pair.first, pair.second, out);
+					do_not_optimize(out.size());
+				}
+			}
+		});
+		std::printf("%12s %9zu %9zu %14.1f %14.1f %9.2fx\n", op, size_a, size_b, mops(elements, std_ms), mops(elements, perfvect_ms), std_ms / perfvect_ms);
+	}
+}
+
+int main() {
+	std::mt19937 rng(5);
+
+	print_header("sorted-set algebra, Melem/s of input");
+	std::printf("%12s %9s %9s %14s %14s %10s\n", "operation", "|a|", "|b|", "std + inserter", "perfvect", "speedup");
+
+	const std::pair<std::size_t, std::size_t> sizes[] = {{1000, 1000}, {1 << 20, 1 << 20}, {1000, 1 << 20}, {1 << 15, 1 << 20}};
+	for (const auto& size : sizes) {
+		const auto pairs = make_pairs(rng, size.first, size.second);
+
+		compare("intersect", pairs,
+			[](const list_t& x, const list_t& y, list_t& out) { perfvect::intersect_into(x, y, out); },
+			[](const list_t& x, const list_t& y, auto out) { std::set_intersection(x.begin(), x.end(), y.begin(), y.end(), out); });
+		compare("union", pairs,
+			[](const list_t& x, const list_t& y, list_t& out) { perfvect::union_into(x, y, out); },
+			[](const list_t& x, const list_t& y, auto out) { std::set_union(x.begin(), x.end(), y.begin(), y.end(), out); });
+		compare("difference", pairs,
+			[](const list_t& x, const list_t& y, list_t& out) { perfvect::difference_into(x, y, out); },
+			[](const list_t& x, const list_t& y, auto out) { std::set_difference(x.begin(), x.end(), y.begin(), y.end(), out); });
+		compare("merge", pairs,
+			[](const list_t& x, const list_t& y, list_t& out) { perfvect::merge_into(x, y, out); },
+			[](const list_t& x, const list_t& y, auto out) { std::merge(x.begin(), x.end(), y.begin(), y.end(), out); });
+	}
+}
\ No newline at end of file
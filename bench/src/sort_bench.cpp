@@ -0,0 +1,103 @@
+#include "bench.h"
+#include <perfvect/small_vector.h>
+#include <perfvect/static_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// sort() and sort_by_key() against std::sort over the same elements, at every size class: the sorting network up to
+// 64 elements, std::sort in between and the radix sort from a few hundred elements. Each run re-sorts enough shuffled
+// copies to touch about a million elements, and the copying is timed on both sides.
+
+namespace {
+	constexpr std::size_t elements_per_run = std::size_t{1} << 20;
+
+	template<typename T>
+	auto make_values(const std::size_t count) {
+		std::mt19937_64 rng(42);
+		std::vector<T> values(count);
+		for (auto& value : values) {
+			if constexpr (std::is_floating_point_v<T>) value = static_cast<T>(std::uniform_real_distribution<double>(-1e9, 1e9)(rng));
+			else value = static_cast<T>(rng());
+		}
+		return values;
+	}
+
+	template<typename Vec, typename T>
+	auto compare(const char* type, const std::size_t size) {
+		const auto values = make_values<T>(elements_per_run);
+		const auto copies = elements_per_run / size;
+		Vec vec;
+
+		const auto perfvect_ms = time_ms([&] {
+			for (std::size_t copy = 0; copy < copies; ++copy) {
+				vec.assign(values.begin() + copy * size, values.begin() + (copy + 1) * size);
+				vec.sort();
+				do_not_optimize(vec[0]);
+			}
+		});
+		const auto std_ms = time_ms([&] {
+			for (std::size_t copy = 0; copy < copies; ++copy) {
+				vec.assign(values.begin() + copy * size, values.begin() + (copy + 1) * size);
+				std::sort(vec.begin(), vec.end());
+				do_not_optimize(vec[0]);
+			}
+		});
+
+		const auto elements = static_cast<double>(copies * size);
+		std::printf("%10s %10zu %14.1f %14.1f %9.2fx\n", type, size, mops(elements, std_ms), mops(elements, perfvect_ms), std_ms / perfvect_ms);
+	}
+
+	template<typename T>
+	auto compare_sizes(const char* type) {
+		compare<perfvect::static_vector<T, 8>, T>(type, 8);
+		compare<perfvect::static_vector<T, 16>, T>(type, 16);
+		compare<perfvect::static_vector<T, 32>, T>(type, 32);
+		compare<perfvect::static_vector<T, 64>, T>(type, 64);
+		for (const std::size_t size : {128, 256, 512, 1024, 4096, 65536, 1 << 20}) compare<perfvect::small_vector<T, 8>, T>(type, size);
+	}
+
+	struct order {
+		std::uint64_t id;
+		double price;
+		std::uint32_t quantity;
+	};
+}
+
+int main() {
+	print_header("sort(), Melem/s");
+	std::printf("%10s %10s %14s %14s %10s\n", "type", "size", "std::sort", "sort()", "speedup");
+	compare_sizes<std::uint32_t>("uint32");
+	compare_sizes<std::int64_t>("int64");
+	compare_sizes<float>("float");
+	compare_sizes<double>("double");
+
+	print_header("sort_by_key() of 24-byte records by a double, Melem/s");
+	std::printf("%10s %14s %14s %10s\n", "size", "std::sort", "sort_by_key()", "speedup");
+	for (const std::size_t size : {64, 512, 4096, 65536, 1 << 20}) {
+		const auto prices = make_values<double>(elements_per_run);
+		std::vector<order> orders;
+		for (std::size_t i = 0; i < elements_per_run; ++i) orders.push_back({i, prices[i], static_cast<std::uint32_t>(i)});
+		const auto copies = elements_per_run / size;
+		perfvect::small_vector<order, 8> vec;
+
+		const auto perfvect_ms = time_ms([&] {
+			for (std::size_t copy = 0; copy < copies; ++copy) {
+				vec.assign(orders.begin() + copy * size, orders.begin() + (copy + 1) * size);
+				vec.sort_by_key([](const order& o) { return o.price; });
+				do_not_optimize(vec[0]);
+			}
+		});
+		const auto std_ms = time_ms([&] {
+			for (std::size_t copy = 0; copy < copies; ++copy) {
+				vec.assign(orders.begin() + copy * size, orders.begin() + (copy + 1) * size);
+				std::sort(vec.begin(), vec.end(), [](const order& a, const order& b) { return a.price < b.price; });
+				do_not_optimize(vec[0]);
+			}
+		});
+
+		const auto elements = static_cast<double>(copies * size);
+		std::printf("%10zu %14.1f %14.1f %9.2fx\n", size, mops(elements, std_ms), mops(elements, perfvect_ms), std_ms / perfvect_ms);
+	}
+}
\ No newline at end of file
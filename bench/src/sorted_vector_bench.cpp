@@ -0,0 +1,56 @@
+#include "bench.h"
+#include <perfvect/sorted_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Random lookup throughput of sorted_vector in both layouts against std::lower_bound on a std::vector, for sizes
+// ranging from a few KiB (L1 resident) up to tens of MiB (DRAM bound).
+
+namespace {
+	constexpr std::size_t lookups = 1 << 20;
+
+	template<typename Search>
+	auto lookup_rate(const std::vector<std::uint64_t>& keys, Search&& search) {
+		std::uint64_t checksum = 0;
+		const auto ms = time_ms([&] {
+			for (const auto key : keys) checksum += search(key);
+		}, 3);
+		do_not_optimize(checksum);
+		return mops(static_cast<double>(keys.size()), ms);
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(1);
+
+	print_header("random lower_bound lookups, Mlookups/s");
+	std::printf("%12s %12s %16s %16s %16s\n", "elements", "bytes", "std::lower_bound", "sorted", "eytzinger");
+
+	for (std::size_t n = std::size_t{1} << 10; n <= std::size_t{1} << 23; n <<= 2) {
+		std::vector<std::uint64_t> values(n);
+		for (std::size_t i = 0; i < n; ++i) values[i] = i * 2;
+
+		std::vector<std::uint64_t> keys(lookups);
+		for (auto& key : keys) key = rng() % (n * 2);
+
+		const auto baseline = lookup_rate(keys, [&](const std::uint64_t key) {
+			return static_cast<std::uint64_t>(std::lower_bound(values.begin(), values.end(), key) - values.begin());
+		});
+
+		double sorted_rate;
+		{
+			const perfvect::sorted_vector<std::uint64_t, 16, perfvect::sorted_layout::sorted> vec(values.begin(), values.end());
+			sorted_rate = lookup_rate(keys, [&](const std::uint64_t key) { return vec.lower_bound_index(key); });
+		}
+
+		double eytzinger_rate;
+		{
+			const perfvect::sorted_vector<std::uint64_t, 16, perfvect::sorted_layout::eytzinger> vec(values.begin(), values.end());
+			eytzinger_rate = lookup_rate(keys, [&](const std::uint64_t key) { return vec.lower_bound_index(key); });
+		}
+
+		std::printf("%12zu %12zu %16.1f %16.1f %16.1f\n", n, n * sizeof(std::uint64_t), baseline, sorted_rate, eytzinger_rate);
+	}
+}
\ No newline at end of file
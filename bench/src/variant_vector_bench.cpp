@@ -0,0 +1,97 @@
+#include "bench.h"
+#include <perfvect/small_vector.h>
+#include <perfvect/variant_vector.h>
+#include <cstdint>
+#include <random>
+#include <variant>
+
+// Memory footprint and summing throughput of variant_vector (with and without its order index) against
+// small_vector<std::variant>, for a mix of mostly small alternatives with an occasional large one.
+
+namespace {
+	struct point {
+		float x, y;
+	};
+
+	struct particle {
+		float position[3];
+		float velocity[3];
+	};
+
+	struct box {
+		double min[3];
+		double max[3];
+		std::uint64_t id;
+	};
+
+	using variant_t = std::variant<point, particle, box>;
+
+	struct weight {
+		auto operator()(const point& p) const { return static_cast<double>(p.x + p.y); }
+		auto operator()(const particle& p) const { return static_cast<double>(p.velocity[0] + p.velocity[1] + p.velocity[2]); }
+		auto operator()(const box& b) const { return b.max[0] - b.min[0]; }
+	};
+
+	template<typename Vec>
+	auto fill(Vec& vec, const std::size_t count) {
+		std::mt19937 rng(1);
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto pick = rng() % 100;
+			const auto f = static_cast<float>(i % 7);
+			if (pick < 70) vec.push_back(point{f, f});
+			else if (pick < 95) vec.push_back(particle{{f, f, f}, {f, 1, 2}});
+			else vec.push_back(box{{0, 0, 0}, {f, f, f}, i});
+		}
+	}
+
+	template<typename VariantVector>
+	auto bytes_used(const VariantVector& vec, const std::size_t index_bytes) {
+		return vec.template column<point>().capacity() * sizeof(point)
+			+ vec.template column<particle>().capacity() * sizeof(particle)
+			+ vec.template column<box>().capacity() * sizeof(box)
+			+ index_bytes;
+	}
+}
+
+int main() {
+	print_header("summing a field across mixed alternatives");
+	std::printf("%10s %24s %12s %12s\n", "elements", "container", "MiB", "Melem/s");
+
+	for (std::size_t n = std::size_t{1} << 12; n <= std::size_t{1} << 22; n <<= 5) {
+		const auto report = [n](const char* name, const std::size_t bytes, const double ms) {
+			std::printf("%10zu %24s %12.2f %12.1f\n", n, name, static_cast<double>(bytes) / (1 << 20), mops(static_cast<double>(n), ms));
+		};
+
+		{
+			perfvect::small_vector<variant_t, 16> vec;
+			fill(vec, n);
+			double sum = 0;
+			const auto ms = time_ms([&] {
+				for (const auto& value : vec) sum += std::visit(weight{}, value);
+			});
+			do_not_optimize(sum);
+			report("small_vector<variant>", vec.capacity() * sizeof(variant_t), ms);
+		}
+
+		{
+			perfvect::variant_vector<point, particle, box> vec;
+			fill(vec, n);
+			double sum = 0;
+			const auto ordered_ms = time_ms([&] { vec.visit_ordered([&sum](const auto& value) { sum += weight{}(value); }); });
+			const auto batched_ms = time_ms([&] { vec.visit_batched([&sum](const auto& value) { sum += weight{}(value); }); });
+			do_not_optimize(sum);
+			const auto bytes = bytes_used(vec, vec.size() * sizeof(std::uint64_t));
+			report("variant_vector ordered", bytes, ordered_ms);
+			report("variant_vector batched", bytes, batched_ms);
+		}
+
+		{
+			perfvect::unordered_variant_vector<point, particle, box> vec;
+			fill(vec, n);
+			double sum = 0;
+			const auto ms = time_ms([&] { vec.visit_batched([&sum](const auto& value) { sum += weight{}(value); }); });
+			do_not_optimize(sum);
+			report("unordered batched", bytes_used(vec, 0), ms);
+		}
+	}
+}
\ No newline at end of file
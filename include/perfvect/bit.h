@@ -0,0 +1,53 @@
+#ifndef PERFVECT_BIT_H
+#define PERFVECT_BIT_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace perfvect {
+namespace detail {
+
+// portable stand-ins for the C++20 <bit> functions, mapped to single instructions where the compiler allows
+
+[[nodiscard]] inline auto popcount(const std::uint64_t value) noexcept->unsigned {
+	#if defined(_MSC_VER) && !defined(__clang__)
+	return static_cast<unsigned>(__popcnt64(value));
+	#else
+	return static_cast<unsigned>(__builtin_popcountll(value));
+	#endif
+}
+
+// undefined for 0
+[[nodiscard]] inline auto countr_zero(const std::uint64_t value) noexcept->unsigned {
+	#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long idx;
+	_BitScanForward64(&idx, value);
+	return static_cast<unsigned>(idx);
+	#else
+	return static_cast<unsigned>(__builtin_ctzll(value));
+	#endif
+}
+
+// undefined for 0
+[[nodiscard]] inline auto countl_zero(const std::uint64_t value) noexcept->unsigned {
+	#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long idx;
+	_BitScanReverse64(&idx, value);
+	return static_cast<unsigned>(63 - idx);
+	#else
+	return static_cast<unsigned>(__builtin_clzll(value));
+	#endif
+}
+
+// number of bits needed to represent value, 0 for 0
+[[nodiscard]] inline auto bit_width(const std::uint64_t value) noexcept->unsigned {
+	return value ? 64 - countl_zero(value) : 0;
+}
+
+}
+}
+
+#endif
\ No newline at end of file
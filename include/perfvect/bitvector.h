@@ -0,0 +1,348 @@
+#ifndef PERFVECT_BITVECTOR_H
+#define PERFVECT_BITVECTOR_H
+
+#include "bit.h"
+#include "small_vector.h"
+#include "static_vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace perfvect {
+
+// packed bit sequence stored in 64-bit words held by Words (a static_vector or small_vector of words)
+// bits past size() in the last word are always kept zero so word-at-a-time queries need no masking
+template<typename Words>
+class basic_bitvector {
+	template<typename OtherWords>
+	friend class basic_bitvector;
+
+public:
+	using word_type = std::uint64_t;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	static constexpr size_type word_bits = 64;
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+	class reference {
+		friend class basic_bitvector;
+
+	public:
+		constexpr auto& operator=(const bool value) noexcept {
+			if (value) *m_word |= m_mask;
+			else *m_word &= ~m_mask;
+			return *this;
+		}
+
+		constexpr auto& operator=(const reference& other) noexcept {
+			return *this = static_cast<bool>(other);
+		}
+
+		[[nodiscard]] constexpr operator bool() const noexcept {
+			return (*m_word & m_mask) != 0;
+		}
+
+		[[nodiscard]] constexpr auto operator~() const noexcept->bool {
+			return !static_cast<bool>(*this);
+		}
+
+		constexpr auto& flip() noexcept {
+			*m_word ^= m_mask;
+			return *this;
+		}
+
+	private:
+		constexpr reference(word_type* word, const size_type bit) noexcept
+			: m_word(word), m_mask(word_type{1} << bit) {}
+
+	private:
+		word_type* m_word;
+		word_type m_mask;
+	};
+
+public:
+	// constructors
+
+	basic_bitvector() = default;
+
+	explicit basic_bitvector(const size_type count, const bool value = false) {
+		resize(count, value);
+	}
+
+	basic_bitvector(std::initializer_list<bool> init) {
+		for (const auto value : init) push_back(value);
+	}
+
+	// element access
+
+	[[nodiscard]] constexpr auto test(const size_type pos) const->bool {
+		if (m_size <= pos) {
+			throw std::out_of_range("invalid basic_bitvector subscript");
+		}
+		return get(pos);
+	}
+
+	[[nodiscard]] constexpr auto operator[](const size_type pos) const noexcept->bool {
+		check_range_error(pos);
+		return get(pos);
+	}
+
+	[[nodiscard]] constexpr auto operator[](const size_type pos) noexcept->reference {
+		check_range_error(pos);
+		return reference(word_data() + pos / word_bits, pos % word_bits);
+	}
+
+	[[nodiscard]] constexpr auto front() const noexcept->bool {
+		return get(0);
+	}
+
+	[[nodiscard]] constexpr auto back() const noexcept->bool {
+		return get(m_size - 1);
+	}
+
+	[[nodiscard]] constexpr auto word_data() noexcept->word_type* {
+		return m_words.data();
+	}
+
+	[[nodiscard]] constexpr auto word_data() const noexcept->const word_type* {
+		return m_words.data();
+	}
+
+	// capacity
+
+	[[nodiscard]] constexpr auto size() const noexcept->size_type {
+		return m_size;
+	}
+
+	[[nodiscard]] constexpr auto empty() const noexcept->bool {
+		return m_size == 0;
+	}
+
+	[[nodiscard]] constexpr auto capacity() const noexcept->size_type {
+		return m_words.capacity() * word_bits;
+	}
+
+	[[nodiscard]] constexpr auto num_words() const noexcept->size_type {
+		return m_words.size();
+	}
+
+	auto reserve(const size_type bits) {
+		m_words.reserve(words_for(bits));
+	}
+
+	// modifiers
+
+	auto set(const size_type pos, const bool value = true)->basic_bitvector& {
+		(*this)[pos] = value;
+		return *this;
+	}
+
+	auto set() noexcept->basic_bitvector& {
+		std::fill_n(word_data(), num_words(), ~word_type{0});
+		clear_unused_bits();
+		return *this;
+	}
+
+	auto reset(const size_type pos)->basic_bitvector& {
+		return set(pos, false);
+	}
+
+	auto reset() noexcept->basic_bitvector& {
+		std::fill_n(word_data(), num_words(), word_type{0});
+		return *this;
+	}
+
+	auto flip(const size_type pos)->basic_bitvector& {
+		(*this)[pos].flip();
+		return *this;
+	}
+
+	auto flip() noexcept->basic_bitvector& {
+		const auto words = word_data();
+		for (size_type i = 0; i < num_words(); ++i) words[i] = ~words[i];
+		clear_unused_bits();
+		return *this;
+	}
+
+	auto clear() {
+		m_words.clear();
+		m_size = 0;
+	}
+
+	auto push_back(const bool value) {
+		if (m_size % word_bits == 0) m_words.push_back(word_type{0});
+		if (value) m_words.back() |= word_type{1} << (m_size % word_bits);
+		++m_size;
+	}
+
+	auto pop_back() {
+		#if _DEBUG
+		if (empty())
+			throw std::out_of_range("basic_bitvector empty on pop_back");
+		#endif
+
+		resize(m_size - 1);
+	}
+
+	auto resize(const size_type count, const bool value = false) {
+		const auto old_size = m_size;
+		m_words.resize(words_for(count));
+		m_size = count;
+
+		if (count > old_size && value) {
+			const auto words = word_data();
+			auto first_word = old_size / word_bits;
+
+			if (old_size % word_bits) {
+				words[first_word++] |= ~word_type{0} << (old_size % word_bits);
+			}
+
+			std::fill(words + first_word, words + num_words(), ~word_type{0});
+		}
+
+		clear_unused_bits();
+	}
+
+	// word-at-a-time queries
+
+	[[nodiscard]] auto count() const noexcept->size_type {
+		size_type total = 0;
+		const auto words = word_data();
+		for (size_type i = 0; i < num_words(); ++i) total += detail::popcount(words[i]);
+		return total;
+	}
+
+	[[nodiscard]] auto any() const noexcept->bool {
+		const auto words = word_data();
+		return std::any_of(words, words + num_words(), [](const word_type word) { return word != 0; });
+	}
+
+	[[nodiscard]] auto none() const noexcept->bool {
+		return !any();
+	}
+
+	[[nodiscard]] auto all() const noexcept->bool {
+		return count() == m_size;
+	}
+
+	// index of the first set bit, or npos
+	[[nodiscard]] auto find_first() const noexcept->size_type {
+		return find_from_word(0, num_words() ? word_data()[0] : 0);
+	}
+
+	// index of the first set bit after pos, or npos
+	[[nodiscard]] auto find_next(const size_type pos) const noexcept->size_type {
+		const auto next = pos + 1;
+		if (next >= m_size) return npos;
+		const auto idx = next / word_bits;
+		return find_from_word(idx, word_data()[idx] & (~word_type{0} << (next % word_bits)));
+	}
+
+	// bulk bitwise operations
+	// bits past other.size() are treated as unset
+
+	template<typename OtherWords>
+	auto operator&=(const basic_bitvector<OtherWords>& other) noexcept->basic_bitvector& {
+		const auto words = word_data();
+		const auto other_words = other.word_data();
+		const auto common = std::min(num_words(), other.num_words());
+		for (size_type i = 0; i < common; ++i) words[i] &= other_words[i];
+		std::fill(words + common, words + num_words(), word_type{0});
+		return *this;
+	}
+
+	template<typename OtherWords>
+	auto operator|=(const basic_bitvector<OtherWords>& other) noexcept->basic_bitvector& {
+		const auto words = word_data();
+		const auto other_words = other.word_data();
+		const auto common = std::min(num_words(), other.num_words());
+		for (size_type i = 0; i < common; ++i) words[i] |= other_words[i];
+		clear_unused_bits();
+		return *this;
+	}
+
+	template<typename OtherWords>
+	auto operator^=(const basic_bitvector<OtherWords>& other) noexcept->basic_bitvector& {
+		const auto words = word_data();
+		const auto other_words = other.word_data();
+		const auto common = std::min(num_words(), other.num_words());
+		for (size_type i = 0; i < common; ++i) words[i] ^= other_words[i];
+		clear_unused_bits();
+		return *this;
+	}
+
+	// clears every bit that is set in other
+	template<typename OtherWords>
+	auto subtract(const basic_bitvector<OtherWords>& other) noexcept->basic_bitvector& {
+		const auto words = word_data();
+		const auto other_words = other.word_data();
+		const auto common = std::min(num_words(), other.num_words());
+		for (size_type i = 0; i < common; ++i) words[i] &= ~other_words[i];
+		return *this;
+	}
+
+	template<typename OtherWords>
+	[[nodiscard]] auto operator==(const basic_bitvector<OtherWords>& other) const noexcept->bool {
+		return m_size == other.m_size && std::equal(word_data(), word_data() + num_words(), other.word_data());
+	}
+
+	template<typename OtherWords>
+	[[nodiscard]] auto operator!=(const basic_bitvector<OtherWords>& other) const noexcept->bool {
+		return !(*this == other);
+	}
+
+	auto swap(basic_bitvector& other) {
+		m_words.swap(other.m_words);
+		std::swap(m_size, other.m_size);
+	}
+
+private:
+	[[nodiscard]] static constexpr auto words_for(const size_type bits) noexcept->size_type {
+		return (bits + word_bits - 1) / word_bits;
+	}
+
+	[[nodiscard]] constexpr auto get(const size_type pos) const noexcept->bool {
+		return (word_data()[pos / word_bits] >> (pos % word_bits)) & 1;
+	}
+
+	[[nodiscard]] auto find_from_word(size_type idx, word_type word) const noexcept->size_type {
+		const auto words = word_data();
+		while (!word) {
+			if (++idx >= num_words()) return npos;
+			word = words[idx];
+		}
+		return idx * word_bits + detail::countr_zero(word);
+	}
+
+	auto clear_unused_bits() noexcept {
+		if (m_size % word_bits) m_words.back() &= ~(~word_type{0} << (m_size % word_bits));
+	}
+
+	auto check_range_error(const size_type pos) const {
+		#if _DEBUG
+		if (pos >= m_size) {
+			throw std::out_of_range("basic_bitvector subscript out of range");
+		}
+		#endif
+		(void)pos;
+	}
+
+private:
+	Words m_words;
+	size_type m_size = 0;
+};
+
+// bit vector of at most Bits bits, free of allocations
+template<std::size_t Bits>
+using static_bitvector = basic_bitvector<static_vector<std::uint64_t, (Bits + 63) / 64>>;
+
+// bit vector storing up to StaticBits bits inline before moving to dynamic storage
+template<std::size_t StaticBits = 256>
+using small_bitvector = basic_bitvector<small_vector<std::uint64_t, (StaticBits + 63) / 64>>;
+
+}
+
+#endif
\ No newline at end of file
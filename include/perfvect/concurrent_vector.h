@@ -0,0 +1,436 @@
+#ifndef PERFVECT_CONCURRENT_VECTOR_H
+#define PERFVECT_CONCURRENT_VECTOR_H
+
+#include "bit.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace perfvect {
+
+// append-only vector supporting concurrent push_back/grow_by from many threads
+// elements live in segments of doubling size which are never moved, so references stay valid until destruction
+// an element is published once it and every element before it have been constructed; size(), operator[] and
+// snapshot() only ever observe published elements and are wait-free
+template<typename T, typename Allocator = std::pmr::polymorphic_allocator<T>>
+class concurrent_vector {
+	static constexpr std::size_t first_segment_bits = 5;
+	static constexpr std::size_t first_segment_size = std::size_t{1} << first_segment_bits;
+	static constexpr std::size_t max_segments = 64 - first_segment_bits;
+
+	// segments are allocated in blocks of T's alignment, holding the ready flags followed by the elements
+	struct alignas(T) block {
+		std::byte bytes[alignof(T)];
+	};
+
+	using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<block>;
+	using flag_type = std::atomic<bool>;
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+
+	class snapshot_view;
+
+	// random access iterator over a fixed range of published elements
+	class const_iterator {
+		friend class concurrent_vector;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+		constexpr const_iterator() noexcept = default;
+
+		[[nodiscard]] auto operator*() const noexcept->reference {
+			return (*m_vec)[m_idx];
+		}
+
+		[[nodiscard]] auto operator->() const noexcept->pointer {
+			return std::addressof(**this);
+		}
+
+		[[nodiscard]] auto operator[](const difference_type off) const noexcept->reference {
+			return *(*this + off);
+		}
+
+		constexpr auto& operator++() noexcept {
+			++m_idx;
+			return *this;
+		}
+
+		constexpr auto operator++(int) noexcept {
+			auto tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		constexpr auto& operator--() noexcept {
+			--m_idx;
+			return *this;
+		}
+
+		constexpr auto operator--(int) noexcept {
+			auto tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		constexpr auto& operator+=(const difference_type off) noexcept {
+			m_idx += off;
+			return *this;
+		}
+
+		constexpr auto& operator-=(const difference_type off) noexcept {
+			m_idx -= off;
+			return *this;
+		}
+
+		[[nodiscard]] constexpr auto operator+(const difference_type off) const noexcept {
+			auto tmp = *this;
+			return tmp += off;
+		}
+
+		[[nodiscard]] constexpr auto operator-(const difference_type off) const noexcept {
+			auto tmp = *this;
+			return tmp -= off;
+		}
+
+		[[nodiscard]] constexpr auto operator-(const const_iterator& other) const noexcept {
+			return static_cast<difference_type>(m_idx) - static_cast<difference_type>(other.m_idx);
+		}
+
+		[[nodiscard]] constexpr auto operator==(const const_iterator& other) const noexcept {
+			return m_idx == other.m_idx;
+		}
+
+		[[nodiscard]] constexpr auto operator!=(const const_iterator& other) const noexcept {
+			return !(*this == other);
+		}
+
+		[[nodiscard]] constexpr auto operator<(const const_iterator& other) const noexcept {
+			return m_idx < other.m_idx;
+		}
+
+		[[nodiscard]] constexpr auto operator>(const const_iterator& other) const noexcept {
+			return other < *this;
+		}
+
+		[[nodiscard]] constexpr auto operator<=(const const_iterator& other) const noexcept {
+			return !(other < *this);
+		}
+
+		[[nodiscard]] constexpr auto operator>=(const const_iterator& other) const noexcept {
+			return !(*this < other);
+		}
+
+	private:
+		constexpr const_iterator(const concurrent_vector* vec, const size_type idx) noexcept
+			: m_vec(vec), m_idx(idx) {}
+
+	private:
+		const concurrent_vector* m_vec = nullptr;
+		size_type m_idx = 0;
+	};
+
+	// view of the elements published at the time snapshot() was called, unaffected by later appends
+	class snapshot_view {
+		friend class concurrent_vector;
+
+	public:
+		[[nodiscard]] auto operator[](const size_type pos) const noexcept->const_reference {
+			return (*m_vec)[pos];
+		}
+
+		[[nodiscard]] constexpr auto size() const noexcept->size_type {
+			return m_size;
+		}
+
+		[[nodiscard]] constexpr auto empty() const noexcept->bool {
+			return m_size == 0;
+		}
+
+		[[nodiscard]] constexpr auto begin() const noexcept {
+			return const_iterator(m_vec, 0);
+		}
+
+		[[nodiscard]] constexpr auto end() const noexcept {
+			return const_iterator(m_vec, m_size);
+		}
+
+		// calls func(const T* data, size_type count) for each contiguous run of elements, in order
+		template<typename Func>
+		auto for_each_span(Func&& func) const {
+			size_type first = 0;
+			for (size_type seg = 0; first < m_size; ++seg) {
+				const auto count = std::min(segment_size(seg), m_size - first);
+				func(m_vec->segment_data(seg), count);
+				first += count;
+			}
+		}
+
+	private:
+		constexpr snapshot_view(const concurrent_vector* vec, const size_type size) noexcept
+			: m_vec(vec), m_size(size) {}
+
+	private:
+		const concurrent_vector* m_vec;
+		size_type m_size;
+	};
+
+public:
+	// constructors
+
+	concurrent_vector() noexcept = default;
+
+	explicit concurrent_vector(const Allocator& alloc) noexcept : m_alloc(alloc) {}
+
+	concurrent_vector(const concurrent_vector&) = delete;
+	concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+	~concurrent_vector() noexcept(std::is_nothrow_destructible_v<T>) {
+		clear();
+		for (size_type seg = 0; seg < max_segments; ++seg) {
+			if (const auto mem = m_segments[seg].load(std::memory_order_relaxed)) {
+				m_alloc.deallocate(mem, segment_blocks(seg));
+			}
+		}
+	}
+
+	// element access
+	// pos must refer to a published element
+
+	[[nodiscard]] auto operator[](const size_type pos) noexcept->reference {
+		check_range_error(pos);
+		const auto [seg, offset] = locate(pos);
+		return segment_data(seg)[offset];
+	}
+
+	[[nodiscard]] auto operator[](const size_type pos) const noexcept->const_reference {
+		check_range_error(pos);
+		const auto [seg, offset] = locate(pos);
+		return segment_data(seg)[offset];
+	}
+
+	[[nodiscard]] auto at(const size_type pos)->reference {
+		if (size() <= pos) {
+			throw std::out_of_range("invalid concurrent_vector<T> subscript");
+		}
+		return (*this)[pos];
+	}
+
+	[[nodiscard]] auto at(const size_type pos) const->const_reference {
+		if (size() <= pos) {
+			throw std::out_of_range("invalid concurrent_vector<T> subscript");
+		}
+		return (*this)[pos];
+	}
+
+	[[nodiscard]] auto snapshot() const noexcept->snapshot_view {
+		return snapshot_view(this, size());
+	}
+
+	[[nodiscard]] auto begin() const noexcept {
+		return const_iterator(this, 0);
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return const_iterator(this, size());
+	}
+
+	// capacity
+
+	// number of published elements
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_published.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return size() == 0;
+	}
+
+	// allocates every segment needed to hold new_cap elements, may be called concurrently with appends
+	auto reserve(const size_type new_cap) {
+		if (new_cap) acquire_segments(0, new_cap);
+	}
+
+	// modifiers
+	// if constructing an element throws, its slot is never published and size() stops advancing at it
+
+	template<typename... Args>
+	auto emplace_back(Args&&... args)->reference {
+		return *append(std::forward<Args>(args)...).second;
+	}
+
+	// returns the index the element was stored at
+	auto push_back(const value_type& val)->size_type {
+		return append(val).first;
+	}
+
+	// returns the index the element was stored at
+	auto push_back(value_type&& val)->size_type {
+		return append(std::move(val)).first;
+	}
+
+	// appends count copies of val as one contiguous range of indices and returns the index of the first
+	auto grow_by(const size_type count, const value_type& val = value_type())->size_type {
+		if (!count) return m_reserved.load(std::memory_order_relaxed);
+
+		const auto first = m_reserved.fetch_add(count, std::memory_order_relaxed);
+		acquire_segments(first, count);
+
+		// the range is published as a whole, so if a copy throws the ones already made are destroyed again
+		auto pos = first;
+		try {
+			for (; pos < first + count; ++pos) {
+				const auto [seg, offset] = locate(pos);
+				new (segment_data(seg) + offset) value_type(val);
+			}
+		}
+		catch (...) {
+			for (auto built = first; built < pos; ++built) {
+				const auto [seg, offset] = locate(built);
+				std::destroy_at(segment_data(seg) + offset);
+			}
+			throw;
+		}
+
+		publish(first, count);
+		return first;
+	}
+
+	// not thread-safe, destroys all elements but keeps the allocated segments
+	auto clear() noexcept(std::is_nothrow_destructible_v<T>) {
+		const auto count = m_reserved.load(std::memory_order_relaxed);
+		for (size_type pos = 0; pos < count; ++pos) {
+			const auto [seg, offset] = locate(pos);
+			if (ready_flags(seg)[offset].exchange(false, std::memory_order_relaxed)) {
+				std::destroy_at(segment_data(seg) + offset);
+			}
+		}
+		m_reserved.store(0, std::memory_order_relaxed);
+		m_published.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	struct location {
+		size_type segment;
+		size_type offset;
+	};
+
+	template<typename... Args>
+	auto append(Args&&... args)->std::pair<size_type, pointer> {
+		const auto pos = m_reserved.fetch_add(1, std::memory_order_relaxed);
+		const auto [seg, offset] = locate(pos);
+		const auto elem = new (acquire_segment(seg) + offset) value_type{std::forward<Args>(args)...};
+		publish(pos, 1);
+		return {pos, elem};
+	}
+
+	[[nodiscard]] static auto locate(const size_type pos) noexcept->location {
+		const auto biased = pos + first_segment_size;
+		const auto seg = detail::bit_width(biased) - 1 - first_segment_bits;
+		return {seg, biased - (first_segment_size << seg)};
+	}
+
+	[[nodiscard]] static constexpr auto segment_size(const size_type seg) noexcept->size_type {
+		return first_segment_size << seg;
+	}
+
+	[[nodiscard]] static constexpr auto flag_blocks(const size_type seg) noexcept->size_type {
+		return (segment_size(seg) * sizeof(flag_type) + sizeof(block) - 1) / sizeof(block);
+	}
+
+	[[nodiscard]] static constexpr auto segment_blocks(const size_type seg) noexcept->size_type {
+		return flag_blocks(seg) + (segment_size(seg) * sizeof(T) + sizeof(block) - 1) / sizeof(block);
+	}
+
+	[[nodiscard]] auto segment_data(const size_type seg) const noexcept->pointer {
+		const auto mem = m_segments[seg].load(std::memory_order_acquire);
+		return std::launder(reinterpret_cast<pointer>(mem + flag_blocks(seg)));
+	}
+
+	[[nodiscard]] auto ready_flags(const size_type seg) const noexcept->flag_type* {
+		return std::launder(reinterpret_cast<flag_type*>(m_segments[seg].load(std::memory_order_acquire)));
+	}
+
+	auto acquire_segment(const size_type seg)->pointer {
+		if (!m_segments[seg].load(std::memory_order_acquire)) {
+			const auto mem = m_alloc.allocate(segment_blocks(seg));
+			const auto flags = reinterpret_cast<flag_type*>(mem);
+			for (size_type i = 0; i < segment_size(seg); ++i) new (flags + i) flag_type(false);
+
+			block* expected = nullptr;
+			if (!m_segments[seg].compare_exchange_strong(expected, mem, std::memory_order_acq_rel)) {
+				m_alloc.deallocate(mem, segment_blocks(seg));
+			}
+		}
+		return segment_data(seg);
+	}
+
+	auto acquire_segments(const size_type first, const size_type count) {
+		const auto last_seg = locate(first + count - 1).segment;
+		for (auto seg = locate(first).segment; seg <= last_seg; ++seg) acquire_segment(seg);
+	}
+
+	// marks [first, first + count) as constructed then advances the published size over every ready element
+	// any thread may finish the advance on behalf of a slower one, so no producer waits on another
+	// the fence stops two producers finishing out of order from both missing each other's flags
+	auto publish(const size_type first, const size_type count) noexcept {
+		for (auto pos = first; pos < first + count; ++pos) {
+			const auto [seg, offset] = locate(pos);
+			ready_flags(seg)[offset].store(true, std::memory_order_release);
+		}
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		auto published = m_published.load(std::memory_order_acquire);
+		for (;;) {
+			const auto reserved = m_reserved.load(std::memory_order_acquire);
+			auto ready = published;
+			while (ready < reserved && is_ready(ready)) ++ready;
+			if (ready == published) break;
+			if (m_published.compare_exchange_weak(published, ready, std::memory_order_acq_rel)) published = ready;
+		}
+	}
+
+	[[nodiscard]] auto is_ready(const size_type pos) const noexcept->bool {
+		const auto [seg, offset] = locate(pos);
+		return m_segments[seg].load(std::memory_order_acquire) && ready_flags(seg)[offset].load(std::memory_order_acquire);
+	}
+
+	auto check_range_error(const size_type pos) const {
+		#if _DEBUG
+		if (pos >= size()) {
+			throw std::out_of_range("concurrent_vector subscript out of range");
+		}
+		#endif
+		(void)pos;
+	}
+
+private:
+	block_allocator m_alloc;
+	std::atomic<block*> m_segments[max_segments] = {};
+	alignas(64) std::atomic<size_type> m_reserved = 0;
+	alignas(64) std::atomic<size_type> m_published = 0;
+};
+
+}
+
+#endif
\ No newline at end of file
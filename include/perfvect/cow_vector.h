@@ -0,0 +1,491 @@
+#ifndef PERFVECT_COW_VECTOR_H
+#define PERFVECT_COW_VECTOR_H
+
+#include "iterator.h"
+#include "static_vector.h"
+#include "vector.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace perfvect {
+namespace detail {
+	// heap block shared between copies of a cow_vector, with the elements allocated directly after it
+	template<typename T>
+	class cow_block : public static_vector_base<T> {
+	public:
+		cow_block(T* storage, std::size_t capacity) noexcept : static_vector_base<T>(storage, capacity) {}
+
+		std::atomic<std::size_t> refs = 1;
+	};
+
+	template<typename T, std::size_t StaticCapacity>
+	struct cow_inline_storage {
+		[[nodiscard]] auto inline_base() noexcept->static_vector_base<T>* {
+			return &m_inline;
+		}
+
+		[[nodiscard]] auto inline_base() const noexcept->const static_vector_base<T>* {
+			return &m_inline;
+		}
+
+		static_vector<T, StaticCapacity> m_inline;
+	};
+
+	template<typename T>
+	struct cow_inline_storage<T, 0> {
+		[[nodiscard]] constexpr auto inline_base() const noexcept->static_vector_base<T>* {
+			return nullptr;
+		}
+	};
+}
+
+// vector whose copies share one reference counted heap buffer until either side is modified
+// any non-const access (including non-const begin(), data() and operator[]) first clones a shared buffer,
+// so prefer the const overloads or cbegin()/cend() for reads
+// with a StaticCapacity, up to that many elements are kept inline and copied by value instead
+template<typename T, std::size_t StaticCapacity = 0, typename Allocator = std::pmr::polymorphic_allocator<T>>
+class cow_vector : private detail::cow_inline_storage<T, StaticCapacity> {
+	using base_t = static_vector_base<T>;
+	using block_t = detail::cow_block<T>;
+	using inline_t = detail::cow_inline_storage<T, StaticCapacity>;
+
+	// blocks are allocated in units aligned for both the header and the elements
+	struct alignas(alignof(block_t) > alignof(T) ? alignof(block_t) : alignof(T)) unit {
+		std::byte bytes[alignof(block_t) > alignof(T) ? alignof(block_t) : alignof(T)];
+	};
+
+	using unit_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<unit>;
+	static constexpr std::size_t header_units = (sizeof(block_t) + sizeof(unit) - 1) / sizeof(unit);
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+	using iterator = detail::iterator<T>;
+	using const_iterator = detail::iterator<const T>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+public:
+	// constructors
+
+	cow_vector() noexcept = default;
+
+	explicit cow_vector(const Allocator& alloc) noexcept : m_alloc(alloc) {}
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	cow_vector(InputIt first, InputIt last) {
+		assign(first, last);
+	}
+
+	cow_vector(size_type count, const value_type& value) {
+		assign(count, value);
+	}
+
+	cow_vector(std::initializer_list<value_type> init) {
+		assign(init);
+	}
+
+	// O(1) when the elements are on the heap
+	cow_vector(const cow_vector& other) : m_alloc(other.m_alloc) {
+		share(other);
+	}
+
+	cow_vector(cow_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : m_alloc(other.m_alloc) {
+		take(other);
+	}
+
+	~cow_vector() noexcept(std::is_nothrow_destructible_v<T>) {
+		release();
+	}
+
+	// operations
+
+	auto& operator=(const cow_vector& other) {
+		if (this != std::addressof(other)) {
+			clear();
+			share(other);
+		}
+		return *this;
+	}
+
+	auto& operator=(cow_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if (this != std::addressof(other)) {
+			clear();
+			take(other);
+		}
+		return *this;
+	}
+
+	auto& operator=(std::initializer_list<value_type> ilist) {
+		assign(ilist);
+		return *this;
+	}
+
+	auto assign(size_type count, const value_type& value) {
+		detach_if_shared();
+		if (!count) return clear();
+		mutate(count).assign(count, value);
+	}
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	auto assign(InputIt first, InputIt last) {
+		const auto count = static_cast<size_type>(std::distance(first, last));
+		detach_if_shared();
+		if (!count) return clear();
+		mutate(count).assign(first, last);
+	}
+
+	auto assign(std::initializer_list<value_type> ilist) {
+		assign(ilist.begin(), ilist.end());
+	}
+
+	// element access
+
+	[[nodiscard]] auto at(size_type pos)->reference {
+		if (size() <= pos) {
+			throw std::out_of_range("invalid cow_vector<T> subscript");
+		}
+		return mutate()[pos];
+	}
+
+	[[nodiscard]] auto at(size_type pos) const->const_reference {
+		if (size() <= pos) {
+			throw std::out_of_range("invalid cow_vector<T> subscript");
+		}
+		return (*active())[pos];
+	}
+
+	[[nodiscard]] auto operator[](size_type pos)->reference {
+		return mutate()[pos];
+	}
+
+	[[nodiscard]] auto operator[](size_type pos) const noexcept->const_reference {
+		return (*active())[pos];
+	}
+
+	[[nodiscard]] auto front()->reference {
+		return mutate().front();
+	}
+
+	[[nodiscard]] auto front() const noexcept->const_reference {
+		return active()->front();
+	}
+
+	[[nodiscard]] auto back()->reference {
+		return mutate().back();
+	}
+
+	[[nodiscard]] auto back() const noexcept->const_reference {
+		return active()->back();
+	}
+
+	[[nodiscard]] auto data()->pointer {
+		return empty() ? nullptr : mutate().data();
+	}
+
+	[[nodiscard]] auto data() const noexcept->const_pointer {
+		const auto base = active();
+		return base ? base->data() : nullptr;
+	}
+
+	// iterators
+
+	[[nodiscard]] auto begin() {
+		return iterator(data());
+	}
+
+	[[nodiscard]] auto begin() const noexcept {
+		return const_iterator(data());
+	}
+
+	[[nodiscard]] auto end() {
+		return begin() + static_cast<difference_type>(size());
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return begin() + static_cast<difference_type>(size());
+	}
+
+	[[nodiscard]] auto rbegin() {
+		return reverse_iterator(end());
+	}
+
+	[[nodiscard]] auto rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+
+	[[nodiscard]] auto rend() {
+		return reverse_iterator(begin());
+	}
+
+	[[nodiscard]] auto rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+
+	[[nodiscard]] auto cbegin() const noexcept {
+		return begin();
+	}
+
+	[[nodiscard]] auto cend() const noexcept {
+		return end();
+	}
+
+	[[nodiscard]] auto crbegin() const noexcept {
+		return rbegin();
+	}
+
+	[[nodiscard]] auto crend() const noexcept {
+		return rend();
+	}
+
+	// capacity
+
+	[[nodiscard]] auto capacity() const noexcept->size_type {
+		const auto base = active();
+		return base ? base->capacity() : 0;
+	}
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		const auto base = active();
+		return base ? base->size() : 0;
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return size() == 0;
+	}
+
+	[[nodiscard]] auto is_static() const noexcept->bool {
+		return !m_block;
+	}
+
+	// whether the heap buffer is currently referenced by another cow_vector
+	[[nodiscard]] auto is_shared() const noexcept->bool {
+		return m_block && m_block->refs.load(std::memory_order_acquire) > 1;
+	}
+
+	auto reserve(size_type new_cap) {
+		mutate(new_cap);
+	}
+
+	// modifiers
+
+	// releases a shared buffer without cloning it
+	auto clear() {
+		if (m_block) release();
+		else if (const auto base = this->inline_base()) base->clear();
+	}
+
+	auto pop_back() {
+		mutate().pop_back();
+	}
+
+	auto erase(const_iterator pos)->iterator {
+		const auto offset = pos - cbegin();
+		auto& base = mutate();
+		return base.erase(base.cbegin() + offset);
+	}
+
+	auto erase(const_iterator first, const_iterator last)->const_iterator {
+		if (first == last) return last;
+		const auto offset = first - cbegin();
+		const auto count = last - first;
+		auto& base = mutate();
+		return base.erase(base.cbegin() + offset, base.cbegin() + offset + count);
+	}
+
+	template<typename... Args>
+	auto& emplace_back(Args&&... args) {
+		return mutate(size() + 1).emplace_back(std::forward<Args>(args)...);
+	}
+
+	auto push_back(const value_type& val) {
+		emplace_back(val);
+	}
+
+	auto push_back(value_type&& val) {
+		emplace_back(std::move(val));
+	}
+
+	template<typename... Args>
+	auto emplace(const_iterator pos, Args&&... args)->iterator {
+		const auto offset = pos - cbegin();
+		auto& base = mutate(size() + 1);
+		return base.emplace(base.cbegin() + offset, std::forward<Args>(args)...);
+	}
+
+	auto insert(const_iterator pos, const value_type& val)->iterator {
+		return emplace(pos, val);
+	}
+
+	auto insert(const_iterator pos, value_type&& val)->iterator {
+		return emplace(pos, std::move(val));
+	}
+
+	auto insert(const_iterator pos, const size_type count, const value_type& val)->iterator {
+		const auto offset = pos - cbegin();
+		auto& base = mutate(size() + count);
+		return base.insert(base.cbegin() + offset, count, val);
+	}
+
+	template<typename Iter, typename = std::enable_if_t<detail::is_iterator_v<Iter>>>
+	auto insert(const_iterator pos, Iter first, Iter last)->iterator {
+		const auto offset = pos - cbegin();
+		auto& base = mutate(size() + static_cast<size_type>(std::distance(first, last)));
+		return base.insert(base.cbegin() + offset, first, last);
+	}
+
+	auto insert(const_iterator pos, std::initializer_list<value_type> list)->iterator {
+		return insert(pos, list.begin(), list.end());
+	}
+
+	auto resize(size_type count) {
+		if (count < size() && is_shared()) {
+			// copy only the kept prefix, holding a reference so the source outlives the copy
+			const auto source = *this;
+			assign(source.cbegin(), source.cbegin() + static_cast<difference_type>(count));
+		}
+		else if (count != size()) {
+			mutate(count).resize(count);
+		}
+	}
+
+	auto resize(size_type count, const value_type& value) {
+		if (count <= size()) resize(count);
+		else insert(cend(), count - size(), value);
+	}
+
+	auto swap(cow_vector& other) {
+		auto tmp = std::move(other);
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+private:
+	[[nodiscard]] auto active() const noexcept->const base_t* {
+		if (m_block) return m_block;
+		return this->inline_base();
+	}
+
+	[[nodiscard]] auto active() noexcept->base_t* {
+		if (m_block) return m_block;
+		return this->inline_base();
+	}
+
+	// unique, writable storage able to hold at least required elements
+	auto mutate(const size_type required = 0)->base_t& {
+		const auto cap = capacity();
+		if (is_shared() || !active()) {
+			reallocate(std::max(required, size()));
+		}
+		else if (required > cap) {
+			reallocate(std::max({required, cap * 2, size_type{4}}));
+		}
+		return *active();
+	}
+
+	auto detach_if_shared() {
+		if (is_shared()) release();
+	}
+
+	// moves the elements into storage of at least new_cap, copying instead if the current buffer is shared
+	auto reallocate(const size_type new_cap) {
+		const auto src = active();
+		const auto shared = is_shared();
+
+		if constexpr (StaticCapacity > 0) {
+			if (new_cap <= StaticCapacity && m_block) {
+				const auto dest = this->inline_base();
+				if (shared) dest->insert(dest->cend(), src->cbegin(), src->cend());
+				else dest->insert(dest->cend(), std::make_move_iterator(src->begin()), std::make_move_iterator(src->end()));
+				release();
+				return;
+			}
+		}
+
+		const auto block = allocate_block(std::max(new_cap, StaticCapacity + 1));
+		try {
+			if (src) {
+				if (shared) block->insert(block->cend(), src->cbegin(), src->cend());
+				else block->insert(block->cend(), std::make_move_iterator(src->begin()), std::make_move_iterator(src->end()));
+			}
+		}
+		catch (...) {
+			free_block(block);
+			throw;
+		}
+
+		if (m_block) release();
+		else if (src) src->clear();
+		m_block = block;
+	}
+
+	auto share(const cow_vector& other) {
+		if (other.m_block) {
+			m_block = other.m_block;
+			m_block->refs.fetch_add(1, std::memory_order_relaxed);
+		}
+		else if (const auto src = other.active()) {
+			this->inline_base()->insert(this->inline_base()->cend(), src->cbegin(), src->cend());
+		}
+	}
+
+	auto take(cow_vector& other) {
+		if (other.m_block) {
+			m_block = std::exchange(other.m_block, nullptr);
+		}
+		else if (const auto src = other.active()) {
+			const auto dest = this->inline_base();
+			dest->insert(dest->cend(), std::make_move_iterator(src->begin()), std::make_move_iterator(src->end()));
+			src->clear();
+		}
+	}
+
+	auto release() noexcept {
+		if (m_block && m_block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			free_block(m_block);
+		}
+		m_block = nullptr;
+	}
+
+	[[nodiscard]] static constexpr auto block_units(const size_type cap) noexcept->size_type {
+		return header_units + (cap * sizeof(T) + sizeof(unit) - 1) / sizeof(unit);
+	}
+
+	[[nodiscard]] auto allocate_block(const size_type cap)->block_t* {
+		const auto mem = m_alloc.allocate(block_units(cap));
+		const auto storage = reinterpret_cast<pointer>(mem + header_units);
+		return new (mem) block_t(storage, cap);
+	}
+
+	auto free_block(block_t* block) noexcept {
+		const auto units = block_units(block->capacity());
+		block->~block_t();
+		m_alloc.deallocate(reinterpret_cast<unit*>(block), units);
+	}
+
+private:
+	block_t* m_block = nullptr;
+	unit_allocator m_alloc;
+};
+
+// cow_vector keeping up to StaticCapacity elements inline
+template<typename T, std::size_t StaticCapacity = 16, typename Allocator = std::pmr::polymorphic_allocator<T>>
+using small_cow_vector = cow_vector<T, StaticCapacity, Allocator>;
+
+}
+
+#endif
\ No newline at end of file
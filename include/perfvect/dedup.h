@@ -0,0 +1,124 @@
+#ifndef PERFVECT_DEDUP_H
+#define PERFVECT_DEDUP_H
+
+#include "hash.h"
+#include "sort.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace perfvect {
+namespace detail {
+
+// deduplication kernels behind static_vector_base::dedup() and dedup_unordered(): both compact the kept elements
+// towards the front in a single pass, moving each one at most once, and return how many were kept for the caller to
+// destroy the rest; a leading run with nothing removed is not rewritten
+
+// keeps the first of each run of elements with equal proj(element); trivially copyable elements are copied
+// unconditionally and the write position advanced by the comparison, which leaves the loop free of branches
+template<typename T, typename Proj>
+auto dedup_adjacent(T* data, const std::size_t count, Proj& proj)->std::size_t {
+	const auto same = [&proj](const T& lhs, const T& rhs) {
+		return std::invoke(proj, lhs) == std::invoke(proj, rhs);
+	};
+
+	std::size_t read = 1;
+	while (read < count && !same(data[read], data[read - 1])) ++read;
+	if (read >= count) return count;
+
+	auto write = read;
+	if constexpr (std::is_trivially_copyable_v<T>) {
+		// equal keys are transitive, so comparing each element with the one before it in the input finds the same runs
+		// as comparing it with the last kept, and keeps the store of one iteration out of the loads of the next
+		auto prev = data[read];
+		for (++read; read < count; ++read) {
+			const auto value = data[read];
+			const auto keep = !same(value, prev);
+			data[write] = value;
+			write += keep;
+			prev = value;
+		}
+	}
+	else {
+		for (++read; read < count; ++read) {
+			if (!same(data[read], data[write - 1])) data[write++] = std::move(data[read]);
+		}
+	}
+	return write;
+}
+
+// number of slots in the hash table of dedup_unordered() kept on the stack, enough for 128 elements
+inline constexpr std::size_t dedup_stack_slots = 256;
+
+// hash of a key, mixed so that the top bits used to pick a slot depend on every bit of std::hash, which for integers
+// is usually the identity
+template<typename Key>
+[[nodiscard]] inline auto dedup_hash(const Key& key) noexcept(noexcept(std::hash<Key>()(key)))->std::uint64_t {
+	return static_cast<std::uint64_t>(std::hash<Key>()(key)) * hash_prime1;
+}
+
+// keeps the first element with each value of proj(element), wherever it is; an open addressing table with linear
+// probing and at least two slots per element holds one more than the position each kept element was moved to, so
+// that 0 marks an empty slot and the keys are never stored twice
+template<typename Slot, typename T, typename Proj>
+auto dedup_hashed(T* data, const std::size_t count, Proj& proj, Slot* slots, const std::size_t slot_bits)->std::size_t {
+	const auto mask = (std::size_t{1} << slot_bits) - 1;
+	std::fill_n(slots, mask + 1, Slot{0});
+
+	std::size_t write = 0;
+	for (std::size_t read = 0; read < count; ++read) {
+		decltype(auto) key = std::invoke(proj, std::as_const(data[read]));
+		auto slot = static_cast<std::size_t>(dedup_hash(key) >> (64 - slot_bits));
+		auto found = false;
+		for (; slots[slot]; slot = (slot + 1) & mask) {
+			if (std::invoke(proj, std::as_const(data[slots[slot] - 1])) == key) {
+				found = true;
+				break;
+			}
+		}
+		if (found) continue;
+
+		if (write != read) data[write] = std::move(data[read]);
+		slots[slot] = static_cast<Slot>(++write);
+	}
+	return write;
+}
+
+// dedup_hashed with its table on the stack for small counts, otherwise in a scratch buffer from alloc, with slots
+// as narrow as the count allows
+template<typename T, typename Proj, typename Alloc>
+auto dedup_unordered(T* data, const std::size_t count, Proj& proj, const Alloc& alloc)->std::size_t {
+	if (count < 2) return count;
+
+	std::size_t slot_bits = 1;
+	while ((std::size_t{1} << slot_bits) < count * 2) ++slot_bits;
+	const auto slot_count = std::size_t{1} << slot_bits;
+
+	if (slot_count <= dedup_stack_slots) {
+		std::uint32_t slots[dedup_stack_slots];
+		return dedup_hashed(data, count, proj, slots, slot_bits);
+	}
+	if (count < std::numeric_limits<std::uint32_t>::max()) {
+		const scratch_buffer<std::uint32_t, Alloc> slots(alloc, slot_count);
+		return dedup_hashed(data, count, proj, slots.data(), slot_bits);
+	}
+	const scratch_buffer<std::size_t, Alloc> slots(alloc, slot_count);
+	return dedup_hashed(data, count, proj, slots.data(), slot_bits);
+}
+
+// projection of dedup() and dedup_unordered(), comparing the elements themselves
+struct identity_projection {
+	template<typename T>
+	[[nodiscard]] constexpr auto operator()(const T& value) const noexcept->const T& {
+		return value;
+	}
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef PERFVECT_HASH_H
+#define PERFVECT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace perfvect {
+namespace detail {
+
+// hashing of contiguous element ranges, in the style of xxHash64: bulk input is consumed 32 bytes at a time by four
+// independent lanes, so the multiplies of one block overlap rather than forming a single dependency chain
+
+inline constexpr std::uint64_t hash_prime1 = 0x9E3779B185EBCA87ull;
+inline constexpr std::uint64_t hash_prime2 = 0xC2B2AE3D27D4EB4Full;
+inline constexpr std::uint64_t hash_prime3 = 0x165667B19E3779F9ull;
+inline constexpr std::uint64_t hash_prime4 = 0x85EBCA77C2B2AE63ull;
+inline constexpr std::uint64_t hash_prime5 = 0x27D4EB2F165667C5ull;
+
+[[nodiscard]] constexpr auto rotl(const std::uint64_t value, const int shift) noexcept->std::uint64_t {
+	return (value << shift) | (value >> (64 - shift));
+}
+
+[[nodiscard]] inline auto load_u64(const unsigned char* ptr) noexcept->std::uint64_t {
+	std::uint64_t value;
+	std::memcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+[[nodiscard]] constexpr auto hash_round(const std::uint64_t acc, const std::uint64_t input) noexcept->std::uint64_t {
+	return rotl(acc + input * hash_prime2, 31) * hash_prime1;
+}
+
+[[nodiscard]] constexpr auto hash_merge(const std::uint64_t acc, const std::uint64_t lane) noexcept->std::uint64_t {
+	return (acc ^ hash_round(0, lane)) * hash_prime1 + hash_prime4;
+}
+
+[[nodiscard]] constexpr auto hash_avalanche(std::uint64_t hash) noexcept->std::uint64_t {
+	hash ^= hash >> 33;
+	hash *= hash_prime2;
+	hash ^= hash >> 29;
+	hash *= hash_prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+[[nodiscard]] inline auto hash_bytes(const void* data, const std::size_t size, const std::uint64_t seed = 0) noexcept->std::uint64_t {
+	auto ptr = static_cast<const unsigned char*>(data);
+	const auto end = ptr + size;
+	std::uint64_t hash;
+
+	if (size >= 32) {
+		std::uint64_t lanes[4] = {seed + hash_prime1 + hash_prime2, seed + hash_prime2, seed, seed - hash_prime1};
+		for (; end - ptr >= 32; ptr += 32) {
+			for (auto lane = 0; lane < 4; ++lane) lanes[lane] = hash_round(lanes[lane], load_u64(ptr + lane * 8));
+		}
+		hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+		for (const auto lane : lanes) hash = hash_merge(hash, lane);
+	}
+	else {
+		hash = seed + hash_prime5;
+	}
+
+	hash += static_cast<std::uint64_t>(size);
+	for (; end - ptr >= 8; ptr += 8) hash = rotl(hash ^ hash_round(0, load_u64(ptr)), 27) * hash_prime1 + hash_prime4;
+	if (end - ptr >= 4) {
+		std::uint32_t word;
+		std::memcpy(&word, ptr, sizeof(word));
+		hash = rotl(hash ^ (word * hash_prime1), 23) * hash_prime2 + hash_prime3;
+		ptr += 4;
+	}
+	for (; ptr != end; ++ptr) hash = rotl(hash ^ (*ptr * hash_prime5), 11) * hash_prime1;
+	return hash_avalanche(hash);
+}
+
+// slot of the open-addressing indexes of small_map and intern_pool
+struct map_slot {
+	// position of the entry plus one, 0 for an empty slot
+	std::uint32_t entry;
+	// high bits of the key's hash, compared before the key itself
+	std::uint32_t fragment;
+};
+
+// types whose equal values always have equal bytes, so ranges of them can be hashed and compared bytewise
+template<typename T>
+inline constexpr bool is_bytewise_hashable_v = std::has_unique_object_representations_v<T>;
+
+// hash of count contiguous elements combining std::hash of each element, so elements equal under their own == hash
+// equally whatever their bytes
+template<typename T>
+[[nodiscard]] auto hash_elements(const T* data, const std::size_t count) noexcept->std::uint64_t {
+	auto hash = hash_prime5 + static_cast<std::uint64_t>(count);
+	for (std::size_t idx = 0; idx < count; ++idx) {
+		hash = rotl(hash ^ hash_round(0, static_cast<std::uint64_t>(std::hash<T>()(data[idx]))), 27) * hash_prime1 + hash_prime4;
+	}
+	return hash_avalanche(hash);
+}
+
+// hash of count contiguous elements, bytewise where possible, otherwise by combining std::hash of each element
+template<typename T>
+[[nodiscard]] auto hash_range(const T* data, const std::size_t count) noexcept->std::uint64_t {
+	if constexpr (is_bytewise_hashable_v<T>) return hash_bytes(data, count * sizeof(T));
+	else return hash_elements(data, count);
+}
+
+}
+}
+
+#endif
\ No newline at end of file
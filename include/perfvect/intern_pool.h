@@ -0,0 +1,399 @@
+#ifndef PERFVECT_INTERN_POOL_H
+#define PERFVECT_INTERN_POOL_H
+
+#include "hash.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <type_traits>
+
+namespace perfvect {
+
+// compact reference to a vector interned in an intern_pool or concurrent_intern_pool: two handles from the same pool
+// are equal exactly when the vectors they refer to are equal
+struct intern_handle {
+	std::uint32_t id = std::numeric_limits<std::uint32_t>::max();
+
+	[[nodiscard]] constexpr auto valid() const noexcept->bool {
+		return id != std::numeric_limits<std::uint32_t>::max();
+	}
+
+	[[nodiscard]] constexpr auto operator==(const intern_handle& other) const noexcept {
+		return id == other.id;
+	}
+
+	[[nodiscard]] constexpr auto operator!=(const intern_handle& other) const noexcept {
+		return id != other.id;
+	}
+
+	[[nodiscard]] constexpr auto operator<(const intern_handle& other) const noexcept {
+		return id < other.id;
+	}
+};
+
+// read-only view of an interned vector's elements, valid until the pool is cleared or destroyed
+template<typename T>
+class intern_view {
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using const_iterator = const T*;
+	using iterator = const_iterator;
+
+	constexpr intern_view() noexcept = default;
+	constexpr intern_view(const T* data, const size_type size) noexcept : m_data(data), m_size(size) {}
+
+	[[nodiscard]] constexpr auto operator[](const size_type pos) const noexcept->const T& {
+		return m_data[pos];
+	}
+
+	[[nodiscard]] constexpr auto data() const noexcept->const T* {
+		return m_data;
+	}
+
+	[[nodiscard]] constexpr auto size() const noexcept->size_type {
+		return m_size;
+	}
+
+	[[nodiscard]] constexpr auto empty() const noexcept->bool {
+		return !m_size;
+	}
+
+	[[nodiscard]] constexpr auto begin() const noexcept->const_iterator {
+		return m_data;
+	}
+
+	[[nodiscard]] constexpr auto end() const noexcept->const_iterator {
+		return m_data + m_size;
+	}
+
+private:
+	const T* m_data = nullptr;
+	size_type m_size = 0;
+};
+
+template<typename Vector, std::size_t ShardBits>
+class concurrent_intern_pool;
+
+// hash-consing pool for immutable vectors (typically small_vector<T, N>): each distinct sequence of elements is
+// copied once into a monotonic arena and identified by a 32-bit handle, so that equality is a handle comparison
+// interning hashes the elements (bytewise for types with unique object representations) and looks the hash up in an
+// open-addressing index; views into the arena are never invalidated by further interning
+template<typename Vector>
+class intern_pool {
+	template<typename, std::size_t>
+	friend class concurrent_intern_pool;
+
+	using element_t = typename Vector::value_type;
+
+	static_assert(std::is_trivially_copyable_v<element_t>, "intern_pool elements must be trivially copyable");
+
+	static constexpr std::size_t min_index_size = 16;
+
+	struct entry {
+		const element_t* data;
+		std::uint32_t size;
+		std::uint64_t hash;
+	};
+
+public:
+	using value_type = Vector;
+	using element_type = element_t;
+	using size_type = std::size_t;
+	using handle_type = intern_handle;
+	using view_type = intern_view<element_type>;
+
+public:
+	// constructors
+
+	intern_pool() = default;
+
+	// views refer into the pool's arena, so it can be neither copied nor moved
+	intern_pool(const intern_pool&) = delete;
+	auto operator=(const intern_pool&)->intern_pool& = delete;
+
+	// element access
+
+	[[nodiscard]] auto operator[](const handle_type handle) const noexcept->view_type {
+		const auto& e = m_entries[handle.id];
+		return view_type(e.data, e.size);
+	}
+
+	[[nodiscard]] auto at(const handle_type handle) const->view_type {
+		if (handle.id >= m_entries.size()) throw std::out_of_range("invalid intern_pool handle");
+		return (*this)[handle];
+	}
+
+	// copies the interned elements back out into a new Vector
+	[[nodiscard]] auto value(const handle_type handle) const->value_type {
+		const auto view = (*this)[handle];
+		return value_type(view.begin(), view.end());
+	}
+
+	// capacity
+
+	// number of distinct vectors interned
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_entries.size();
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_entries.empty();
+	}
+
+	// total number of elements held in the arena
+	[[nodiscard]] auto element_count() const noexcept->size_type {
+		return m_element_count;
+	}
+
+	auto reserve(const size_type count) {
+		m_entries.reserve(count);
+		if (index_size_for(count) > m_index.size()) rebuild_index(index_size_for(count));
+	}
+
+	// lookup
+
+	// handle of an already interned sequence, or an invalid handle
+	[[nodiscard]] auto find(const element_type* data, const size_type count) const->handle_type {
+		return handle_type{find_hashed(detail::hash_range(data, count), data, count)};
+	}
+
+	[[nodiscard]] auto find(const value_type& vec) const->handle_type {
+		return find(vec.data(), vec.size());
+	}
+
+	// modifiers
+
+	auto intern(const element_type* data, const size_type count)->handle_type {
+		return handle_type{intern_hashed(detail::hash_range(data, count), data, count)};
+	}
+
+	auto intern(const value_type& vec)->handle_type {
+		return intern(vec.data(), vec.size());
+	}
+
+	// releases the arena, invalidating every handle and view
+	auto clear() {
+		m_entries.clear();
+		m_index.clear();
+		m_arena.release();
+		m_element_count = 0;
+	}
+
+private:
+	static constexpr auto npos = std::numeric_limits<std::uint32_t>::max();
+
+	[[nodiscard]] static auto fragment_of(const std::uint64_t hash) noexcept {
+		return static_cast<std::uint32_t>(hash >> 32);
+	}
+
+	[[nodiscard]] static auto index_size_for(const size_type count) noexcept {
+		auto slots = min_index_size;
+		while (slots < count * 2) slots *= 2;
+		return slots;
+	}
+
+	[[nodiscard]] static auto equal_elements(const entry& e, const element_type* data, const size_type count) noexcept {
+		if (e.size != count) return false;
+		if constexpr (detail::is_bytewise_hashable_v<element_type>) {
+			return !count || std::memcmp(e.data, data, count * sizeof(element_type)) == 0;
+		}
+		else {
+			return std::equal(e.data, e.data + count, data);
+		}
+	}
+
+	[[nodiscard]] auto find_hashed(const std::uint64_t hash, const element_type* data, const size_type count) const noexcept->std::uint32_t {
+		if (m_index.empty()) return npos;
+		const auto mask = m_index.size() - 1;
+		const auto fragment = fragment_of(hash);
+		for (auto slot = static_cast<size_type>(hash) & mask;; slot = (slot + 1) & mask) {
+			const auto& s = m_index[slot];
+			if (!s.entry) return npos;
+			if (s.fragment == fragment && equal_elements(m_entries[s.entry - 1], data, count)) return s.entry - 1;
+		}
+	}
+
+	auto intern_hashed(const std::uint64_t hash, const element_type* data, const size_type count)->std::uint32_t {
+		const auto found = find_hashed(hash, data, count);
+		if (found != npos) return found;
+		if (m_entries.size() >= npos) throw std::length_error("intern_pool too long");
+		if (count > std::numeric_limits<std::uint32_t>::max()) throw std::length_error("intern_pool vector too long");
+
+		element_type* copy = nullptr;
+		if (count) {
+			copy = static_cast<element_type*>(m_arena.allocate(count * sizeof(element_type), alignof(element_type)));
+			std::memcpy(static_cast<void*>(copy), data, count * sizeof(element_type));
+		}
+
+		const auto id = static_cast<std::uint32_t>(m_entries.size());
+		m_entries.push_back(entry{copy, static_cast<std::uint32_t>(count), hash});
+		m_element_count += count;
+
+		if (m_entries.size() * 2 > m_index.size()) rebuild_index(index_size_for(m_entries.size()));
+		else insert_slot(hash, id);
+		return id;
+	}
+
+	auto insert_slot(const std::uint64_t hash, const std::uint32_t id) noexcept {
+		const auto mask = m_index.size() - 1;
+		auto slot = static_cast<size_type>(hash) & mask;
+		while (m_index[slot].entry) slot = (slot + 1) & mask;
+		m_index[slot] = detail::map_slot{id + 1, fragment_of(hash)};
+	}
+
+	auto rebuild_index(const size_type slots) {
+		m_index.clear();
+		m_index.resize(slots);
+		for (size_type id = 0; id < m_entries.size(); ++id) insert_slot(m_entries[id].hash, static_cast<std::uint32_t>(id));
+	}
+
+private:
+	std::pmr::monotonic_buffer_resource m_arena;
+	vector<entry> m_entries;
+	vector<detail::map_slot> m_index;
+	size_type m_element_count = 0;
+};
+
+// thread-safe intern_pool split into 2^ShardBits independently locked shards, chosen by the top bits of each
+// vector's hash; a handle keeps the shard in its low bits, so equality is still a single comparison
+// lookups take a shared lock on one shard and interning a new vector an exclusive one, and views stay valid while
+// other threads intern
+template<typename Vector, std::size_t ShardBits = 4>
+class concurrent_intern_pool {
+	static_assert(ShardBits >= 1 && ShardBits <= 8, "concurrent_intern_pool needs between 1 and 8 shard bits");
+
+	using pool_t = intern_pool<Vector>;
+
+	static constexpr std::size_t shard_count = std::size_t{1} << ShardBits;
+	static constexpr std::uint32_t max_shard_size = std::numeric_limits<std::uint32_t>::max() >> ShardBits;
+
+	// padded to a cache line so that shard locks do not share one
+	struct alignas(64) shard {
+		mutable std::shared_mutex mutex;
+		pool_t pool;
+	};
+
+public:
+	using value_type = Vector;
+	using element_type = typename pool_t::element_type;
+	using size_type = std::size_t;
+	using handle_type = intern_handle;
+	using view_type = intern_view<element_type>;
+
+public:
+	// constructors
+
+	concurrent_intern_pool() = default;
+	concurrent_intern_pool(const concurrent_intern_pool&) = delete;
+	auto operator=(const concurrent_intern_pool&)->concurrent_intern_pool& = delete;
+
+	// element access
+
+	[[nodiscard]] auto operator[](const handle_type handle) const->view_type {
+		const auto& s = m_shards[handle.id & (shard_count - 1)];
+		std::shared_lock lock(s.mutex);
+		return s.pool[handle_type{handle.id >> ShardBits}];
+	}
+
+	[[nodiscard]] auto value(const handle_type handle) const->value_type {
+		const auto view = (*this)[handle];
+		return value_type(view.begin(), view.end());
+	}
+
+	// capacity
+
+	// number of distinct vectors interned, which may be stale by the time it returns if other threads are interning
+	[[nodiscard]] auto size() const->size_type {
+		size_type count = 0;
+		for (const auto& s : m_shards) {
+			std::shared_lock lock(s.mutex);
+			count += s.pool.size();
+		}
+		return count;
+	}
+
+	[[nodiscard]] auto element_count() const->size_type {
+		size_type count = 0;
+		for (const auto& s : m_shards) {
+			std::shared_lock lock(s.mutex);
+			count += s.pool.element_count();
+		}
+		return count;
+	}
+
+	// lookup
+
+	[[nodiscard]] auto find(const element_type* data, const size_type count) const->handle_type {
+		const auto hash = detail::hash_range(data, count);
+		const auto shard_idx = shard_of(hash);
+		const auto& s = m_shards[shard_idx];
+		std::shared_lock lock(s.mutex);
+		return make_handle(shard_idx, s.pool.find_hashed(hash, data, count));
+	}
+
+	[[nodiscard]] auto find(const value_type& vec) const->handle_type {
+		return find(vec.data(), vec.size());
+	}
+
+	// modifiers
+
+	// looks the vector up under a shared lock first, so interning an already present vector does not serialise
+	auto intern(const element_type* data, const size_type count)->handle_type {
+		const auto hash = detail::hash_range(data, count);
+		const auto shard_idx = shard_of(hash);
+		auto& s = m_shards[shard_idx];
+		{
+			std::shared_lock lock(s.mutex);
+			const auto found = s.pool.find_hashed(hash, data, count);
+			if (found != pool_t::npos) return make_handle(shard_idx, found);
+		}
+
+		std::unique_lock lock(s.mutex);
+		const auto found = s.pool.find_hashed(hash, data, count);
+		if (found != pool_t::npos) return make_handle(shard_idx, found);
+		if (s.pool.size() >= max_shard_size) throw std::length_error("concurrent_intern_pool shard too long");
+		return make_handle(shard_idx, s.pool.intern_hashed(hash, data, count));
+	}
+
+	auto intern(const value_type& vec)->handle_type {
+		return intern(vec.data(), vec.size());
+	}
+
+	// not thread-safe: no other thread may use the pool during clear
+	auto clear() {
+		for (auto& s : m_shards) s.pool.clear();
+	}
+
+private:
+	[[nodiscard]] static auto shard_of(const std::uint64_t hash) noexcept->std::size_t {
+		return static_cast<std::size_t>(hash >> (64 - ShardBits));
+	}
+
+	[[nodiscard]] static auto make_handle(const std::size_t shard_idx, const std::uint32_t local) noexcept->handle_type {
+		if (local == pool_t::npos) return handle_type{};
+		return handle_type{(local << ShardBits) | static_cast<std::uint32_t>(shard_idx)};
+	}
+
+private:
+	shard m_shards[shard_count];
+};
+
+}
+
+template<>
+struct std::hash<perfvect::intern_handle> {
+	[[nodiscard]] auto operator()(const perfvect::intern_handle handle) const noexcept->std::size_t {
+		return static_cast<std::size_t>(perfvect::detail::hash_avalanche(handle.id));
+	}
+};
+
+#endif
\ No newline at end of file
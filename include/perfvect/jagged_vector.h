@@ -0,0 +1,450 @@
+#ifndef PERFVECT_JAGGED_VECTOR_H
+#define PERFVECT_JAGGED_VECTOR_H
+
+#include "iterator.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace perfvect {
+
+// sequence of variable-length rows stored in compressed sparse row form: the values of every row live in one array,
+// with each row described by the offset of its first value and the end of its live values
+// a row owns the values from its offset up to the next row's offset; values past its end are slack left behind by
+// in-place removals, which a row may grow back into and which compact() squeezes out
+// row references (and iterators into rows) are invalidated by any operation that adds values
+template<typename T>
+class jagged_vector {
+	using values_t = vector<T>;
+	using offsets_t = vector<std::size_t>;
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	template<bool Const>
+	class basic_row_iterator;
+
+	// lightweight view of one row with the interface of static_vector_base
+	template<bool Const>
+	class basic_row {
+		friend class jagged_vector;
+		friend class basic_row<!Const>;
+		friend class basic_row_iterator<Const>;
+
+		using owner_t = std::conditional_t<Const, const jagged_vector, jagged_vector>;
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<Const, const T&, T&>;
+		using const_reference = const T&;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using const_pointer = const T*;
+		using iterator = detail::iterator<std::conditional_t<Const, const T, T>>;
+		using const_iterator = detail::iterator<const T>;
+
+		template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+		constexpr basic_row(const basic_row<OtherConst>& other) noexcept : m_owner(other.m_owner), m_row(other.m_row) {}
+
+		// element access
+
+		[[nodiscard]] auto at(const size_type pos) const->reference {
+			if (pos >= size()) throw std::out_of_range("invalid jagged_vector<T> row subscript");
+			return data()[pos];
+		}
+
+		[[nodiscard]] auto operator[](const size_type pos) const noexcept->reference {
+			return data()[pos];
+		}
+
+		[[nodiscard]] auto front() const noexcept->reference {
+			return data()[0];
+		}
+
+		[[nodiscard]] auto back() const noexcept->reference {
+			return data()[size() - 1];
+		}
+
+		[[nodiscard]] auto data() const noexcept->pointer {
+			return m_owner->m_values.data() + m_owner->m_offsets[m_row];
+		}
+
+		// iterators
+
+		[[nodiscard]] auto begin() const noexcept {
+			return iterator(data());
+		}
+
+		[[nodiscard]] auto end() const noexcept {
+			return iterator(data() + size());
+		}
+
+		[[nodiscard]] auto cbegin() const noexcept {
+			return const_iterator(data());
+		}
+
+		[[nodiscard]] auto cend() const noexcept {
+			return const_iterator(data() + size());
+		}
+
+		// capacity
+
+		[[nodiscard]] auto size() const noexcept->size_type {
+			return m_owner->m_ends[m_row] - m_owner->m_offsets[m_row];
+		}
+
+		[[nodiscard]] auto empty() const noexcept->bool {
+			return m_owner->m_ends[m_row] == m_owner->m_offsets[m_row];
+		}
+
+		// number of values the row can hold without moving any other row
+		[[nodiscard]] auto capacity() const noexcept->size_type {
+			return m_owner->row_limit(m_row) - m_owner->m_offsets[m_row];
+		}
+
+		// modifiers
+
+		// O(1) into slack or on the last row, otherwise shifts every following row along by one
+		template<typename... Args, bool C = Const, typename = std::enable_if_t<!C>>
+		auto& emplace_back(Args&&... args) {
+			return m_owner->emplace_into_row(m_row, std::forward<Args>(args)...);
+		}
+
+		template<bool C = Const, typename = std::enable_if_t<!C>>
+		auto push_back(const value_type& val) {
+			emplace_back(val);
+		}
+
+		template<bool C = Const, typename = std::enable_if_t<!C>>
+		auto push_back(value_type&& val) {
+			emplace_back(std::move(val));
+		}
+
+		// the removed values become slack until compact()
+		template<bool C = Const, typename = std::enable_if_t<!C>>
+		auto pop_back() noexcept {
+			--m_owner->m_ends[m_row];
+		}
+
+		template<bool C = Const, typename = std::enable_if_t<!C>>
+		auto erase(const const_iterator first, const const_iterator last)->iterator {
+			// positions come from offsets, as last may be the end of the row and so past the end of the values
+			const auto dest = data() + (first - cbegin());
+			if (first == last) return iterator(dest);
+			const auto tail = data() + (last - cbegin());
+			const auto row_end = data() + size();
+			std::move(tail, row_end, dest);
+			m_owner->m_ends[m_row] -= static_cast<size_type>(tail - dest);
+			return iterator(dest);
+		}
+
+		template<bool C = Const, typename = std::enable_if_t<!C>>
+		auto erase(const const_iterator pos)->iterator {
+			return erase(pos, pos + 1);
+		}
+
+		template<bool C = Const, typename = std::enable_if_t<!C>>
+		auto clear() noexcept {
+			m_owner->m_ends[m_row] = m_owner->m_offsets[m_row];
+		}
+
+	private:
+		constexpr basic_row(owner_t* owner, const size_type row) noexcept : m_owner(owner), m_row(row) {}
+
+	private:
+		owner_t* m_owner;
+		size_type m_row;
+	};
+
+	using row_reference = basic_row<false>;
+	using const_row_reference = basic_row<true>;
+
+	// iterator over rows, yielding row references by value
+	template<bool Const>
+	class basic_row_iterator {
+		friend class jagged_vector;
+
+		using owner_t = std::conditional_t<Const, const jagged_vector, jagged_vector>;
+
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = basic_row<Const>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = basic_row<Const>;
+
+		constexpr basic_row_iterator() noexcept = default;
+
+		[[nodiscard]] constexpr auto operator*() const noexcept->reference {
+			return reference(m_owner, m_row);
+		}
+
+		constexpr auto& operator++() noexcept {
+			++m_row;
+			return *this;
+		}
+
+		constexpr auto operator++(int) noexcept {
+			auto tmp = *this;
+			++m_row;
+			return tmp;
+		}
+
+		constexpr auto& operator--() noexcept {
+			--m_row;
+			return *this;
+		}
+
+		[[nodiscard]] constexpr auto operator-(const basic_row_iterator& other) const noexcept->difference_type {
+			return static_cast<difference_type>(m_row) - static_cast<difference_type>(other.m_row);
+		}
+
+		[[nodiscard]] constexpr auto operator==(const basic_row_iterator& other) const noexcept {
+			return m_row == other.m_row;
+		}
+
+		[[nodiscard]] constexpr auto operator!=(const basic_row_iterator& other) const noexcept {
+			return m_row != other.m_row;
+		}
+
+	private:
+		constexpr basic_row_iterator(owner_t* owner, const size_type row) noexcept : m_owner(owner), m_row(row) {}
+
+	private:
+		owner_t* m_owner = nullptr;
+		size_type m_row = 0;
+	};
+
+	using iterator = basic_row_iterator<false>;
+	using const_iterator = basic_row_iterator<true>;
+
+public:
+	// constructors
+
+	jagged_vector() = default;
+
+	jagged_vector(std::initializer_list<std::initializer_list<value_type>> rows) {
+		m_offsets.reserve(rows.size());
+		m_ends.reserve(rows.size());
+		for (const auto& row : rows) append_row(row);
+	}
+
+	// element access
+
+	[[nodiscard]] auto at(const size_type row) {
+		if (row >= size()) throw std::out_of_range("invalid jagged_vector<T> subscript");
+		return row_reference(this, row);
+	}
+
+	[[nodiscard]] auto at(const size_type row) const {
+		if (row >= size()) throw std::out_of_range("invalid jagged_vector<T> subscript");
+		return const_row_reference(this, row);
+	}
+
+	[[nodiscard]] auto operator[](const size_type row) noexcept {
+		return row_reference(this, row);
+	}
+
+	[[nodiscard]] auto operator[](const size_type row) const noexcept {
+		return const_row_reference(this, row);
+	}
+
+	[[nodiscard]] auto front() noexcept {
+		return row_reference(this, 0);
+	}
+
+	[[nodiscard]] auto front() const noexcept {
+		return const_row_reference(this, 0);
+	}
+
+	[[nodiscard]] auto back() noexcept {
+		return row_reference(this, size() - 1);
+	}
+
+	[[nodiscard]] auto back() const noexcept {
+		return const_row_reference(this, size() - 1);
+	}
+
+	// iterators, over rows
+
+	[[nodiscard]] auto begin() noexcept {
+		return iterator(this, 0);
+	}
+
+	[[nodiscard]] auto begin() const noexcept {
+		return const_iterator(this, 0);
+	}
+
+	[[nodiscard]] auto end() noexcept {
+		return iterator(this, size());
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return const_iterator(this, size());
+	}
+
+	[[nodiscard]] auto cbegin() const noexcept {
+		return begin();
+	}
+
+	[[nodiscard]] auto cend() const noexcept {
+		return end();
+	}
+
+	// capacity
+
+	// number of rows
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_offsets.size();
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_offsets.empty();
+	}
+
+	// number of values across all rows, excluding slack
+	[[nodiscard]] auto value_count() const noexcept->size_type {
+		auto count = m_values.size();
+		for (size_type row = 0; row < size(); ++row) count -= row_limit(row) - m_ends[row];
+		return count;
+	}
+
+	// true if no row has slack, so that row r spans [offset(r), offset(r + 1))
+	[[nodiscard]] auto is_compact() const noexcept->bool {
+		return value_count() == m_values.size();
+	}
+
+	auto reserve(const size_type rows, const size_type values) {
+		m_offsets.reserve(rows);
+		m_ends.reserve(rows);
+		m_values.reserve(values);
+	}
+
+	// modifiers
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	auto append_row(InputIt first, InputIt last) {
+		const auto offset = m_values.size();
+		m_values.insert(m_values.end(), first, last);
+		push_row(offset);
+		return back();
+	}
+
+	auto append_row(std::initializer_list<value_type> ilist) {
+		return append_row(ilist.begin(), ilist.end());
+	}
+
+	auto append_row(const size_type count, const value_type& value) {
+		const auto offset = m_values.size();
+		m_values.insert(m_values.end(), count, value);
+		push_row(offset);
+		return back();
+	}
+
+	// appends an empty row
+	auto append_row() {
+		push_row(m_values.size());
+		return back();
+	}
+
+	// appends to the last row, which must exist; never moves other rows
+	template<typename... Args>
+	auto& emplace_to_last_row(Args&&... args) {
+		return emplace_into_row(size() - 1, std::forward<Args>(args)...);
+	}
+
+	auto append_to_last_row(const value_type& val) {
+		emplace_to_last_row(val);
+	}
+
+	auto append_to_last_row(value_type&& val) {
+		emplace_to_last_row(std::move(val));
+	}
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	auto append_to_last_row(InputIt first, InputIt last) {
+		auto& end = m_ends.back();
+		m_values.erase(m_values.begin() + static_cast<difference_type>(end), m_values.end());
+		m_values.insert(m_values.end(), first, last);
+		end = m_values.size();
+	}
+
+	auto pop_row() {
+		m_values.erase(m_values.begin() + static_cast<difference_type>(m_offsets.back()), m_values.end());
+		m_offsets.pop_back();
+		m_ends.pop_back();
+	}
+
+	auto clear() {
+		m_values.clear();
+		m_offsets.clear();
+		m_ends.clear();
+	}
+
+	// moves every row down over the slack left by in-place removals, in a single pass
+	auto compact() {
+		size_type write = 0;
+		for (size_type row = 0; row < size(); ++row) {
+			const auto first = m_offsets[row];
+			const auto last = m_ends[row];
+			if (first != write) std::move(m_values.data() + first, m_values.data() + last, m_values.data() + write);
+			m_offsets[row] = write;
+			write += last - first;
+			m_ends[row] = write;
+		}
+		m_values.erase(m_values.begin() + static_cast<difference_type>(write), m_values.end());
+	}
+
+	auto swap(jagged_vector& other) {
+		m_values.swap(other.m_values);
+		m_offsets.swap(other.m_offsets);
+		m_ends.swap(other.m_ends);
+	}
+
+private:
+	// end of the storage owned by a row, live values and slack
+	[[nodiscard]] auto row_limit(const size_type row) const noexcept->size_type {
+		return row + 1 < size() ? m_offsets[row + 1] : m_values.size();
+	}
+
+	auto push_row(const size_type offset) {
+		m_offsets.push_back(offset);
+		m_ends.push_back(m_values.size());
+	}
+
+	template<typename... Args>
+	auto& emplace_into_row(const size_type row, Args&&... args) {
+		auto& end = m_ends[row];
+		if (end < row_limit(row)) {
+			m_values[end] = value_type(std::forward<Args>(args)...);
+		}
+		else if (row + 1 == size()) {
+			m_values.emplace_back(std::forward<Args>(args)...);
+		}
+		else {
+			m_values.emplace(m_values.begin() + static_cast<difference_type>(end), std::forward<Args>(args)...);
+			for (auto next = row + 1; next < size(); ++next) {
+				++m_offsets[next];
+				++m_ends[next];
+			}
+		}
+		return m_values[end++];
+	}
+
+private:
+	values_t m_values;
+	offsets_t m_offsets;
+	offsets_t m_ends;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,521 @@
+#ifndef PERFVECT_NUMERIC_H
+#define PERFVECT_NUMERIC_H
+
+#include "simd.h"
+#include "static_vector.h"
+#include "vector.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// opt-in numeric layer over containers of arithmetic elements: +, -, * and / between containers, expressions and
+// scalars build expression templates, which the containers' operator= evaluates element-wise in a single pass with
+// no temporaries, and the reductions sum, dot, norm, min, max, argmin and argmax take containers or expressions alike
+// an expression only refers to its operands, so it must be evaluated before any of them goes away
+
+namespace perfvect {
+namespace detail {
+
+// bound on the size up to which expressions over operands with compile-time capacities are fully unrolled
+inline constexpr std::size_t unrolled_numeric_limit = 64;
+
+template<typename T>
+inline constexpr bool is_numeric_element_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+template<typename V, typename = void>
+inline constexpr bool is_numeric_vector_v = false;
+
+template<typename V>
+inline constexpr bool is_numeric_vector_v<V, std::void_t<typename V::value_type>> =
+	is_numeric_element_v<typename V::value_type> && std::is_base_of_v<static_vector_base<typename V::value_type>, V>;
+
+template<typename E>
+inline constexpr bool is_numeric_expr_v = false;
+
+template<typename Op, typename L, typename R>
+inline constexpr bool is_numeric_expr_v<numeric_expr<Op, L, R>> = true;
+
+// compile-time bound on the size of a container: its capacity if it is fixed
+template<typename V>
+inline constexpr std::size_t extent_of_v = unbounded_extent;
+
+template<typename T, std::size_t Capacity>
+inline constexpr std::size_t extent_of_v<static_vector<T, Capacity>> = Capacity;
+
+// operands
+
+template<typename T, std::size_t Extent>
+class vector_operand {
+public:
+	using value_type = T;
+	static constexpr bool sized = true;
+	static constexpr std::size_t extent = Extent;
+
+	vector_operand(const T* data, const std::size_t size) noexcept : m_data(data), m_size(size) {}
+
+	[[nodiscard]] auto size() const noexcept {
+		return m_size;
+	}
+
+	[[nodiscard]] auto operator[](const std::size_t pos) const noexcept->T {
+		return m_data[pos];
+	}
+
+private:
+	const T* m_data;
+	std::size_t m_size;
+};
+
+template<typename T>
+class scalar_operand {
+public:
+	using value_type = T;
+	static constexpr bool sized = false;
+	static constexpr std::size_t extent = unbounded_extent;
+
+	explicit scalar_operand(const T value) noexcept : m_value(value) {}
+
+	[[nodiscard]] auto operator[](std::size_t) const noexcept->T {
+		return m_value;
+	}
+
+private:
+	T m_value;
+};
+
+// stands in for the right operand of a unary expression
+struct no_operand {
+	static constexpr bool sized = false;
+	static constexpr std::size_t extent = unbounded_extent;
+};
+
+template<typename E>
+[[nodiscard]] auto element_type_of() {
+	if constexpr (is_numeric_vector_v<E> || is_numeric_expr_v<E>) return typename E::value_type{};
+	else return E{};
+}
+
+template<typename E>
+using element_type_t = decltype(element_type_of<E>());
+
+// containers and expressions, of which at least one of an operator's operands must be, and scalars
+template<typename E>
+inline constexpr bool is_numeric_arg_v = is_numeric_vector_v<E> || is_numeric_expr_v<E> || is_numeric_element_v<E>;
+
+// scalars accepted alongside elements of type T: T itself, or a type converting to it without narrowing, so that
+// multiplying integers by 0.5 or mixing in a wider integer fails to compile instead of silently converting
+template<typename S, typename T, typename = void>
+inline constexpr bool is_scalar_of_v = false;
+
+template<typename S, typename T>
+inline constexpr bool is_scalar_of_v<S, T, std::void_t<decltype(T{std::declval<S>()})>> = is_numeric_element_v<S>;
+
+template<typename L, typename R>
+inline constexpr bool is_numeric_pair_v = [] {
+	if constexpr (!is_numeric_arg_v<L> || !is_numeric_arg_v<R>) return false;
+	else if constexpr (is_numeric_element_v<L>) return !is_numeric_element_v<R> && is_scalar_of_v<L, element_type_t<R>>;
+	else if constexpr (is_numeric_element_v<R>) return is_scalar_of_v<R, element_type_t<L>>;
+	else return std::is_same_v<element_type_t<L>, element_type_t<R>>;
+}();
+
+template<typename T, typename E>
+[[nodiscard]] auto to_operand(const E& arg) noexcept {
+	if constexpr (is_numeric_vector_v<E>) return vector_operand<T, extent_of_v<E>>(arg.data(), arg.size());
+	else if constexpr (is_numeric_expr_v<E> || std::is_same_v<E, no_operand>) return arg;
+	else return scalar_operand<T>(static_cast<T>(arg));
+}
+
+template<typename Op, typename L, typename R>
+[[nodiscard]] auto make_expr(const L& lhs, const R& rhs) noexcept {
+	using value_t = element_type_t<std::conditional_t<is_numeric_element_v<L>, R, L>>;
+	using lhs_t = decltype(to_operand<value_t>(lhs));
+	using rhs_t = decltype(to_operand<value_t>(rhs));
+	return numeric_expr<Op, lhs_t, rhs_t>(to_operand<value_t>(lhs), to_operand<value_t>(rhs));
+}
+
+}
+
+// node of an element-wise expression: Op applied to the elements of L and R at each position, or to those of L alone
+// when R is detail::no_operand; every sized operand must have the same size
+template<typename Op, typename L, typename R>
+class numeric_expr {
+public:
+	using value_type = typename L::value_type;
+	static constexpr bool sized = true;
+	static constexpr std::size_t extent = L::extent < R::extent ? L::extent : R::extent;
+
+	numeric_expr(const L& lhs, const R& rhs) noexcept : m_lhs(lhs), m_rhs(rhs) {}
+
+	[[nodiscard]] auto size() const->std::size_t {
+		if constexpr (!L::sized) {
+			return m_rhs.size();
+		}
+		else if constexpr (!R::sized) {
+			return m_lhs.size();
+		}
+		else {
+			#if _DEBUG
+			if (m_lhs.size() != m_rhs.size())
+				throw std::length_error("numeric_expr operands differ in size");
+			#endif
+			return m_lhs.size();
+		}
+	}
+
+	[[nodiscard]] auto operator[](const std::size_t pos) const noexcept->value_type {
+		if constexpr (std::is_same_v<R, detail::no_operand>) return static_cast<value_type>(Op{}(m_lhs[pos]));
+		else return static_cast<value_type>(Op{}(m_lhs[pos], m_rhs[pos]));
+	}
+
+	// writes every element to out, which may be the storage of one of the operands; DestExtent is a compile-time
+	// bound on the destination's capacity, if it has one
+	template<std::size_t DestExtent = detail::unbounded_extent>
+	auto evaluate_into(value_type* out) const;
+
+private:
+	L m_lhs;
+	R m_rhs;
+};
+
+namespace detail {
+
+// kernels: Block elements at a time are computed into a local array before being stored, so the compiler sees the
+// loads of a block precede its stores even when the destination is an operand, and turns each block into vector
+// instructions as wide as the function it is inlined into was compiled for; reductions keep Block partial results
+// in the same way, combining them pairwise at the end, so floating point sums are not added up in sequential order
+
+template<std::size_t Size, typename Expr, typename T>
+inline auto evaluate_block(const Expr& expr, T* out, const std::size_t first) noexcept {
+	if constexpr (Size > 0) {
+		T values[Size];
+		for (std::size_t k = 0; k < Size; ++k) values[k] = expr[first + k];
+		std::memcpy(out + first, values, sizeof(values));
+	}
+}
+
+// evaluates exactly Count elements without a loop
+template<std::size_t Count, std::size_t Block, typename Expr, typename T, std::size_t... Idx>
+inline auto evaluate_unrolled(const Expr& expr, T* out, std::index_sequence<Idx...>) noexcept {
+	(evaluate_block<Block>(expr, out, Idx * Block), ...);
+	evaluate_block<Count % Block>(expr, out, Count - Count % Block);
+}
+
+template<std::size_t Block, typename Expr, typename T>
+inline auto evaluate_kernel(const Expr& expr, T* out, const std::size_t count) noexcept {
+	std::size_t first = 0;
+	for (; first + Block <= count; first += Block) evaluate_block<Block>(expr, out, first);
+	for (; first < count; ++first) out[first] = expr[first];
+}
+
+// partial results of a reduction, one per lane, folded into the result by result()
+
+template<typename T>
+struct sum_reduction {
+	template<std::size_t Lanes>
+	struct lanes {
+		explicit lanes(T) noexcept {}
+
+		auto add(const std::size_t lane, const T value, std::size_t) noexcept {
+			m_sums[lane] = static_cast<T>(m_sums[lane] + value);
+		}
+
+		[[nodiscard]] auto result() noexcept {
+			for (auto width = Lanes / 2; width; width /= 2) {
+				for (std::size_t lane = 0; lane < width; ++lane) m_sums[lane] = static_cast<T>(m_sums[lane] + m_sums[lane + width]);
+			}
+			return m_sums[0];
+		}
+
+		T m_sums[Lanes] = {};
+	};
+};
+
+// the first element ordered before all others by Compare, seeded with the first element so a leading NaN is the
+// result like it is of std::min_element and std::max_element, and a later one never is
+template<typename T, typename Compare>
+struct extremum_reduction {
+	template<std::size_t Lanes>
+	struct lanes {
+		explicit lanes(const T first) noexcept {
+			for (auto& best : m_best) best = first;
+		}
+
+		auto add(const std::size_t lane, const T value, std::size_t) noexcept {
+			m_best[lane] = Compare{}(value, m_best[lane]) ? value : m_best[lane];
+		}
+
+		[[nodiscard]] auto result() noexcept {
+			for (auto width = Lanes / 2; width; width /= 2) {
+				for (std::size_t lane = 0; lane < width; ++lane) {
+					m_best[lane] = Compare{}(m_best[lane + width], m_best[lane]) ? m_best[lane + width] : m_best[lane];
+				}
+			}
+			return m_best[0];
+		}
+
+		T m_best[Lanes];
+	};
+};
+
+// position of the first element ordered before all others by Compare; positions are kept as Index, as wide as the
+// elements where possible so that they are selected by the same vector blends
+template<typename T, typename Index, typename Compare>
+struct arg_reduction {
+	template<std::size_t Lanes>
+	struct lanes {
+		explicit lanes(const T first) noexcept {
+			for (auto& best : m_best) best = first;
+		}
+
+		auto add(const std::size_t lane, const T value, const std::size_t pos) noexcept {
+			const auto better = Compare{}(value, m_best[lane]);
+			m_best[lane] = better ? value : m_best[lane];
+			m_pos[lane] = better ? static_cast<Index>(pos) : m_pos[lane];
+		}
+
+		[[nodiscard]] auto result() noexcept->std::size_t {
+			for (auto width = Lanes / 2; width; width /= 2) {
+				for (std::size_t lane = 0; lane < width; ++lane) {
+					const auto other = lane + width;
+					const auto better = Compare{}(m_best[other], m_best[lane])
+						|| (!Compare{}(m_best[lane], m_best[other]) && m_pos[other] < m_pos[lane]);
+					m_best[lane] = better ? m_best[other] : m_best[lane];
+					m_pos[lane] = better ? m_pos[other] : m_pos[lane];
+				}
+			}
+			return static_cast<std::size_t>(m_pos[0]);
+		}
+
+		T m_best[Lanes];
+		Index m_pos[Lanes] = {};
+	};
+};
+
+template<std::size_t Size, typename State, typename Expr>
+inline auto reduce_block(State& state, const Expr& expr, const std::size_t first) noexcept {
+	for (std::size_t k = 0; k < Size; ++k) state.add(k, expr[first + k], first + k);
+}
+
+// reduces exactly Count elements, at least one, without a loop
+template<std::size_t Count, std::size_t Block, typename Reduction, typename Expr, std::size_t... Idx>
+inline auto reduce_unrolled(const Expr& expr, std::index_sequence<Idx...>) noexcept {
+	typename Reduction::template lanes<Block> state(expr[0]);
+	(reduce_block<Block>(state, expr, Idx * Block), ...);
+	reduce_block<Count % Block>(state, expr, Count - Count % Block);
+	return state.result();
+}
+
+template<std::size_t Block, typename Reduction, typename Expr>
+inline auto reduce_kernel(const Expr& expr, const std::size_t count) noexcept {
+	using value_t = typename Expr::value_type;
+	typename Reduction::template lanes<Block> state(count ? expr[0] : value_t{});
+	std::size_t first = 0;
+	for (; first + Block <= count; first += Block) reduce_block<Block>(state, expr, first);
+	for (std::size_t lane = 0; first < count; ++first, ++lane) state.add(lane, expr[first], first);
+	return state.result();
+}
+
+#if defined(PERFVECT_SIMD_DISPATCH)
+
+// two vectors of elements per block, to keep independent operations in flight
+
+template<typename Expr, typename T>
+PERFVECT_TARGET_AVX2 auto evaluate_avx2(const Expr& expr, T* out, const std::size_t count) noexcept {
+	evaluate_kernel<64 / sizeof(T)>(expr, out, count);
+}
+
+template<typename Expr, typename T>
+PERFVECT_TARGET_AVX512 auto evaluate_avx512(const Expr& expr, T* out, const std::size_t count) noexcept {
+	evaluate_kernel<128 / sizeof(T)>(expr, out, count);
+}
+
+template<typename Reduction, typename Expr>
+PERFVECT_TARGET_AVX2 auto reduce_avx2(const Expr& expr, const std::size_t count) noexcept {
+	return reduce_kernel<64 / sizeof(typename Expr::value_type), Reduction>(expr, count);
+}
+
+template<typename Reduction, typename Expr>
+PERFVECT_TARGET_AVX512 auto reduce_avx512(const Expr& expr, const std::size_t count) noexcept {
+	return reduce_kernel<128 / sizeof(typename Expr::value_type), Reduction>(expr, count);
+}
+
+#endif
+
+// evaluate() and reduce() pick the kernel for level, defaulting to the best supported as in simd.h's dispatch
+// a count equal to Bound, a compile-time bound on it small enough, is instead handled inline by the unrolled kernels
+// with the baseline instruction set, as a call through the dispatch would cost more than the wider vectors save
+
+template<std::size_t Bound, typename Expr, typename T>
+auto evaluate(const Expr& expr, T* out, const std::size_t count, const simd_level level = simd_level_supported()) noexcept {
+	if constexpr (Bound <= unrolled_numeric_limit) {
+		if (count == Bound) return evaluate_unrolled<Bound, 32 / sizeof(T)>(expr, out, std::make_index_sequence<Bound / (32 / sizeof(T))>());
+	}
+	switch (level_for(level, count * sizeof(T))) {
+		#if defined(PERFVECT_SIMD_DISPATCH)
+		case simd_level::avx512: return evaluate_avx512(expr, out, count);
+		case simd_level::avx2: return evaluate_avx2(expr, out, count);
+		#endif
+		default: return evaluate_kernel<32 / sizeof(T)>(expr, out, count);
+	}
+}
+
+template<std::size_t Bound, typename Reduction, typename Expr>
+auto reduce(const Expr& expr, const std::size_t count, const simd_level level = simd_level_supported()) noexcept {
+	using value_t = typename Expr::value_type;
+	constexpr auto block = 32 / sizeof(value_t);
+	if constexpr (Bound > 0 && Bound <= unrolled_numeric_limit) {
+		if (count == Bound) return reduce_unrolled<Bound, block, Reduction>(expr, std::make_index_sequence<Bound / block>());
+	}
+	switch (level_for(level, count * sizeof(value_t))) {
+		#if defined(PERFVECT_SIMD_DISPATCH)
+		case simd_level::avx512: return reduce_avx512<Reduction>(expr, count);
+		case simd_level::avx2: return reduce_avx2<Reduction>(expr, count);
+		#endif
+		default: return reduce_kernel<block, Reduction>(expr, count);
+	}
+}
+
+template<typename Reduction, typename E>
+[[nodiscard]] auto reduce_arg(const E& arg) {
+	using value_t = element_type_t<E>;
+	const auto operand = to_operand<value_t>(arg);
+	return reduce<decltype(operand)::extent, Reduction>(operand, operand.size());
+}
+
+template<typename E, typename Compare>
+[[nodiscard]] auto arg_reduce(const E& arg) {
+	using value_t = element_type_t<E>;
+	using index_t = uint_of_size_t<(sizeof(value_t) < 4 ? 4 : sizeof(value_t))>;
+	const auto operand = to_operand<value_t>(arg);
+	if (operand.size() <= std::numeric_limits<index_t>::max()) {
+		return reduce<decltype(operand)::extent, arg_reduction<value_t, index_t, Compare>>(operand, operand.size());
+	}
+	return reduce<decltype(operand)::extent, arg_reduction<value_t, std::size_t, Compare>>(operand, operand.size());
+}
+
+template<typename E>
+auto check_not_empty(const E& arg, const char* message) {
+	#if _DEBUG
+	if (!to_operand<element_type_t<E>>(arg).size())
+		throw std::out_of_range(message);
+	#endif
+	(void)arg;
+	(void)message;
+}
+
+}
+
+template<typename Op, typename L, typename R>
+template<std::size_t DestExtent>
+auto numeric_expr<Op, L, R>::evaluate_into(value_type* out) const {
+	constexpr auto bound = DestExtent < extent ? DestExtent : extent;
+	detail::evaluate<bound>(*this, out, size());
+}
+
+// element-wise operators, between two containers or expressions of the same element type, or one and a scalar of
+// that type or one converting to it without narrowing
+
+template<typename L, typename R, typename = std::enable_if_t<detail::is_numeric_pair_v<L, R>>>
+[[nodiscard]] auto operator+(const L& lhs, const R& rhs) noexcept {
+	return detail::make_expr<std::plus<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<detail::is_numeric_pair_v<L, R>>>
+[[nodiscard]] auto operator-(const L& lhs, const R& rhs) noexcept {
+	return detail::make_expr<std::minus<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<detail::is_numeric_pair_v<L, R>>>
+[[nodiscard]] auto operator*(const L& lhs, const R& rhs) noexcept {
+	return detail::make_expr<std::multiplies<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename = std::enable_if_t<detail::is_numeric_pair_v<L, R>>>
+[[nodiscard]] auto operator/(const L& lhs, const R& rhs) noexcept {
+	return detail::make_expr<std::divides<>>(lhs, rhs);
+}
+
+template<typename E, typename = std::enable_if_t<detail::is_numeric_vector_v<E> || detail::is_numeric_expr_v<E>>>
+[[nodiscard]] auto operator-(const E& arg) noexcept {
+	return detail::make_expr<std::negate<>>(arg, detail::no_operand{});
+}
+
+// compound assignment, evaluated in place
+
+template<typename V, typename R, typename = std::enable_if_t<detail::is_numeric_vector_v<V> && detail::is_numeric_pair_v<V, R>>>
+auto operator+=(V& lhs, const R& rhs)->V& {
+	return lhs = lhs + rhs;
+}
+
+template<typename V, typename R, typename = std::enable_if_t<detail::is_numeric_vector_v<V> && detail::is_numeric_pair_v<V, R>>>
+auto operator-=(V& lhs, const R& rhs)->V& {
+	return lhs = lhs - rhs;
+}
+
+template<typename V, typename R, typename = std::enable_if_t<detail::is_numeric_vector_v<V> && detail::is_numeric_pair_v<V, R>>>
+auto operator*=(V& lhs, const R& rhs)->V& {
+	return lhs = lhs * rhs;
+}
+
+template<typename V, typename R, typename = std::enable_if_t<detail::is_numeric_vector_v<V> && detail::is_numeric_pair_v<V, R>>>
+auto operator/=(V& lhs, const R& rhs)->V& {
+	return lhs = lhs / rhs;
+}
+
+// reductions over a container or expression, evaluated in the element type; they are fully unrolled when the size
+// reaches a small enough compile-time bound, which is the smallest capacity of the static_vector operands
+
+// sum of the elements, 0 when empty
+template<typename E, typename = std::enable_if_t<detail::is_numeric_vector_v<E> || detail::is_numeric_expr_v<E>>>
+[[nodiscard]] auto sum(const E& arg) {
+	return detail::reduce_arg<detail::sum_reduction<detail::element_type_t<E>>>(arg);
+}
+
+// sum of the products of the elements of lhs and rhs at the same positions
+template<typename L, typename R, typename = std::enable_if_t<detail::is_numeric_pair_v<L, R>
+	&& !detail::is_numeric_element_v<L> && !detail::is_numeric_element_v<R>>>
+[[nodiscard]] auto dot(const L& lhs, const R& rhs) {
+	return sum(lhs * rhs);
+}
+
+// euclidean length, in double for integer elements
+template<typename E, typename = std::enable_if_t<detail::is_numeric_vector_v<E> || detail::is_numeric_expr_v<E>>>
+[[nodiscard]] auto norm(const E& arg) {
+	return std::sqrt(dot(arg, arg));
+}
+
+// smallest element, by operator<; must not be empty
+template<typename E, typename = std::enable_if_t<detail::is_numeric_vector_v<E> || detail::is_numeric_expr_v<E>>>
+[[nodiscard]] auto min(const E& arg) {
+	detail::check_not_empty(arg, "min of an empty range");
+	return detail::reduce_arg<detail::extremum_reduction<detail::element_type_t<E>, std::less<>>>(arg);
+}
+
+// largest element, by operator<; must not be empty
+template<typename E, typename = std::enable_if_t<detail::is_numeric_vector_v<E> || detail::is_numeric_expr_v<E>>>
+[[nodiscard]] auto max(const E& arg) {
+	detail::check_not_empty(arg, "max of an empty range");
+	return detail::reduce_arg<detail::extremum_reduction<detail::element_type_t<E>, std::greater<>>>(arg);
+}
+
+// position of the first smallest element, as std::min_element would find it, or 0 when empty
+template<typename E, typename = std::enable_if_t<detail::is_numeric_vector_v<E> || detail::is_numeric_expr_v<E>>>
+[[nodiscard]] auto argmin(const E& arg)->std::size_t {
+	return detail::arg_reduce<E, std::less<>>(arg);
+}
+
+// position of the first largest element, as std::max_element would find it, or 0 when empty
+template<typename E, typename = std::enable_if_t<detail::is_numeric_vector_v<E> || detail::is_numeric_expr_v<E>>>
+[[nodiscard]] auto argmax(const E& arg)->std::size_t {
+	return detail::arg_reduce<E, std::greater<>>(arg);
+}
+
+}
+
+#endif
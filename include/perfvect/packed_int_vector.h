@@ -0,0 +1,627 @@
+#ifndef PERFVECT_PACKED_INT_VECTOR_H
+#define PERFVECT_PACKED_INT_VECTOR_H
+
+#include "bit.h"
+#include "vector.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace perfvect {
+namespace detail {
+	template<unsigned Bits>
+	using uint_least_t = std::conditional_t<(Bits <= 8), std::uint8_t,
+		std::conditional_t<(Bits <= 16), std::uint16_t,
+		std::conditional_t<(Bits <= 32), std::uint32_t, std::uint64_t>>>;
+
+	[[nodiscard]] constexpr auto low_mask(const unsigned bits) noexcept->std::uint64_t {
+		return bits >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+	}
+
+	// reads the bits-wide field starting at bit pos, which may straddle two words
+	[[nodiscard]] inline auto read_bits(const std::uint64_t* words, const std::size_t pos, const unsigned bits) noexcept {
+		const auto word = pos / 64;
+		const auto shift = static_cast<unsigned>(pos % 64);
+		auto value = words[word] >> shift;
+		if (shift + bits > 64) value |= words[word + 1] << (64 - shift);
+		return value & low_mask(bits);
+	}
+
+	inline auto write_bits(std::uint64_t* words, const std::size_t pos, const unsigned bits, const std::uint64_t value) noexcept {
+		const auto mask = low_mask(bits);
+		const auto word = pos / 64;
+		const auto shift = static_cast<unsigned>(pos % 64);
+		words[word] = (words[word] & ~(mask << shift)) | ((value & mask) << shift);
+		if (shift + bits > 64) {
+			const auto spill = 64 - shift;
+			words[word + 1] = (words[word + 1] & ~(mask >> spill)) | ((value & mask) >> spill);
+		}
+	}
+
+	// field J of a run of Bits-wide fields, with the word index and shift resolved at compile time
+	template<unsigned Bits, std::size_t J>
+	[[nodiscard]] inline auto extract_bits(const std::uint64_t* words) noexcept {
+		constexpr auto word = J * Bits / 64;
+		constexpr auto shift = static_cast<unsigned>(J * Bits % 64);
+		if constexpr (shift + Bits > 64) {
+			return ((words[word] >> shift) | (words[word + 1] << (64 - shift))) & low_mask(Bits);
+		}
+		else {
+			return (words[word] >> shift) & low_mask(Bits);
+		}
+	}
+
+	// unpacks 64 fields (exactly Bits words) in straight-line code the compiler is free to vectorize
+	template<typename T, unsigned Bits, std::size_t... Js>
+	inline auto unpack_64(const std::uint64_t* words, const T reference, T* out, std::index_sequence<Js...>) noexcept {
+		(..., (out[Js] = static_cast<T>(reference + extract_bits<Bits, Js>(words))));
+	}
+
+	// adds reference to count Bits-wide fields and stores them to out
+	template<typename T, unsigned Bits>
+	auto unpack(const std::uint64_t* words, const T reference, T* out, const std::size_t count) noexcept->void {
+		if constexpr (Bits == 0) {
+			std::fill_n(out, count, reference);
+		}
+		else {
+			std::size_t i = 0;
+			for (; i + 64 <= count; i += 64, words += Bits) {
+				unpack_64<T, Bits>(words, reference, out + i, std::make_index_sequence<64>{});
+			}
+			for (std::size_t j = 0; i < count; ++i, ++j) {
+				out[i] = static_cast<T>(reference + read_bits(words, j * Bits, Bits));
+			}
+		}
+	}
+
+	template<typename T>
+	using unpack_fn = void(*)(const std::uint64_t*, T, T*, std::size_t) noexcept;
+
+	template<typename T, std::size_t... Bits>
+	constexpr auto make_unpack_table(std::index_sequence<Bits...>) noexcept {
+		return std::array<unpack_fn<T>, sizeof...(Bits)>{&unpack<T, static_cast<unsigned>(Bits)>...};
+	}
+
+	// unpack kernels indexed by bit width
+	template<typename T>
+	inline constexpr auto unpack_table = make_unpack_table<T>(std::make_index_sequence<std::numeric_limits<T>::digits + 1>{});
+}
+
+// vector of unsigned integers each stored in exactly Bits bits, packed back to back into 64-bit words
+// values are truncated to Bits bits when stored
+template<unsigned Bits>
+class packed_int_vector {
+	static_assert(Bits >= 1 && Bits <= 64, "packed_int_vector width must be between 1 and 64 bits");
+
+	using word_type = std::uint64_t;
+
+public:
+	using value_type = detail::uint_least_t<Bits>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	static constexpr auto bits = Bits;
+	static constexpr auto max_value = static_cast<value_type>(detail::low_mask(Bits));
+
+	class reference {
+		friend class packed_int_vector;
+
+	public:
+		auto& operator=(const value_type value) noexcept {
+			detail::write_bits(m_words, m_pos, Bits, value);
+			return *this;
+		}
+
+		auto& operator=(const reference& other) noexcept {
+			return *this = static_cast<value_type>(other);
+		}
+
+		[[nodiscard]] operator value_type() const noexcept {
+			return static_cast<value_type>(detail::read_bits(m_words, m_pos, Bits));
+		}
+
+	private:
+		constexpr reference(word_type* words, const size_type pos) noexcept : m_words(words), m_pos(pos) {}
+
+	private:
+		word_type* m_words;
+		size_type m_pos;
+	};
+
+	// random access iterator yielding values
+	class const_iterator {
+		friend class packed_int_vector;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = typename packed_int_vector::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		constexpr const_iterator() noexcept = default;
+
+		[[nodiscard]] auto operator*() const noexcept->reference {
+			return (*m_vec)[m_idx];
+		}
+
+		[[nodiscard]] auto operator[](const difference_type off) const noexcept->reference {
+			return (*m_vec)[m_idx + static_cast<size_type>(off)];
+		}
+
+		constexpr auto& operator++() noexcept {
+			++m_idx;
+			return *this;
+		}
+
+		constexpr auto operator++(int) noexcept {
+			auto tmp = *this;
+			++m_idx;
+			return tmp;
+		}
+
+		constexpr auto& operator--() noexcept {
+			--m_idx;
+			return *this;
+		}
+
+		constexpr auto operator--(int) noexcept {
+			auto tmp = *this;
+			--m_idx;
+			return tmp;
+		}
+
+		constexpr auto& operator+=(const difference_type off) noexcept {
+			m_idx += static_cast<size_type>(off);
+			return *this;
+		}
+
+		constexpr auto& operator-=(const difference_type off) noexcept {
+			m_idx -= static_cast<size_type>(off);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr auto operator+(const difference_type off) const noexcept {
+			auto tmp = *this;
+			return tmp += off;
+		}
+
+		[[nodiscard]] constexpr auto operator-(const difference_type off) const noexcept {
+			auto tmp = *this;
+			return tmp -= off;
+		}
+
+		[[nodiscard]] constexpr auto operator-(const const_iterator& other) const noexcept->difference_type {
+			return static_cast<difference_type>(m_idx) - static_cast<difference_type>(other.m_idx);
+		}
+
+		[[nodiscard]] constexpr auto operator==(const const_iterator& other) const noexcept {
+			return m_idx == other.m_idx;
+		}
+
+		[[nodiscard]] constexpr auto operator!=(const const_iterator& other) const noexcept {
+			return m_idx != other.m_idx;
+		}
+
+		[[nodiscard]] constexpr auto operator<(const const_iterator& other) const noexcept {
+			return m_idx < other.m_idx;
+		}
+
+	private:
+		constexpr const_iterator(const packed_int_vector* vec, const size_type idx) noexcept : m_vec(vec), m_idx(idx) {}
+
+	private:
+		const packed_int_vector* m_vec = nullptr;
+		size_type m_idx = 0;
+	};
+
+	using iterator = const_iterator;
+
+public:
+	// constructors
+
+	packed_int_vector() = default;
+
+	explicit packed_int_vector(const size_type count, const value_type value = 0) {
+		resize(count, value);
+	}
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	packed_int_vector(InputIt first, InputIt last) {
+		for (; first != last; ++first) push_back(static_cast<value_type>(*first));
+	}
+
+	packed_int_vector(std::initializer_list<value_type> init) : packed_int_vector(init.begin(), init.end()) {}
+
+	// element access
+
+	[[nodiscard]] auto at(const size_type pos) const->value_type {
+		if (pos >= m_size) throw std::out_of_range("invalid packed_int_vector<Bits> subscript");
+		return (*this)[pos];
+	}
+
+	[[nodiscard]] auto operator[](const size_type pos) const noexcept->value_type {
+		return static_cast<value_type>(detail::read_bits(m_words.data(), pos * Bits, Bits));
+	}
+
+	[[nodiscard]] auto operator[](const size_type pos) noexcept->reference {
+		return reference(m_words.data(), pos * Bits);
+	}
+
+	[[nodiscard]] auto front() const noexcept->value_type {
+		return (*this)[0];
+	}
+
+	[[nodiscard]] auto back() const noexcept->value_type {
+		return (*this)[m_size - 1];
+	}
+
+	// packed words, holding value i in bits [i * Bits, (i + 1) * Bits)
+	[[nodiscard]] auto data() const noexcept->const word_type* {
+		return m_words.data();
+	}
+
+	// decodes count values starting at first into out
+	auto unpack(const size_type first, const size_type count, value_type* out) const noexcept {
+		if (first % 64 == 0) {
+			// runs of 64 values start on a word boundary, so the fixed-shift kernel applies
+			detail::unpack<value_type, Bits>(m_words.data() + first / 64 * Bits, value_type{0}, out, count);
+		}
+		else {
+			for (size_type i = 0; i < count; ++i) out[i] = (*this)[first + i];
+		}
+	}
+
+	// iterators
+
+	[[nodiscard]] auto begin() const noexcept {
+		return const_iterator(this, 0);
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return const_iterator(this, m_size);
+	}
+
+	[[nodiscard]] auto cbegin() const noexcept {
+		return begin();
+	}
+
+	[[nodiscard]] auto cend() const noexcept {
+		return end();
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_size;
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_size == 0;
+	}
+
+	[[nodiscard]] auto capacity() const noexcept->size_type {
+		return m_words.capacity() * 64 / Bits;
+	}
+
+	// bytes of packed storage in use
+	[[nodiscard]] auto memory_bytes() const noexcept->size_type {
+		return m_words.size() * sizeof(word_type);
+	}
+
+	auto reserve(const size_type new_cap) {
+		m_words.reserve(words_for(new_cap));
+	}
+
+	// modifiers
+
+	auto push_back(const value_type value) {
+		if (words_for(m_size + 1) > m_words.size()) m_words.push_back(0);
+		detail::write_bits(m_words.data(), m_size * Bits, Bits, value);
+		++m_size;
+	}
+
+	auto pop_back() noexcept {
+		--m_size;
+		if (words_for(m_size) < m_words.size()) m_words.pop_back();
+	}
+
+	auto resize(const size_type count, const value_type value = 0) {
+		if (count > m_size) {
+			m_words.reserve(words_for(count));
+			while (m_size < count) push_back(value);
+		}
+		else {
+			m_size = count;
+			m_words.erase(m_words.begin() + static_cast<difference_type>(words_for(count)), m_words.end());
+		}
+	}
+
+	auto clear() noexcept {
+		m_words.clear();
+		m_size = 0;
+	}
+
+	auto swap(packed_int_vector& other) {
+		m_words.swap(other.m_words);
+		std::swap(m_size, other.m_size);
+	}
+
+private:
+	[[nodiscard]] static constexpr auto words_for(const size_type count) noexcept->size_type {
+		return (count * Bits + 63) / 64;
+	}
+
+private:
+	vector<word_type> m_words;
+	size_type m_size = 0;
+};
+
+// append-only vector of unsigned integers compressed in blocks of 128 with frame-of-reference encoding: each block
+// stores its values as offsets from a reference value, bit-packed at the narrowest width covering the block's range
+// the last block is re-packed whenever an appended value falls outside its range, so the encoding tunes itself to
+// the data as it arrives
+template<typename T = std::uint32_t>
+class compressed_int_vector {
+	static_assert(std::is_unsigned_v<T> && !std::is_same_v<T, bool>, "compressed_int_vector holds unsigned integers");
+
+	using word_type = std::uint64_t;
+
+	struct block {
+		T reference;
+		std::uint32_t first_word;
+		std::uint8_t bits;
+	};
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	static constexpr size_type block_size = 128;
+
+	// forward iterator decoding a whole block at a time into an internal buffer
+	class const_iterator {
+		friend class compressed_int_vector;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+		const_iterator() noexcept = default;
+
+		[[nodiscard]] auto operator*() const noexcept->reference {
+			return m_buffer[m_idx % block_size];
+		}
+
+		[[nodiscard]] auto operator->() const noexcept->pointer {
+			return &**this;
+		}
+
+		auto& operator++() noexcept {
+			if (++m_idx % block_size == 0 && m_idx < m_vec->size()) m_vec->decode_block(m_idx / block_size, m_buffer);
+			return *this;
+		}
+
+		auto operator++(int) noexcept {
+			auto tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		[[nodiscard]] auto operator==(const const_iterator& other) const noexcept {
+			return m_idx == other.m_idx;
+		}
+
+		[[nodiscard]] auto operator!=(const const_iterator& other) const noexcept {
+			return m_idx != other.m_idx;
+		}
+
+	private:
+		const_iterator(const compressed_int_vector* vec, const size_type idx) noexcept : m_vec(vec), m_idx(idx) {
+			if (idx < vec->size()) vec->decode_block(idx / block_size, m_buffer);
+		}
+
+	private:
+		const compressed_int_vector* m_vec = nullptr;
+		size_type m_idx = 0;
+		T m_buffer[block_size];
+	};
+
+	using iterator = const_iterator;
+
+public:
+	// constructors
+
+	compressed_int_vector() = default;
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	compressed_int_vector(InputIt first, InputIt last) {
+		append(first, last);
+	}
+
+	compressed_int_vector(std::initializer_list<value_type> init) : compressed_int_vector(init.begin(), init.end()) {}
+
+	// element access
+
+	[[nodiscard]] auto at(const size_type pos) const->value_type {
+		if (pos >= m_size) throw std::out_of_range("invalid compressed_int_vector<T> subscript");
+		return (*this)[pos];
+	}
+
+	// O(1): locates the block, then reads a single field
+	[[nodiscard]] auto operator[](const size_type pos) const noexcept->value_type {
+		const auto& blk = m_blocks[pos / block_size];
+		if (!blk.bits) return blk.reference;
+		const auto offset = detail::read_bits(m_words.data() + blk.first_word, pos % block_size * blk.bits, blk.bits);
+		return static_cast<T>(blk.reference + offset);
+	}
+
+	[[nodiscard]] auto front() const noexcept->value_type {
+		return (*this)[0];
+	}
+
+	[[nodiscard]] auto back() const noexcept->value_type {
+		return (*this)[m_size - 1];
+	}
+
+	// decodes block b into out, which must have room for block_size values, and returns the number of values
+	auto decode_block(const size_type b, value_type* out) const noexcept->size_type {
+		const auto& blk = m_blocks[b];
+		const auto count = std::min(block_size, m_size - b * block_size);
+		detail::unpack_table<T>[blk.bits](m_words.data() + blk.first_word, blk.reference, out, count);
+		return count;
+	}
+
+	// calls func(const T* values, size_type count) for each block in turn
+	template<typename Func>
+	auto for_each_block(Func&& func) const {
+		T buffer[block_size];
+		for (size_type b = 0; b < m_blocks.size(); ++b) {
+			const auto count = decode_block(b, buffer);
+			func(static_cast<const T*>(buffer), count);
+		}
+	}
+
+	// iterators
+
+	[[nodiscard]] auto begin() const noexcept {
+		return const_iterator(this, 0);
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return const_iterator(this, m_size);
+	}
+
+	[[nodiscard]] auto cbegin() const noexcept {
+		return begin();
+	}
+
+	[[nodiscard]] auto cend() const noexcept {
+		return end();
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_size;
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_size == 0;
+	}
+
+	[[nodiscard]] auto block_count() const noexcept->size_type {
+		return m_blocks.size();
+	}
+
+	// width each value of block b is packed at
+	[[nodiscard]] auto block_bits(const size_type b) const noexcept->unsigned {
+		return m_blocks[b].bits;
+	}
+
+	// bytes of packed words and block headers in use
+	[[nodiscard]] auto memory_bytes() const noexcept->size_type {
+		return m_words.size() * sizeof(word_type) + m_blocks.size() * sizeof(block);
+	}
+
+	auto reserve_blocks(const size_type blocks) {
+		m_blocks.reserve(blocks);
+	}
+
+	// modifiers
+
+	auto push_back(const value_type value) {
+		const auto pos = m_size % block_size;
+		if (pos == 0) {
+			if (m_words.size() > std::numeric_limits<std::uint32_t>::max()) {
+				throw std::length_error("compressed_int_vector<T> too long");
+			}
+			m_blocks.push_back(block{value, static_cast<std::uint32_t>(m_words.size()), 0});
+		}
+		else {
+			auto& blk = m_blocks[m_blocks.size() - 1];
+			if (value >= blk.reference && fits(static_cast<T>(value - blk.reference), blk.bits)) {
+				if (blk.bits) {
+					detail::write_bits(m_words.data() + blk.first_word, pos * blk.bits, blk.bits, value - blk.reference);
+				}
+			}
+			else {
+				repack_last(pos, value);
+			}
+		}
+		++m_size;
+	}
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	auto append(InputIt first, InputIt last) {
+		for (; first != last; ++first) push_back(static_cast<value_type>(*first));
+	}
+
+	// the last block keeps its width, so popped values may be re-appended without re-packing
+	auto pop_back() {
+		if (--m_size % block_size == 0) {
+			const auto first_word = static_cast<difference_type>(m_blocks[m_blocks.size() - 1].first_word);
+			m_words.erase(m_words.begin() + first_word, m_words.end());
+			m_blocks.pop_back();
+		}
+	}
+
+	auto clear() noexcept {
+		m_words.clear();
+		m_blocks.clear();
+		m_size = 0;
+	}
+
+	auto swap(compressed_int_vector& other) {
+		m_words.swap(other.m_words);
+		m_blocks.swap(other.m_blocks);
+		std::swap(m_size, other.m_size);
+	}
+
+private:
+	[[nodiscard]] static constexpr auto fits(const T offset, const unsigned bits) noexcept {
+		return bits >= std::numeric_limits<T>::digits || (static_cast<std::uint64_t>(offset) >> bits) == 0;
+	}
+
+	// re-encodes the count values of the last block plus value at a width covering all of them
+	// a lower reference is rounded down to a multiple of the new range, so a descending run of appends re-packs a
+	// number of times logarithmic in its range rather than on every append
+	auto repack_last(const size_type count, const value_type value) {
+		auto& blk = m_blocks[m_blocks.size() - 1];
+		T values[block_size];
+		detail::unpack_table<T>[blk.bits](m_words.data() + blk.first_word, blk.reference, values, count);
+		values[count] = value;
+
+		const auto [lo, hi] = std::minmax_element(values, values + count + 1);
+		auto reference = blk.reference;
+		if (*lo < reference) reference = static_cast<T>(*lo & ~detail::low_mask(detail::bit_width(*hi - *lo)));
+
+		const auto bits = detail::bit_width(static_cast<std::uint64_t>(*hi - reference));
+		m_words.resize(blk.first_word + size_type{2} * bits);
+		blk.reference = reference;
+		blk.bits = static_cast<std::uint8_t>(bits);
+
+		const auto words = m_words.data() + blk.first_word;
+		for (size_type i = 0; i <= count; ++i) detail::write_bits(words, i * bits, bits, values[i] - reference);
+	}
+
+private:
+	vector<word_type> m_words;
+	vector<block> m_blocks;
+	size_type m_size = 0;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,226 @@
+#ifndef PERFVECT_PARALLEL_H
+#define PERFVECT_PARALLEL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace perfvect {
+
+// fixed set of worker threads for fork-join bulk operations: run() hands one call to each of the first n workers,
+// with the calling thread acting as worker 0, and returns once all of them have
+// calls to run() from different threads take turns; a task must not call run() on its own pool
+class thread_pool {
+public:
+	explicit thread_pool(const unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+		const auto count = std::max(1u, threads);
+		m_threads.reserve(count - 1);
+		try {
+			for (auto worker = 1u; worker < count; ++worker) m_threads.emplace_back([this, worker] { work(worker); });
+		}
+		catch (...) {
+			stop();
+			throw;
+		}
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	auto operator=(const thread_pool&)->thread_pool& = delete;
+
+	~thread_pool() {
+		stop();
+	}
+
+	// number of workers, counting the thread calling run()
+	[[nodiscard]] auto size() const noexcept->unsigned {
+		return static_cast<unsigned>(m_threads.size()) + 1;
+	}
+
+	// calls task(worker) for every worker below workers (clamped to size()) and waits for all of them, then rethrows
+	// the first exception any of them threw
+	template<typename Task>
+	auto run(unsigned workers, Task&& task) {
+		workers = std::clamp(workers, 1u, size());
+		if (workers == 1) {
+			task(0u);
+			return;
+		}
+
+		std::lock_guard<std::mutex> turn(m_run_mutex);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_task = [](void* context, const unsigned worker) { (*static_cast<std::remove_reference_t<Task>*>(context))(worker); };
+			m_context = static_cast<void*>(std::addressof(task));
+			m_workers = workers;
+			m_pending = workers - 1;
+			m_error = nullptr;
+			++m_generation;
+		}
+		m_wake.notify_all();
+
+		std::exception_ptr error;
+		try {
+			task(0u);
+		}
+		catch (...) {
+			error = std::current_exception();
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this] { return m_pending == 0; });
+		if (!error) error = m_error;
+		if (error) std::rethrow_exception(error);
+	}
+
+private:
+	auto work(const unsigned worker)->void {
+		std::uint64_t seen = 0;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (;;) {
+			m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+			if (m_stop) return;
+			seen = m_generation;
+			if (worker >= m_workers) continue;
+
+			const auto task = m_task;
+			const auto context = m_context;
+			lock.unlock();
+			std::exception_ptr error;
+			try {
+				task(context, worker);
+			}
+			catch (...) {
+				error = std::current_exception();
+			}
+			lock.lock();
+			if (error && !m_error) m_error = error;
+			if (--m_pending == 0) m_done.notify_one();
+		}
+	}
+
+	auto stop() noexcept->void {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+		for (auto& thread : m_threads) thread.join();
+		m_threads.clear();
+	}
+
+private:
+	std::vector<std::thread> m_threads;
+	std::mutex m_run_mutex;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	void (*m_task)(void*, unsigned) = nullptr;
+	void* m_context = nullptr;
+	unsigned m_workers = 0;
+	unsigned m_pending = 0;
+	std::uint64_t m_generation = 0;
+	std::exception_ptr m_error;
+	bool m_stop = false;
+};
+
+// pool used by parallel operations not given one, with a worker per hardware thread, started on first use
+inline auto default_thread_pool()->thread_pool& {
+	static thread_pool pool;
+	return pool;
+}
+
+// selects the parallel overloads of vector's bulk operations, which split their range into one contiguous chunk per
+// worker of pool, using no more workers than leaves each at least min_chunk elements
+class parallel_policy {
+public:
+	static constexpr std::size_t default_min_chunk = std::size_t{1} << 15;
+
+	constexpr parallel_policy() noexcept = default;
+
+	constexpr explicit parallel_policy(thread_pool& pool, const std::size_t min_chunk = default_min_chunk) noexcept :
+		m_pool(&pool), m_min_chunk(std::max<std::size_t>(min_chunk, 1))
+	{}
+
+	[[nodiscard]] auto pool() const->thread_pool& {
+		return m_pool ? *m_pool : default_thread_pool();
+	}
+
+	[[nodiscard]] auto workers_for(const std::size_t count) const->unsigned {
+		const auto chunks = std::max<std::size_t>(count / m_min_chunk, 1);
+		return static_cast<unsigned>(std::min<std::size_t>(chunks, pool().size()));
+	}
+
+private:
+	thread_pool* m_pool = nullptr;
+	std::size_t m_min_chunk = default_min_chunk;
+};
+
+// the default parallel policy, over default_thread_pool()
+inline constexpr parallel_policy par{};
+
+namespace detail {
+	// bounds of worker's chunk when count elements are split between workers; the same worker always gets the same
+	// chunk of a range of the same size, so memory first written by a worker is also the memory it later works on
+	[[nodiscard]] constexpr auto chunk_of(const std::size_t count, const unsigned workers, const unsigned worker) noexcept {
+		const auto first = count / workers * worker + std::min<std::size_t>(worker, count % workers);
+		const auto last = first + count / workers + (worker < count % workers ? 1 : 0);
+		return std::pair<std::size_t, std::size_t>{first, last};
+	}
+
+	// calls func(first, last) over the chunks of count elements, one per worker
+	template<typename Func>
+	auto parallel_for(const parallel_policy& policy, const std::size_t count, Func&& func) {
+		if (!count) return;
+		const auto workers = policy.workers_for(count);
+		policy.pool().run(workers, [&](const unsigned worker) {
+			const auto bounds = chunk_of(count, workers, worker);
+			func(bounds.first, bounds.second);
+		});
+	}
+
+	// constructs count elements at dest in parallel, calling construct(dest + first, first, last) for each chunk, which
+	// must leave nothing constructed in its chunk if it throws (as the std::uninitialized_* algorithms do); if any chunk
+	// throws, the chunks that were built are destroyed again and the first exception is rethrown
+	template<typename T, typename Construct>
+	auto parallel_construct(const parallel_policy& policy, T* dest, const std::size_t count, Construct&& construct) {
+		if (!count) return;
+		const auto workers = policy.workers_for(count);
+		const auto built = std::make_unique<bool[]>(workers);
+		try {
+			policy.pool().run(workers, [&](const unsigned worker) {
+				const auto bounds = chunk_of(count, workers, worker);
+				construct(dest + bounds.first, bounds.first, bounds.second);
+				built[worker] = true;
+			});
+		}
+		catch (...) {
+			for (auto worker = 0u; worker < workers; ++worker) {
+				if (!built[worker]) continue;
+				const auto bounds = chunk_of(count, workers, worker);
+				std::destroy(dest + bounds.first, dest + bounds.second);
+			}
+			throw;
+		}
+	}
+
+	template<typename T>
+	auto parallel_destroy(const parallel_policy& policy, T* data, const std::size_t count) noexcept {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			parallel_for(policy, count, [data](const std::size_t first, const std::size_t last) {
+				std::destroy(data + first, data + last);
+			});
+		}
+	}
+}
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,512 @@
+#ifndef PERFVECT_POLY_VECTOR_H
+#define PERFVECT_POLY_VECTOR_H
+
+#include "static_vector.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace perfvect {
+namespace detail {
+	// type-erased operations for one concrete element type
+	struct poly_ops {
+		std::size_t size;
+		std::size_t align;
+		void (*move_construct)(void* dst, void* src);
+		void (*destroy)(void* obj) noexcept;
+	};
+
+	template<typename Derived>
+	auto poly_move_construct(void* dst, void* src)->void {
+		::new (dst) Derived(std::move_if_noexcept(*std::launder(static_cast<Derived*>(src))));
+	}
+
+	template<typename Derived>
+	auto poly_destroy(void* obj) noexcept->void {
+		std::launder(static_cast<Derived*>(obj))->~Derived();
+	}
+
+	template<typename Derived>
+	inline constexpr poly_ops poly_ops_for{
+		sizeof(Derived), alignof(Derived), &poly_move_construct<Derived>, &poly_destroy<Derived>
+	};
+
+	struct poly_entry {
+		// byte offset of the complete object
+		std::size_t offset;
+		// byte offset of its Base subobject
+		std::size_t base_offset;
+		const poly_ops* ops;
+	};
+
+	[[nodiscard]] constexpr auto align_up(const std::size_t value, const std::size_t align) noexcept {
+		return (value + align - 1) & ~(align - 1);
+	}
+}
+
+// objects derived from Base, stored inline one after another in a single aligned byte buffer
+// each element records its offset and a table of type-erased operations, so elements can be relocated by their own
+// move constructors when the buffer is replaced; derived types must be move or copy constructible
+template<typename Base, typename Entries>
+class poly_vector_base {
+public:
+	using value_type = Base;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+
+	template<bool Const>
+	class basic_iterator {
+		friend class poly_vector_base;
+
+		using buffer_t = std::conditional_t<Const, const std::byte*, std::byte*>;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = Base;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const Base*, Base*>;
+		using reference = std::conditional_t<Const, const Base&, Base&>;
+
+		constexpr basic_iterator() noexcept = default;
+
+		template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+		constexpr basic_iterator(const basic_iterator<OtherConst>& other) noexcept :
+			m_buffer(other.m_buffer), m_entry(other.m_entry)
+		{}
+
+		[[nodiscard]] auto operator*() const noexcept->reference {
+			return *operator->();
+		}
+
+		[[nodiscard]] auto operator->() const noexcept->pointer {
+			return std::launder(reinterpret_cast<pointer>(m_buffer + m_entry->base_offset));
+		}
+
+		[[nodiscard]] auto operator[](const difference_type off) const noexcept->reference {
+			return *(*this + off);
+		}
+
+		constexpr auto& operator++() noexcept {
+			++m_entry;
+			return *this;
+		}
+
+		constexpr auto operator++(int) noexcept {
+			auto tmp = *this;
+			++m_entry;
+			return tmp;
+		}
+
+		constexpr auto& operator--() noexcept {
+			--m_entry;
+			return *this;
+		}
+
+		constexpr auto operator--(int) noexcept {
+			auto tmp = *this;
+			--m_entry;
+			return tmp;
+		}
+
+		constexpr auto& operator+=(const difference_type off) noexcept {
+			m_entry += off;
+			return *this;
+		}
+
+		constexpr auto& operator-=(const difference_type off) noexcept {
+			m_entry -= off;
+			return *this;
+		}
+
+		[[nodiscard]] constexpr auto operator+(const difference_type off) const noexcept {
+			auto tmp = *this;
+			return tmp += off;
+		}
+
+		[[nodiscard]] constexpr auto operator-(const difference_type off) const noexcept {
+			auto tmp = *this;
+			return tmp -= off;
+		}
+
+		[[nodiscard]] constexpr auto operator-(const basic_iterator& other) const noexcept->difference_type {
+			return m_entry - other.m_entry;
+		}
+
+		[[nodiscard]] constexpr auto operator==(const basic_iterator& other) const noexcept {
+			return m_entry == other.m_entry;
+		}
+
+		[[nodiscard]] constexpr auto operator!=(const basic_iterator& other) const noexcept {
+			return m_entry != other.m_entry;
+		}
+
+		[[nodiscard]] constexpr auto operator<(const basic_iterator& other) const noexcept {
+			return m_entry < other.m_entry;
+		}
+
+	private:
+		constexpr basic_iterator(buffer_t buffer, const detail::poly_entry* entry) noexcept :
+			m_buffer(buffer), m_entry(entry)
+		{}
+
+	private:
+		buffer_t m_buffer = nullptr;
+		const detail::poly_entry* m_entry = nullptr;
+	};
+
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+public:
+	poly_vector_base(const poly_vector_base&) = delete;
+	auto operator=(const poly_vector_base&)->poly_vector_base& = delete;
+
+	// element access
+
+	[[nodiscard]] auto at(const size_type pos)->reference {
+		if (pos >= size()) throw std::out_of_range("invalid poly_vector<Base> subscript");
+		return (*this)[pos];
+	}
+
+	[[nodiscard]] auto at(const size_type pos) const->const_reference {
+		if (pos >= size()) throw std::out_of_range("invalid poly_vector<Base> subscript");
+		return (*this)[pos];
+	}
+
+	[[nodiscard]] auto operator[](const size_type pos) noexcept->reference {
+		return *std::launder(reinterpret_cast<pointer>(m_buffer + m_entries[pos].base_offset));
+	}
+
+	[[nodiscard]] auto operator[](const size_type pos) const noexcept->const_reference {
+		return *std::launder(reinterpret_cast<const_pointer>(m_buffer + m_entries[pos].base_offset));
+	}
+
+	[[nodiscard]] auto front() noexcept->reference {
+		return (*this)[0];
+	}
+
+	[[nodiscard]] auto front() const noexcept->const_reference {
+		return (*this)[0];
+	}
+
+	[[nodiscard]] auto back() noexcept->reference {
+		return (*this)[size() - 1];
+	}
+
+	[[nodiscard]] auto back() const noexcept->const_reference {
+		return (*this)[size() - 1];
+	}
+
+	// iterators
+
+	[[nodiscard]] auto begin() noexcept {
+		return iterator(m_buffer, m_entries.data());
+	}
+
+	[[nodiscard]] auto begin() const noexcept {
+		return const_iterator(m_buffer, m_entries.data());
+	}
+
+	[[nodiscard]] auto end() noexcept {
+		return iterator(m_buffer, m_entries.data() + m_entries.size());
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return const_iterator(m_buffer, m_entries.data() + m_entries.size());
+	}
+
+	[[nodiscard]] auto cbegin() const noexcept {
+		return begin();
+	}
+
+	[[nodiscard]] auto cend() const noexcept {
+		return end();
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_entries.size();
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_entries.empty();
+	}
+
+	// bytes occupied by elements and the padding between them
+	[[nodiscard]] auto bytes_used() const noexcept->size_type {
+		return m_used;
+	}
+
+	[[nodiscard]] auto byte_capacity() const noexcept->size_type {
+		return m_capacity;
+	}
+
+	// modifiers
+
+	auto pop_back() noexcept {
+		const auto& entry = m_entries[m_entries.size() - 1];
+		entry.ops->destroy(m_buffer + entry.offset);
+		m_used = entry.offset;
+		m_entries.pop_back();
+	}
+
+	auto clear() noexcept {
+		for (const auto& entry : m_entries) entry.ops->destroy(m_buffer + entry.offset);
+		m_entries.clear();
+		m_used = 0;
+	}
+
+protected:
+	constexpr poly_vector_base(std::byte* const buffer, const size_type capacity) noexcept :
+		m_buffer(buffer), m_capacity(capacity)
+	{}
+
+	~poly_vector_base() = default;
+
+	// offset at which a Derived would be placed next
+	template<typename Derived>
+	[[nodiscard]] auto placement_offset() const noexcept->size_type {
+		return detail::align_up(m_used, alignof(Derived));
+	}
+
+	// the buffer must have room for a Derived at offset
+	template<typename Derived, typename... Args>
+	auto construct_back(const size_type offset, Args&&... args)->Derived& {
+		const auto obj = ::new (m_buffer + offset) Derived(std::forward<Args>(args)...);
+		const auto base = static_cast<const_pointer>(obj);
+		const auto base_offset = static_cast<size_type>(reinterpret_cast<const std::byte*>(base) - m_buffer);
+
+		try {
+			m_entries.push_back(detail::poly_entry{offset, base_offset, &detail::poly_ops_for<Derived>});
+		}
+		catch (...) {
+			obj->~Derived();
+			throw;
+		}
+
+		m_used = offset + sizeof(Derived);
+		return *obj;
+	}
+
+	// moves every element to the same offset in dst and destroys the originals
+	// if a move throws the elements already constructed in dst are destroyed and the originals are left untouched
+	auto relocate_to(std::byte* const dst) {
+		size_type moved = 0;
+		try {
+			for (; moved < m_entries.size(); ++moved) {
+				const auto& entry = m_entries[moved];
+				entry.ops->move_construct(dst + entry.offset, m_buffer + entry.offset);
+			}
+		}
+		catch (...) {
+			for (size_type i = 0; i < moved; ++i) m_entries[i].ops->destroy(dst + m_entries[i].offset);
+			throw;
+		}
+
+		for (const auto& entry : m_entries) entry.ops->destroy(m_buffer + entry.offset);
+	}
+
+	// moves the elements of other into this empty container, which must have at least other.bytes_used() capacity
+	auto take_elements(poly_vector_base& other) {
+		other.relocate_to(m_buffer);
+		for (const auto& entry : other.m_entries) m_entries.push_back(entry);
+		m_used = other.m_used;
+		other.m_entries.clear();
+		other.m_used = 0;
+	}
+
+	auto swap_buffers(poly_vector_base& other) noexcept {
+		std::swap(m_buffer, other.m_buffer);
+		std::swap(m_capacity, other.m_capacity);
+		std::swap(m_used, other.m_used);
+		m_entries.swap(other.m_entries);
+	}
+
+	auto set_buffer(std::byte* const buffer, const size_type capacity) noexcept {
+		m_buffer = buffer;
+		m_capacity = capacity;
+	}
+
+protected:
+	std::byte* m_buffer;
+	size_type m_capacity;
+	size_type m_used = 0;
+	Entries m_entries;
+};
+
+// heap-backed poly_vector, growing by relocating the elements into a buffer at least twice the size
+template<
+	typename Base,
+	typename Allocator = std::pmr::polymorphic_allocator<std::byte>,
+	std::size_t Align = alignof(std::max_align_t)
+>
+class poly_vector : public poly_vector_base<Base, vector<detail::poly_entry>> {
+	using base_t = poly_vector_base<Base, vector<detail::poly_entry>>;
+
+	struct alignas(Align) block {
+		std::byte bytes[Align];
+	};
+
+	using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<block>;
+
+public:
+	using typename base_t::size_type;
+	using allocator_type = Allocator;
+
+public:
+	// constructors
+
+	poly_vector() : base_t(nullptr, 0) {}
+
+	explicit poly_vector(const Allocator& alloc) : base_t(nullptr, 0), m_alloc(alloc) {}
+
+	poly_vector(poly_vector&& other) : base_t(nullptr, 0), m_alloc(other.m_alloc) {
+		this->swap_buffers(other);
+	}
+
+	~poly_vector() {
+		this->clear();
+		deallocate();
+	}
+
+	// operations
+
+	auto& operator=(poly_vector&& other) {
+		if (this == &other) return *this;
+		this->clear();
+		if (m_alloc == other.m_alloc) {
+			this->swap_buffers(other);
+		}
+		else {
+			reserve(other.bytes_used(), other.size());
+			this->take_elements(other);
+		}
+		return *this;
+	}
+
+	// capacity
+
+	auto reserve(const size_type bytes, const size_type count = 0) {
+		if (bytes > this->m_capacity) reallocate(bytes);
+		this->m_entries.reserve(count);
+	}
+
+	// modifiers
+
+	template<typename Derived, typename... Args>
+	auto emplace_back(Args&&... args)->Derived& {
+		static_assert(std::is_base_of_v<Base, Derived>, "poly_vector elements must derive from Base");
+		static_assert(alignof(Derived) <= Align, "poly_vector element is over-aligned");
+
+		const auto offset = this->template placement_offset<Derived>();
+		prepare_for_growth(offset + sizeof(Derived));
+		return this->template construct_back<Derived>(offset, std::forward<Args>(args)...);
+	}
+
+	template<typename Derived>
+	auto push_back(Derived&& value)->std::decay_t<Derived>& {
+		return emplace_back<std::decay_t<Derived>>(std::forward<Derived>(value));
+	}
+
+private:
+	auto prepare_for_growth(const size_type required) {
+		if (required <= this->m_capacity) return;
+		reallocate(std::max(required, this->m_capacity * 2));
+	}
+
+	auto reallocate(const size_type bytes) {
+		const auto blocks = (bytes + Align - 1) / Align;
+		const auto mem = reinterpret_cast<std::byte*>(m_alloc.allocate(blocks));
+
+		try {
+			this->relocate_to(mem);
+		}
+		catch (...) {
+			m_alloc.deallocate(reinterpret_cast<block*>(mem), blocks);
+			throw;
+		}
+
+		deallocate();
+		this->set_buffer(mem, blocks * Align);
+	}
+
+	auto deallocate() {
+		if (this->m_buffer) m_alloc.deallocate(reinterpret_cast<block*>(this->m_buffer), this->m_capacity / Align);
+		this->set_buffer(nullptr, 0);
+	}
+
+private:
+	block_allocator m_alloc;
+};
+
+// poly_vector with a fixed inline buffer of Bytes and no heap allocation at all
+// emplace_back throws std::length_error if the element does not fit
+template<typename Base, std::size_t Bytes, std::size_t Align = alignof(std::max_align_t)>
+class static_poly_vector : public poly_vector_base<
+	Base, static_vector<detail::poly_entry, std::max<std::size_t>(Bytes / sizeof(Base), 1)>
+> {
+	using base_t = poly_vector_base<
+		Base, static_vector<detail::poly_entry, std::max<std::size_t>(Bytes / sizeof(Base), 1)>
+	>;
+
+public:
+	using typename base_t::size_type;
+
+public:
+	// constructors
+
+	static_poly_vector() noexcept : base_t(m_storage, Bytes) {}
+
+	static_poly_vector(static_poly_vector&& other) : static_poly_vector() {
+		this->take_elements(other);
+	}
+
+	~static_poly_vector() {
+		this->clear();
+	}
+
+	// operations
+
+	auto& operator=(static_poly_vector&& other) {
+		if (this == &other) return *this;
+		this->clear();
+		this->take_elements(other);
+		return *this;
+	}
+
+	// modifiers
+
+	template<typename Derived, typename... Args>
+	auto emplace_back(Args&&... args)->Derived& {
+		static_assert(std::is_base_of_v<Base, Derived>, "static_poly_vector elements must derive from Base");
+		static_assert(alignof(Derived) <= Align, "static_poly_vector element is over-aligned");
+
+		const auto offset = this->template placement_offset<Derived>();
+		if (offset + sizeof(Derived) > Bytes) throw std::length_error("static_poly_vector<Base> capacity exceeded");
+		return this->template construct_back<Derived>(offset, std::forward<Args>(args)...);
+	}
+
+	template<typename Derived>
+	auto push_back(Derived&& value)->std::decay_t<Derived>& {
+		return emplace_back<std::decay_t<Derived>>(std::forward<Derived>(value));
+	}
+
+private:
+	alignas(Align) std::byte m_storage[Bytes];
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,206 @@
+#ifndef PERFVECT_PRIORITY_QUEUE_H
+#define PERFVECT_PRIORITY_QUEUE_H
+
+#include "small_vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+namespace perfvect {
+
+// priority queue over an implicit Arity-ary heap in small_vector storage, keeping the greatest element (according to
+// Compare) on top like std::priority_queue
+// a wider heap is shallower and keeps each node's children on one or two cache lines; sifting moves a hole through
+// the heap and places the element once at the end, rather than swapping at every level
+template<
+	typename T,
+	std::size_t StaticCapacity = 16,
+	typename Compare = std::less<T>,
+	std::size_t Arity = 4
+>
+class small_priority_queue {
+	static_assert(Arity >= 2, "small_priority_queue needs an arity of at least 2");
+
+	using storage_t = small_vector<T, StaticCapacity>;
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using value_compare = Compare;
+	using container_type = storage_t;
+
+	static constexpr auto arity = Arity;
+
+public:
+	// constructors
+
+	small_priority_queue() = default;
+
+	explicit small_priority_queue(const Compare& comp) : m_comp(comp) {}
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	small_priority_queue(InputIt first, InputIt last, const Compare& comp = Compare()) : m_comp(comp) {
+		push_range(first, last);
+	}
+
+	small_priority_queue(std::initializer_list<value_type> init, const Compare& comp = Compare()) : m_comp(comp) {
+		push_range(init.begin(), init.end());
+	}
+
+	// element access
+
+	[[nodiscard]] auto top() const noexcept->const_reference {
+		return m_heap[0];
+	}
+
+	// the heap in storage order, which is not sorted order
+	[[nodiscard]] auto container() const noexcept->const container_type& {
+		return m_heap;
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_heap.size();
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_heap.empty();
+	}
+
+	[[nodiscard]] auto capacity() const noexcept->size_type {
+		return m_heap.capacity();
+	}
+
+	auto reserve(const size_type new_cap) {
+		m_heap.reserve(new_cap);
+	}
+
+	// modifiers
+
+	auto push(const value_type& value) {
+		m_heap.push_back(value);
+		sift_up(m_heap.size() - 1);
+	}
+
+	auto push(value_type&& value) {
+		m_heap.push_back(std::move(value));
+		sift_up(m_heap.size() - 1);
+	}
+
+	template<typename... Args>
+	auto emplace(Args&&... args) {
+		m_heap.emplace_back(std::forward<Args>(args)...);
+		sift_up(m_heap.size() - 1);
+	}
+
+	// bulk insert: when the batch is at least as large as the queue, the whole heap is rebuilt bottom-up in O(n)
+	// (Floyd's method), otherwise each new element is sifted up in turn
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	auto push_range(InputIt first, InputIt last) {
+		const auto old_size = m_heap.size();
+		m_heap.insert(m_heap.end(), first, last);
+		const auto added = m_heap.size() - old_size;
+
+		if (added >= old_size) {
+			heapify();
+		}
+		else {
+			for (auto pos = old_size; pos < m_heap.size(); ++pos) sift_up(pos);
+		}
+	}
+
+	auto pop() {
+		if (m_heap.size() > 1) {
+			auto value = std::move(m_heap[m_heap.size() - 1]);
+			m_heap.pop_back();
+			sift_down(0, std::move(value));
+		}
+		else {
+			m_heap.pop_back();
+		}
+	}
+
+	// moves up to count elements from the top to out, greatest first
+	template<typename OutputIt>
+	auto pop_n(size_type count, OutputIt out)->OutputIt {
+		for (count = std::min(count, size()); count; --count) {
+			*out = std::move(m_heap[0]);
+			++out;
+			pop();
+		}
+		return out;
+	}
+
+	// removes up to count elements from the top and returns them greatest first
+	auto pop_n(const size_type count)->storage_t {
+		storage_t batch;
+		batch.reserve(std::min(count, size()));
+		pop_n(count, std::back_inserter(batch));
+		return batch;
+	}
+
+	auto clear() {
+		m_heap.clear();
+	}
+
+	auto swap(small_priority_queue& other) {
+		m_heap.swap(other.m_heap);
+		std::swap(m_comp, other.m_comp);
+	}
+
+private:
+	auto sift_up(size_type pos) {
+		if (!pos) return;
+		auto value = std::move(m_heap[pos]);
+		while (pos) {
+			const auto parent = (pos - 1) / Arity;
+			if (!m_comp(m_heap[parent], value)) break;
+			m_heap[pos] = std::move(m_heap[parent]);
+			pos = parent;
+		}
+		m_heap[pos] = std::move(value);
+	}
+
+	// moves the hole at pos down past every child ordered after value, then fills it with value
+	auto sift_down(size_type pos, value_type&& value) {
+		const auto count = m_heap.size();
+		for (;;) {
+			const auto first_child = pos * Arity + 1;
+			if (first_child >= count) break;
+
+			auto best = first_child;
+			const auto last_child = first_child + Arity < count ? first_child + Arity : count;
+			for (auto child = first_child + 1; child < last_child; ++child) {
+				if (m_comp(m_heap[best], m_heap[child])) best = child;
+			}
+
+			if (!m_comp(value, m_heap[best])) break;
+			m_heap[pos] = std::move(m_heap[best]);
+			pos = best;
+		}
+		m_heap[pos] = std::move(value);
+	}
+
+	auto heapify() {
+		const auto count = m_heap.size();
+		if (count < 2) return;
+		for (auto pos = (count - 2) / Arity + 1; pos-- > 0;) {
+			auto value = std::move(m_heap[pos]);
+			sift_down(pos, std::move(value));
+		}
+	}
+
+private:
+	storage_t m_heap;
+	Compare m_comp;
+};
+
+}
+
+#endif
\ No newline at end of file
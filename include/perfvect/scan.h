@@ -0,0 +1,538 @@
+#ifndef PERFVECT_SCAN_H
+#define PERFVECT_SCAN_H
+
+#include "numeric.h"
+#include "parallel.h"
+#include "simd.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+// prefix scans, delta coding and bounded histograms over the storage of containers of arithmetic elements, in place or
+// appended to another container, with overloads taking a parallel_policy that split large ranges between workers
+
+namespace perfvect {
+namespace detail {
+
+// kernels over raw ranges; out may be the same range as src
+// scans return the running total after the last element, so that a range can be scanned a chunk at a time
+
+// a + b and a - b, wrapping around for signed integers as well instead of overflowing
+template<typename T>
+[[nodiscard]] inline auto wrapping_add(const T a, const T b) noexcept {
+	if constexpr (std::is_integral_v<T>) return static_cast<T>(static_cast<std::make_unsigned_t<T>>(a) + static_cast<std::make_unsigned_t<T>>(b));
+	else return static_cast<T>(a + b);
+}
+
+template<typename T>
+[[nodiscard]] inline auto wrapping_sub(const T a, const T b) noexcept {
+	if constexpr (std::is_integral_v<T>) return static_cast<T>(static_cast<std::make_unsigned_t<T>>(a) - static_cast<std::make_unsigned_t<T>>(b));
+	else return static_cast<T>(a - b);
+}
+
+template<bool Exclusive, typename T>
+auto scan_scalar(const T* src, T* out, const std::size_t count, T carry) noexcept->T {
+	for (std::size_t pos = 0; pos < count; ++pos) {
+		const auto next = wrapping_add(carry, src[pos]);
+		out[pos] = Exclusive ? carry : next;
+		carry = next;
+	}
+	return carry;
+}
+
+// integer scans a vector at a time: the prefix sums within a vector take one shift and add per doubling of the
+// distance summed over, and the running total is carried into the next vector by a single add
+
+#if defined(PERFVECT_SIMD_X86)
+
+template<typename T>
+[[nodiscard]] inline auto add_sse2(const __m128i a, const __m128i b) noexcept {
+	if constexpr (sizeof(T) == 1) return _mm_add_epi8(a, b);
+	else if constexpr (sizeof(T) == 2) return _mm_add_epi16(a, b);
+	else if constexpr (sizeof(T) == 4) return _mm_add_epi32(a, b);
+	else return _mm_add_epi64(a, b);
+}
+
+template<typename T>
+[[nodiscard]] inline auto sub_sse2(const __m128i a, const __m128i b) noexcept {
+	if constexpr (sizeof(T) == 1) return _mm_sub_epi8(a, b);
+	else if constexpr (sizeof(T) == 2) return _mm_sub_epi16(a, b);
+	else if constexpr (sizeof(T) == 4) return _mm_sub_epi32(a, b);
+	else return _mm_sub_epi64(a, b);
+}
+
+template<typename T>
+[[nodiscard]] inline auto prefix_sse2(__m128i x) noexcept {
+	if constexpr (sizeof(T) <= 1) x = add_sse2<T>(x, _mm_slli_si128(x, 1));
+	if constexpr (sizeof(T) <= 2) x = add_sse2<T>(x, _mm_slli_si128(x, 2));
+	if constexpr (sizeof(T) <= 4) x = add_sse2<T>(x, _mm_slli_si128(x, 4));
+	return add_sse2<T>(x, _mm_slli_si128(x, 8));
+}
+
+// the last element copied to every lane
+template<typename T>
+[[nodiscard]] inline auto broadcast_last_sse2(__m128i x) noexcept {
+	if constexpr (sizeof(T) == 1) x = _mm_unpackhi_epi8(x, x);
+	if constexpr (sizeof(T) <= 2) x = _mm_shufflehi_epi16(x, 0xFF);
+	return _mm_shuffle_epi32(x, sizeof(T) == 8 ? 0xEE : 0xFF);
+}
+
+template<typename T>
+[[nodiscard]] inline auto first_lane_sse2(const __m128i x) noexcept {
+	if constexpr (sizeof(T) == 8) return static_cast<T>(_mm_cvtsi128_si64(x));
+	else return static_cast<T>(_mm_cvtsi128_si32(x));
+}
+
+template<bool Exclusive, typename T>
+auto scan_sse2(const T* src, T* out, const std::size_t count, const T carry) noexcept->T {
+	constexpr auto lanes = 16 / sizeof(T);
+	auto running = splat_sse2(carry);
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+		const auto prefix = prefix_sse2<T>(x);
+		const auto sums = add_sse2<T>(prefix, running);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + pos), Exclusive ? sub_sse2<T>(sums, x) : sums);
+		running = add_sse2<T>(running, broadcast_last_sse2<T>(prefix));
+	}
+	return scan_scalar<Exclusive>(src + pos, out + pos, count - pos, first_lane_sse2<T>(running));
+}
+
+#endif
+
+#if defined(PERFVECT_SIMD_DISPATCH)
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 inline auto add_avx2(const __m256i a, const __m256i b) noexcept {
+	if constexpr (sizeof(T) == 1) return _mm256_add_epi8(a, b);
+	else if constexpr (sizeof(T) == 2) return _mm256_add_epi16(a, b);
+	else if constexpr (sizeof(T) == 4) return _mm256_add_epi32(a, b);
+	else return _mm256_add_epi64(a, b);
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 inline auto sub_avx2(const __m256i a, const __m256i b) noexcept {
+	if constexpr (sizeof(T) == 1) return _mm256_sub_epi8(a, b);
+	else if constexpr (sizeof(T) == 2) return _mm256_sub_epi16(a, b);
+	else if constexpr (sizeof(T) == 4) return _mm256_sub_epi32(a, b);
+	else return _mm256_sub_epi64(a, b);
+}
+
+// the last element of each 128-bit half copied to every lane of that half
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 inline auto broadcast_last_in_halves_avx2(__m256i x) noexcept {
+	if constexpr (sizeof(T) == 1) x = _mm256_unpackhi_epi8(x, x);
+	if constexpr (sizeof(T) <= 2) x = _mm256_shufflehi_epi16(x, 0xFF);
+	return _mm256_shuffle_epi32(x, sizeof(T) == 8 ? 0xEE : 0xFF);
+}
+
+// byte shifts only move within each half, so the total of the low half is added to the high one at the end
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 inline auto prefix_avx2(__m256i x) noexcept {
+	if constexpr (sizeof(T) <= 1) x = add_avx2<T>(x, _mm256_slli_si256(x, 1));
+	if constexpr (sizeof(T) <= 2) x = add_avx2<T>(x, _mm256_slli_si256(x, 2));
+	if constexpr (sizeof(T) <= 4) x = add_avx2<T>(x, _mm256_slli_si256(x, 4));
+	x = add_avx2<T>(x, _mm256_slli_si256(x, 8));
+	return add_avx2<T>(x, broadcast_last_in_halves_avx2<T>(_mm256_permute2x128_si256(x, x, 0x08)));
+}
+
+template<bool Exclusive, typename T>
+PERFVECT_TARGET_AVX2 auto scan_avx2(const T* src, T* out, const std::size_t count, const T carry) noexcept->T {
+	constexpr auto lanes = 32 / sizeof(T);
+	auto running = splat_avx2(carry);
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		const auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + pos));
+		const auto prefix = prefix_avx2<T>(x);
+		const auto sums = add_avx2<T>(prefix, running);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + pos), Exclusive ? sub_avx2<T>(sums, x) : sums);
+		running = add_avx2<T>(running, broadcast_last_in_halves_avx2<T>(_mm256_permute2x128_si256(prefix, prefix, 0x11)));
+	}
+	return scan_scalar<Exclusive>(src + pos, out + pos, count - pos, first_lane_sse2<T>(_mm256_castsi256_si128(running)));
+}
+
+#endif
+
+// out[pos] = src[pos] - src[pos - 1], with prev standing in for src[-1]; positions are written highest first, a
+// block at a time through a local array, so that every element is read before the position holding it is overwritten
+// when out is src, and the compiler turns each block into vector instructions as wide as the function it is inlined
+// into was compiled for
+template<std::size_t Block, typename T>
+inline auto delta_encode_kernel(const T* src, T* out, const std::size_t count, const T prev) noexcept {
+	if (!count) return;
+	auto pos = count;
+	for (; pos > Block; pos -= Block) {
+		const auto first = pos - Block;
+		T values[Block];
+		for (std::size_t k = 0; k < Block; ++k) values[k] = wrapping_sub(src[first + k], src[first + k - 1]);
+		std::memcpy(out + first, values, sizeof(values));
+	}
+	for (; pos > 1; --pos) out[pos - 1] = wrapping_sub(src[pos - 1], src[pos - 2]);
+	out[0] = wrapping_sub(src[0], prev);
+}
+
+#if defined(PERFVECT_SIMD_DISPATCH)
+
+template<typename T>
+PERFVECT_TARGET_AVX2 auto delta_encode_avx2(const T* src, T* out, const std::size_t count, const T prev) noexcept {
+	delta_encode_kernel<64 / sizeof(T)>(src, out, count, prev);
+}
+
+template<typename T>
+PERFVECT_TARGET_AVX512 auto delta_encode_avx512(const T* src, T* out, const std::size_t count, const T prev) noexcept {
+	delta_encode_kernel<128 / sizeof(T)>(src, out, count, prev);
+}
+
+#endif
+
+// scan() and delta_encode() pick the kernel for level, defaulting to the best supported as in simd.h's dispatch
+// floating point scans stay scalar, adding the elements up in order exactly as std::inclusive_scan does; AVX-512
+// machines run the AVX2 scan, as a wider vector only lengthens the chain of shifts
+
+template<bool Exclusive, typename T>
+auto scan(const T* src, T* out, const std::size_t count, const T carry, const simd_level level = simd_level_supported()) noexcept->T {
+	if constexpr (std::is_integral_v<T>) {
+		switch (level_for(level, count * sizeof(T))) {
+			#if defined(PERFVECT_SIMD_DISPATCH)
+			case simd_level::avx512:
+			case simd_level::avx2: return scan_avx2<Exclusive>(src, out, count, carry);
+			#endif
+			#if defined(PERFVECT_SIMD_X86)
+			case simd_level::sse2: return scan_sse2<Exclusive>(src, out, count, carry);
+			#endif
+			default: break;
+		}
+	}
+	(void)level;
+	return scan_scalar<Exclusive>(src, out, count, carry);
+}
+
+template<typename T>
+auto delta_encode(const T* src, T* out, const std::size_t count, const T prev, const simd_level level = simd_level_supported()) noexcept {
+	switch (level_for(level, count * sizeof(T))) {
+		#if defined(PERFVECT_SIMD_DISPATCH)
+		case simd_level::avx512: return delta_encode_avx512(src, out, count, prev);
+		case simd_level::avx2: return delta_encode_avx2(src, out, count, prev);
+		#endif
+		default: return delta_encode_kernel<16 / sizeof(T)>(src, out, count, prev);
+	}
+}
+
+// histograms: a run of equal values would make every increment wait for the one before it to be stored, so with few
+// enough bins the values are counted round robin into several copies of the histogram, summed up at the end; each
+// copy has an extra bin past the last counting the values out of range, which leaves the loop without branches
+
+inline constexpr std::size_t histogram_copies = 4;
+
+// most bins counted through copies, whose counters all stay within the L1 cache
+inline constexpr std::size_t histogram_copy_limit = 1024;
+
+// copies up to this many counters are kept on the stack
+inline constexpr std::size_t histogram_stack_counters = 1024;
+
+// adds one to counts[value] for each value below bins, returning how many were not; negative values are not below bins
+template<typename T, typename Count>
+auto histogram(const T* values, const std::size_t count, Count* counts, const std::size_t bins)->std::size_t {
+	using key_t = std::make_unsigned_t<T>;
+	const auto bin_of = [bins](const T value) {
+		const auto key = static_cast<key_t>(value);
+		return key < bins ? static_cast<std::size_t>(key) : bins;
+	};
+
+	const auto stride = bins + 1;
+	if (bins > histogram_copy_limit || count < histogram_copies * stride) {
+		std::size_t outside = 0;
+		for (std::size_t pos = 0; pos < count; ++pos) {
+			const auto bin = bin_of(values[pos]);
+			if (bin < bins) ++counts[bin];
+			else ++outside;
+		}
+		return outside;
+	}
+
+	const auto counters = histogram_copies * stride;
+	std::size_t stack[histogram_stack_counters];
+	std::unique_ptr<std::size_t[]> heap;
+	auto copies = stack;
+	if (counters > histogram_stack_counters) {
+		heap = std::make_unique<std::size_t[]>(counters);
+		copies = heap.get();
+	}
+	else {
+		std::fill_n(copies, counters, std::size_t{0});
+	}
+
+	std::size_t* copy_of[histogram_copies];
+	for (std::size_t copy = 0; copy < histogram_copies; ++copy) copy_of[copy] = copies + copy * stride;
+
+	std::size_t pos = 0;
+	for (; pos + histogram_copies <= count; pos += histogram_copies) {
+		for (std::size_t copy = 0; copy < histogram_copies; ++copy) ++copy_of[copy][bin_of(values[pos + copy])];
+	}
+	for (; pos < count; ++pos) ++copies[bin_of(values[pos])];
+
+	for (std::size_t bin = 0; bin < bins; ++bin) {
+		std::size_t total = 0;
+		for (std::size_t copy = 0; copy < histogram_copies; ++copy) total += copies[copy * stride + bin];
+		counts[bin] = static_cast<Count>(counts[bin] + total);
+	}
+	std::size_t outside = 0;
+	for (std::size_t copy = 0; copy < histogram_copies; ++copy) outside += copies[copy * stride + bins];
+	return outside;
+}
+
+// parallel kernels: scans first sum each worker's chunk, then scan the chunks starting from the total of those before
+// them; delta encoding reads the element before each chunk up front, so that chunks can be encoded in place at once
+
+// total of a chunk, wrapping like the scans themselves; integer sums are still vectorized by the compiler, since
+// wrapping addition is associative
+template<typename T>
+[[nodiscard]] auto sum_values(const T* data, const std::size_t count) noexcept->T {
+	T total{};
+	for (std::size_t pos = 0; pos < count; ++pos) total = wrapping_add(total, data[pos]);
+	return total;
+}
+
+template<bool Exclusive, typename T>
+auto parallel_scan(const parallel_policy& policy, const T* src, T* out, const std::size_t count, T carry)->T {
+	const auto workers = policy.workers_for(count);
+	if (workers == 1) return scan<Exclusive>(src, out, count, carry);
+
+	const auto starts = std::make_unique<T[]>(workers);
+	policy.pool().run(workers, [&](const unsigned worker) {
+		const auto bounds = chunk_of(count, workers, worker);
+		starts[worker] = sum_values(src + bounds.first, bounds.second - bounds.first);
+	});
+	for (auto worker = 0u; worker < workers; ++worker) {
+		const auto total = starts[worker];
+		starts[worker] = carry;
+		carry = wrapping_add(carry, total);
+	}
+	policy.pool().run(workers, [&](const unsigned worker) {
+		const auto bounds = chunk_of(count, workers, worker);
+		scan<Exclusive>(src + bounds.first, out + bounds.first, bounds.second - bounds.first, starts[worker]);
+	});
+	return carry;
+}
+
+template<typename T>
+auto parallel_delta_encode(const parallel_policy& policy, const T* src, T* out, const std::size_t count, const T prev) {
+	const auto workers = policy.workers_for(count);
+	if (workers == 1) return delta_encode(src, out, count, prev);
+
+	const auto prevs = std::make_unique<T[]>(workers);
+	for (auto worker = 0u; worker < workers; ++worker) {
+		prevs[worker] = worker ? src[chunk_of(count, workers, worker).first - 1] : prev;
+	}
+	policy.pool().run(workers, [&](const unsigned worker) {
+		const auto bounds = chunk_of(count, workers, worker);
+		delta_encode(src + bounds.first, out + bounds.first, bounds.second - bounds.first, prevs[worker]);
+	});
+}
+
+// every worker counts its chunk into a histogram of its own, and the bins of those are then summed up in parallel
+template<typename T, typename Count>
+auto parallel_histogram(const parallel_policy& policy, const T* values, const std::size_t count, Count* counts, const std::size_t bins)->std::size_t {
+	const auto workers = policy.workers_for(count);
+	if (workers == 1) return histogram(values, count, counts, bins);
+
+	const auto partial = std::make_unique<std::size_t[]>(workers * bins);
+	const auto outside = std::make_unique<std::size_t[]>(workers);
+	policy.pool().run(workers, [&](const unsigned worker) {
+		const auto bounds = chunk_of(count, workers, worker);
+		outside[worker] = histogram(values + bounds.first, bounds.second - bounds.first, partial.get() + worker * bins, bins);
+	});
+	parallel_for(policy, bins, [&](const std::size_t first, const std::size_t last) {
+		for (auto bin = first; bin < last; ++bin) {
+			std::size_t total = 0;
+			for (auto worker = 0u; worker < workers; ++worker) total += partial[worker * bins + bin];
+			counts[bin] = static_cast<Count>(counts[bin] + total);
+		}
+	});
+
+	std::size_t total = 0;
+	for (auto worker = 0u; worker < workers; ++worker) total += outside[worker];
+	return total;
+}
+
+template<typename T>
+auto check_scan_capacity(const static_vector_base<T>& out, const std::size_t needed, const char* message) {
+	if (out.capacity() - out.size() < needed) throw std::length_error(message);
+}
+
+}
+
+// scans and delta coding of arithmetic elements, computed in the element type so that integers wrap; integer scans
+// and all delta encoding go through SIMD kernels, while floating point scans add up the elements in order like
+// std::inclusive_scan does, except in parallel, where each chunk is summed on its own first
+// the _into forms append their result to out, which must be a container other than src with spare capacity for
+// src.size() elements (std::length_error is thrown otherwise)
+
+// replaces each element with init plus the sum of it and those before it, returning init plus the sum of them all
+template<typename T>
+auto inclusive_scan(static_vector_base<T>& vec, const typename static_vector_base<T>::value_type init = {})->T {
+	static_assert(detail::is_numeric_element_v<T>, "inclusive_scan needs arithmetic elements");
+	return detail::scan<false>(vec.data(), vec.data(), vec.size(), init);
+}
+
+// replaces each element with init plus the sum of those before it, returning init plus the sum of them all
+template<typename T>
+auto exclusive_scan(static_vector_base<T>& vec, const typename static_vector_base<T>::value_type init = {})->T {
+	static_assert(detail::is_numeric_element_v<T>, "exclusive_scan needs arithmetic elements");
+	return detail::scan<true>(vec.data(), vec.data(), vec.size(), init);
+}
+
+template<typename T>
+auto inclusive_scan_into(const static_vector_base<T>& src, static_vector_base<T>& out, const typename static_vector_base<T>::value_type init = {})->T {
+	static_assert(detail::is_numeric_element_v<T>, "inclusive_scan_into needs arithmetic elements");
+	detail::check_scan_capacity(out, src.size(), "not enough spare capacity for inclusive_scan_into");
+	auto total = init;
+	out.append_unchecked(src.size(), [&](T* dest) {
+		total = detail::scan<false>(src.data(), dest, src.size(), init);
+		return src.size();
+	});
+	return total;
+}
+
+template<typename T>
+auto exclusive_scan_into(const static_vector_base<T>& src, static_vector_base<T>& out, const typename static_vector_base<T>::value_type init = {})->T {
+	static_assert(detail::is_numeric_element_v<T>, "exclusive_scan_into needs arithmetic elements");
+	detail::check_scan_capacity(out, src.size(), "not enough spare capacity for exclusive_scan_into");
+	auto total = init;
+	out.append_unchecked(src.size(), [&](T* dest) {
+		total = detail::scan<true>(src.data(), dest, src.size(), init);
+		return src.size();
+	});
+	return total;
+}
+
+// replaces each element with its difference from the one before it, the first with its difference from base
+template<typename T>
+auto delta_encode(static_vector_base<T>& vec, const typename static_vector_base<T>::value_type base = {}) {
+	static_assert(detail::is_numeric_element_v<T>, "delta_encode needs arithmetic elements");
+	detail::delta_encode(vec.data(), vec.data(), vec.size(), base);
+}
+
+// undoes delta_encode with the same base
+template<typename T>
+auto delta_decode(static_vector_base<T>& vec, const typename static_vector_base<T>::value_type base = {}) {
+	static_assert(detail::is_numeric_element_v<T>, "delta_decode needs arithmetic elements");
+	detail::scan<false>(vec.data(), vec.data(), vec.size(), base);
+}
+
+template<typename T>
+auto delta_encode_into(const static_vector_base<T>& src, static_vector_base<T>& out, const typename static_vector_base<T>::value_type base = {}) {
+	static_assert(detail::is_numeric_element_v<T>, "delta_encode_into needs arithmetic elements");
+	detail::check_scan_capacity(out, src.size(), "not enough spare capacity for delta_encode_into");
+	out.append_unchecked(src.size(), [&](T* dest) {
+		detail::delta_encode(src.data(), dest, src.size(), base);
+		return src.size();
+	});
+}
+
+template<typename T>
+auto delta_decode_into(const static_vector_base<T>& src, static_vector_base<T>& out, const typename static_vector_base<T>::value_type base = {}) {
+	static_assert(detail::is_numeric_element_v<T>, "delta_decode_into needs arithmetic elements");
+	detail::check_scan_capacity(out, src.size(), "not enough spare capacity for delta_decode_into");
+	out.append_unchecked(src.size(), [&](T* dest) {
+		detail::scan<false>(src.data(), dest, src.size(), base);
+		return src.size();
+	});
+}
+
+// bounded histogram of integer values: adds one to counts[value] for every value below counts.size(), keeping what
+// counts already held, and returns how many values were out of range (negative values always are)
+template<typename T, typename Count>
+auto histogram(const static_vector_base<T>& values, static_vector_base<Count>& counts)->std::size_t {
+	static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "histogram needs integer values");
+	static_assert(std::is_integral_v<Count> && !std::is_same_v<Count, bool>, "histogram needs integer counts");
+	return detail::histogram(values.data(), values.size(), counts.data(), counts.size());
+}
+
+// parallel forms, splitting the range between the workers of policy (perfvect::par for the default pool) as vector's
+// parallel bulk operations do; scans and decoding make two passes over the elements, so they only pay off on
+// ranges well past the size of the caches
+
+template<typename T>
+auto inclusive_scan(const parallel_policy& policy, static_vector_base<T>& vec, const typename static_vector_base<T>::value_type init = {})->T {
+	static_assert(detail::is_numeric_element_v<T>, "inclusive_scan needs arithmetic elements");
+	return detail::parallel_scan<false>(policy, vec.data(), vec.data(), vec.size(), init);
+}
+
+template<typename T>
+auto exclusive_scan(const parallel_policy& policy, static_vector_base<T>& vec, const typename static_vector_base<T>::value_type init = {})->T {
+	static_assert(detail::is_numeric_element_v<T>, "exclusive_scan needs arithmetic elements");
+	return detail::parallel_scan<true>(policy, vec.data(), vec.data(), vec.size(), init);
+}
+
+template<typename T>
+auto inclusive_scan_into(const parallel_policy& policy, const static_vector_base<T>& src, static_vector_base<T>& out, const typename static_vector_base<T>::value_type init = {})->T {
+	static_assert(detail::is_numeric_element_v<T>, "inclusive_scan_into needs arithmetic elements");
+	detail::check_scan_capacity(out, src.size(), "not enough spare capacity for inclusive_scan_into");
+	auto total = init;
+	out.append_unchecked(src.size(), [&](T* dest) {
+		total = detail::parallel_scan<false>(policy, src.data(), dest, src.size(), init);
+		return src.size();
+	});
+	return total;
+}
+
+template<typename T>
+auto exclusive_scan_into(const parallel_policy& policy, const static_vector_base<T>& src, static_vector_base<T>& out, const typename static_vector_base<T>::value_type init = {})->T {
+	static_assert(detail::is_numeric_element_v<T>, "exclusive_scan_into needs arithmetic elements");
+	detail::check_scan_capacity(out, src.size(), "not enough spare capacity for exclusive_scan_into");
+	auto total = init;
+	out.append_unchecked(src.size(), [&](T* dest) {
+		total = detail::parallel_scan<true>(policy, src.data(), dest, src.size(), init);
+		return src.size();
+	});
+	return total;
+}
+
+template<typename T>
+auto delta_encode(const parallel_policy& policy, static_vector_base<T>& vec, const typename static_vector_base<T>::value_type base = {}) {
+	static_assert(detail::is_numeric_element_v<T>, "delta_encode needs arithmetic elements");
+	detail::parallel_delta_encode(policy, vec.data(), vec.data(), vec.size(), base);
+}
+
+template<typename T>
+auto delta_decode(const parallel_policy& policy, static_vector_base<T>& vec, const typename static_vector_base<T>::value_type base = {}) {
+	static_assert(detail::is_numeric_element_v<T>, "delta_decode needs arithmetic elements");
+	detail::parallel_scan<false>(policy, vec.data(), vec.data(), vec.size(), base);
+}
+
+template<typename T>
+auto delta_encode_into(const parallel_policy& policy, const static_vector_base<T>& src, static_vector_base<T>& out, const typename static_vector_base<T>::value_type base = {}) {
+	static_assert(detail::is_numeric_element_v<T>, "delta_encode_into needs arithmetic elements");
+	detail::check_scan_capacity(out, src.size(), "not enough spare capacity for delta_encode_into");
+	out.append_unchecked(src.size(), [&](T* dest) {
+		detail::parallel_delta_encode(policy, src.data(), dest, src.size(), base);
+		return src.size();
+	});
+}
+
+template<typename T>
+auto delta_decode_into(const parallel_policy& policy, const static_vector_base<T>& src, static_vector_base<T>& out, const typename static_vector_base<T>::value_type base = {}) {
+	static_assert(detail::is_numeric_element_v<T>, "delta_decode_into needs arithmetic elements");
+	detail::check_scan_capacity(out, src.size(), "not enough spare capacity for delta_decode_into");
+	out.append_unchecked(src.size(), [&](T* dest) {
+		detail::parallel_scan<false>(policy, src.data(), dest, src.size(), base);
+		return src.size();
+	});
+}
+
+template<typename T, typename Count>
+auto histogram(const parallel_policy& policy, const static_vector_base<T>& values, static_vector_base<Count>& counts)->std::size_t {
+	static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "histogram needs integer values");
+	static_assert(std::is_integral_v<Count> && !std::is_same_v<Count, bool>, "histogram needs integer counts");
+	return detail::parallel_histogram(policy, values.data(), values.size(), counts.data(), counts.size());
+}
+
+}
+
+#endif
@@ -0,0 +1,354 @@
+#ifndef PERFVECT_SET_OPERATIONS_H
+#define PERFVECT_SET_OPERATIONS_H
+
+#include "bit.h"
+#include "simd.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace perfvect {
+namespace detail {
+
+// kernels for sorted-set algebra over raw ascending ranges, writing to out and returning how many they wrote
+// arithmetic and enum values only: their comparisons are cheap enough to be made branchless, trading a store of every
+// candidate for the mispredictions a branch per element would cost on random input
+
+// size ratio from which the smaller range is walked element by element, galloping through the larger one
+inline constexpr std::size_t gallop_ratio = 32;
+
+// the same ratio for filtering by the block kernel, which skips through the larger range a block at a time by itself
+inline constexpr std::size_t block_gallop_ratio = 128;
+
+// 32 and 64-bit integers and enums, compared a whole block against another by the AVX2 kernel
+template<typename T>
+inline constexpr bool is_block_comparable_v = (std::is_integral_v<T> || std::is_enum_v<T>) && (sizeof(T) == 4 || sizeof(T) == 8);
+
+// first position from first on whose element does not go before value: one not less than value, or with Upper one
+// greater than value; probes at doubling distances, then binary searches the last gap
+template<bool Upper = false, typename T>
+[[nodiscard]] auto gallop(const T* data, const std::size_t first, const std::size_t count, const T& value) noexcept->std::size_t {
+	const auto before = [&value](const T& element) { return Upper ? !(value < element) : element < value; };
+	if (first >= count || !before(data[first])) return first;
+
+	auto low = first;
+	std::size_t step = 1;
+	while (low + step < count && before(data[low + step])) {
+		low += step;
+		step *= 2;
+	}
+	const auto high = std::min(low + step, count);
+	const auto pos = Upper ? std::upper_bound(data + low + 1, data + high, value) : std::lower_bound(data + low + 1, data + high, value);
+	return static_cast<std::size_t>(pos - data);
+}
+
+// elements of a that are (Matched) or are not (!Matched) in b, the intersection and the difference
+template<bool Matched, typename T>
+auto filter_scalar(const T* a, const std::size_t na, const T* b, const std::size_t nb, T* out) noexcept->std::size_t {
+	std::size_t i = 0;
+	std::size_t j = 0;
+	std::size_t written = 0;
+	while (i < na && j < nb) {
+		const auto x = a[i];
+		const auto y = b[j];
+		out[written] = x;
+		if constexpr (Matched) written += !(x < y) && !(y < x);
+		else written += x < y;
+		i += !(y < x);
+		j += !(x < y);
+	}
+	if constexpr (!Matched) written += static_cast<std::size_t>(std::copy(a + i, a + na, out + written) - (out + written));
+	return written;
+}
+
+// walks the much smaller a, galloping through b for each of its elements
+template<bool Matched, typename T>
+auto filter_gallop(const T* a, const std::size_t na, const T* b, const std::size_t nb, T* out) noexcept->std::size_t {
+	std::size_t j = 0;
+	std::size_t written = 0;
+	for (std::size_t i = 0; i < na; ++i) {
+		j = gallop(b, j, nb, a[i]);
+		const auto found = j < nb && !(a[i] < b[j]);
+		if (found == Matched) out[written++] = a[i];
+	}
+	return written;
+}
+
+// difference with a much smaller b: copies the runs of a between the elements of b, galloping to each
+template<typename T>
+auto difference_runs(const T* a, const std::size_t na, const T* b, const std::size_t nb, T* out) noexcept->std::size_t {
+	std::size_t i = 0;
+	std::size_t written = 0;
+	for (std::size_t j = 0; j < nb && i < na; ++j) {
+		const auto pos = gallop(a, i, na, b[j]);
+		written += static_cast<std::size_t>(std::copy(a + i, a + pos, out + written) - (out + written));
+		i = pos;
+		if (i < na && !(b[j] < a[i])) ++i;
+	}
+	return written + static_cast<std::size_t>(std::copy(a + i, a + na, out + written) - (out + written));
+}
+
+#if defined(PERFVECT_SIMD_DISPATCH)
+
+// lanes of the block of a equal to any lane of the block of b, one bit per lane: the block of b is rotated through
+// every lane and compared with a whole each time
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 inline auto block_matches_avx2(const T* a, const T* b) noexcept->std::uint32_t {
+	const auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+	auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+	if constexpr (sizeof(T) == 4) {
+		const auto rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+		auto eq = _mm256_cmpeq_epi32(va, vb);
+		for (auto lane = 1; lane < 8; ++lane) {
+			vb = _mm256_permutevar8x32_epi32(vb, rotate);
+			eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+		}
+		return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+	}
+	else {
+		auto eq = _mm256_cmpeq_epi64(va, vb);
+		for (auto lane = 1; lane < 4; ++lane) {
+			vb = _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(0, 3, 2, 1));
+			eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, vb));
+		}
+		return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+	}
+}
+
+// filter_scalar a block at a time: the block of a is compared with every block of b whose range overlaps it, and is
+// written out once b has caught up with its last element; on return, matched holds the lanes of the block at i found
+// so far, all of them in b before j
+template<bool Matched, typename T>
+PERFVECT_TARGET_AVX2 auto filter_blocks_avx2(const T* a, const std::size_t na, const T* b, const std::size_t nb, T* out,
+	std::size_t& i, std::size_t& j, std::uint32_t& matched) noexcept->std::size_t
+{
+	constexpr std::size_t lanes = 32 / sizeof(T);
+	constexpr std::uint32_t all = (1u << lanes) - 1;
+	std::size_t written = 0;
+	matched = 0;
+	while (i + lanes <= na && j + lanes <= nb) {
+		matched |= block_matches_avx2(a + i, b + j);
+		const auto a_last = a[i + lanes - 1];
+		const auto b_last = b[j + lanes - 1];
+		if (!(b_last < a_last)) {
+			for (auto emit = Matched ? matched : ~matched & all; emit; emit &= emit - 1) out[written++] = a[i + countr_zero(emit)];
+			i += lanes;
+			matched = 0;
+		}
+		if (!(a_last < b_last)) j += lanes;
+	}
+	return written;
+}
+
+#endif
+
+// finishes the block of a at i left part-compared by the block kernel, whose lanes in matched were found in b before j
+template<bool Matched, typename T>
+auto finish_block(const T* a, const T* b, const std::size_t nb, T* out, std::size_t& i, std::size_t& j, const std::size_t lanes,
+	const std::uint32_t matched) noexcept->std::size_t
+{
+	std::size_t written = 0;
+	for (std::size_t lane = 0; lane < lanes; ++lane, ++i) {
+		if ((matched >> lane) & 1) {
+			if (Matched) out[written++] = a[i];
+			continue;
+		}
+		while (j < nb && b[j] < a[i]) ++j;
+		const auto found = j < nb && !(a[i] < b[j]);
+		if (found == Matched) out[written++] = a[i];
+	}
+	return written;
+}
+
+template<bool Matched, typename T>
+auto filter_sorted(const T* a, const std::size_t na, const T* b, const std::size_t nb, T* out, const simd_level level) noexcept->std::size_t {
+	const auto ratio = is_block_comparable_v<T> && level >= simd_level::avx2 ? block_gallop_ratio : gallop_ratio;
+	if constexpr (Matched) {
+		if (nb * ratio <= na) return filter_gallop<true>(b, nb, a, na, out);
+	}
+	else {
+		if (nb * ratio <= na) return difference_runs(a, na, b, nb, out);
+	}
+	if (na * ratio <= nb) return filter_gallop<Matched>(a, na, b, nb, out);
+
+	std::size_t i = 0;
+	std::size_t j = 0;
+	std::size_t written = 0;
+	#if defined(PERFVECT_SIMD_DISPATCH)
+	if constexpr (is_block_comparable_v<T>) {
+		if (level >= simd_level::avx2) {
+			std::uint32_t matched;
+			written = filter_blocks_avx2<Matched>(a, na, b, nb, out, i, j, matched);
+			if (matched) written += finish_block<Matched>(a, b, nb, out + written, i, j, 32 / sizeof(T), matched);
+		}
+	}
+	#endif
+	(void)level;
+	return written + filter_scalar<Matched>(a + i, na - i, b + j, nb - j, out + written);
+}
+
+// intersection of the sorted sets a and b
+template<typename T>
+auto intersect_sorted(const T* a, const std::size_t na, const T* b, const std::size_t nb, T* out, const simd_level level = simd_level_supported()) noexcept->std::size_t {
+	return filter_sorted<true>(a, na, b, nb, out, level);
+}
+
+// elements of the sorted set a not in the sorted set b
+template<typename T>
+auto difference_sorted(const T* a, const std::size_t na, const T* b, const std::size_t nb, T* out, const simd_level level = simd_level_supported()) noexcept->std::size_t {
+	return filter_sorted<false>(a, na, b, nb, out, level);
+}
+
+// union of the sorted sets a and b, each shared element written once
+template<typename T>
+auto union_sorted(const T* a, std::size_t na, const T* b, std::size_t nb, T* out) noexcept->std::size_t {
+	if (na * gallop_ratio <= nb) {
+		std::swap(a, b);
+		std::swap(na, nb);
+	}
+
+	std::size_t i = 0;
+	std::size_t written = 0;
+	if (nb * gallop_ratio <= na) {
+		for (std::size_t j = 0; j < nb; ++j) {
+			const auto pos = gallop(a, i, na, b[j]);
+			written += static_cast<std::size_t>(std::copy(a + i, a + pos, out + written) - (out + written));
+			i = pos;
+			if (i < na && !(b[j] < a[i])) ++i;
+			out[written++] = b[j];
+		}
+	}
+	else {
+		std::size_t j = 0;
+		while (i < na && j < nb) {
+			const auto x = a[i];
+			const auto y = b[j];
+			out[written++] = y < x ? y : x;
+			i += !(y < x);
+			j += !(x < y);
+		}
+		written += static_cast<std::size_t>(std::copy(b + j, b + nb, out + written) - (out + written));
+	}
+	return written + static_cast<std::size_t>(std::copy(a + i, a + na, out + written) - (out + written));
+}
+
+// stable merge of the ascending ranges a and b, repeats allowed: of equal elements, those from a come first
+template<typename T>
+auto merge_sorted(const T* a, const std::size_t na, const T* b, const std::size_t nb, T* out) noexcept->std::size_t {
+	std::size_t i = 0;
+	std::size_t j = 0;
+	std::size_t written = 0;
+	if (nb * gallop_ratio <= na) {
+		for (; j < nb; ++j) {
+			const auto pos = gallop<true>(a, i, na, b[j]);
+			written += static_cast<std::size_t>(std::copy(a + i, a + pos, out + written) - (out + written));
+			i = pos;
+			out[written++] = b[j];
+		}
+	}
+	else if (na * gallop_ratio <= nb) {
+		for (; i < na; ++i) {
+			const auto pos = gallop(b, j, nb, a[i]);
+			written += static_cast<std::size_t>(std::copy(b + j, b + pos, out + written) - (out + written));
+			j = pos;
+			out[written++] = a[i];
+		}
+	}
+	else {
+		while (i < na && j < nb) {
+			const auto take_b = b[j] < a[i];
+			out[written++] = take_b ? b[j] : a[i];
+			j += take_b;
+			i += !take_b;
+		}
+	}
+	written += static_cast<std::size_t>(std::copy(a + i, a + na, out + written) - (out + written));
+	return written + static_cast<std::size_t>(std::copy(b + j, b + nb, out + written) - (out + written));
+}
+
+template<typename T>
+auto check_spare_capacity(const static_vector_base<T>& out, const std::size_t needed, const char* message) {
+	if (out.capacity() - out.size() < needed) throw std::length_error(message);
+}
+
+}
+
+// sorted-set algebra: a and b hold ascending elements without repeats, except that merge_into also takes repeats, and
+// the result is appended to out, which must be a container other than a and b with spare capacity for the largest
+// result possible (std::length_error is thrown otherwise); each returns the number of elements appended
+// arithmetic and enum elements are written straight into the spare capacity by branchless kernels that gallop through
+// the larger input when one is 32 times the size of the other, with 32 and 64-bit integers intersected and
+// differenced a block of 32 bytes at a time by AVX2 where the CPU has it; other types go through the std:: algorithms
+
+// elements in both a and b; out needs spare capacity for min(a.size(), b.size())
+template<typename T>
+auto intersect_into(const static_vector_base<T>& a, const static_vector_base<T>& b, static_vector_base<T>& out)->std::size_t {
+	detail::check_spare_capacity(out, std::min(a.size(), b.size()), "not enough spare capacity for intersect_into");
+	if constexpr (detail::is_simd_searchable_v<T>) {
+		return out.append_unchecked(std::min(a.size(), b.size()), [&](T* dest) {
+			return detail::intersect_sorted(a.data(), a.size(), b.data(), b.size(), dest);
+		});
+	}
+	else {
+		const auto old_size = out.size();
+		std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+		return out.size() - old_size;
+	}
+}
+
+// elements in a or b, shared ones once; out needs spare capacity for a.size() + b.size()
+template<typename T>
+auto union_into(const static_vector_base<T>& a, const static_vector_base<T>& b, static_vector_base<T>& out)->std::size_t {
+	detail::check_spare_capacity(out, a.size() + b.size(), "not enough spare capacity for union_into");
+	if constexpr (detail::is_simd_searchable_v<T>) {
+		return out.append_unchecked(a.size() + b.size(), [&](T* dest) {
+			return detail::union_sorted(a.data(), a.size(), b.data(), b.size(), dest);
+		});
+	}
+	else {
+		const auto old_size = out.size();
+		std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+		return out.size() - old_size;
+	}
+}
+
+// elements in a but not in b; out needs spare capacity for a.size()
+template<typename T>
+auto difference_into(const static_vector_base<T>& a, const static_vector_base<T>& b, static_vector_base<T>& out)->std::size_t {
+	detail::check_spare_capacity(out, a.size(), "not enough spare capacity for difference_into");
+	if constexpr (detail::is_simd_searchable_v<T>) {
+		return out.append_unchecked(a.size(), [&](T* dest) {
+			return detail::difference_sorted(a.data(), a.size(), b.data(), b.size(), dest);
+		});
+	}
+	else {
+		const auto old_size = out.size();
+		std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+		return out.size() - old_size;
+	}
+}
+
+// every element of a and b in ascending order, keeping repeats, those of a first among equals; out needs spare
+// capacity for a.size() + b.size()
+template<typename T>
+auto merge_into(const static_vector_base<T>& a, const static_vector_base<T>& b, static_vector_base<T>& out)->std::size_t {
+	detail::check_spare_capacity(out, a.size() + b.size(), "not enough spare capacity for merge_into");
+	if constexpr (detail::is_simd_searchable_v<T>) {
+		return out.append_unchecked(a.size() + b.size(), [&](T* dest) {
+			return detail::merge_sorted(a.data(), a.size(), b.data(), b.size(), dest);
+		});
+	}
+	else {
+		const auto old_size = out.size();
+		std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+		return out.size() - old_size;
+	}
+}
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,544 @@
+#ifndef PERFVECT_SIMD_H
+#define PERFVECT_SIMD_H
+
+#include "bit.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// x86-64 always has SSE2; with GCC or Clang the AVX2 and AVX-512 kernels are compiled through per-function target
+// attributes and chosen at runtime, so the library itself needs no -m flags
+// define PERFVECT_NO_SIMD to use only the scalar kernels
+#if !defined(PERFVECT_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define PERFVECT_SIMD_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define PERFVECT_SIMD_DISPATCH 1
+#define PERFVECT_TARGET_AVX2 __attribute__((target("avx2")))
+#define PERFVECT_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#endif
+#endif
+
+namespace perfvect {
+namespace detail {
+
+enum class simd_level {
+	scalar,
+	sse2,
+	avx2,
+	avx512,
+};
+
+[[nodiscard]] inline auto detect_simd_level() noexcept->simd_level {
+	#if defined(PERFVECT_SIMD_DISPATCH)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return simd_level::avx512;
+	if (__builtin_cpu_supports("avx2")) return simd_level::avx2;
+	return simd_level::sse2;
+	#elif defined(PERFVECT_SIMD_X86)
+	return simd_level::sse2;
+	#else
+	return simd_level::scalar;
+	#endif
+}
+
+// the best instruction set available on this machine, detected once
+[[nodiscard]] inline auto simd_level_supported() noexcept->simd_level {
+	static const auto level = detect_simd_level();
+	return level;
+}
+
+// element types searched by the SIMD kernels: equality of these is either bitwise (integers, enums) or a single
+// vector compare instruction (float, double)
+template<typename T>
+inline constexpr bool is_simd_searchable_v = (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+	&& (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+	&& !std::is_same_v<T, long double>;
+
+// capacity up to which static_vector searches with a fully unrolled loop instead of the SIMD kernels
+inline constexpr std::size_t unrolled_search_limit = 16;
+
+template<std::size_t Size>
+using uint_of_size_t = std::conditional_t<Size == 1, std::uint8_t,
+	std::conditional_t<Size == 2, std::uint16_t,
+	std::conditional_t<Size == 4, std::uint32_t, std::uint64_t>>>;
+
+template<typename T>
+[[nodiscard]] inline auto bits_of(const T value) noexcept {
+	uint_of_size_t<sizeof(T)> bits;
+	std::memcpy(&bits, &value, sizeof(T));
+	return bits;
+}
+
+// mask of the lowest lanes bits
+[[nodiscard]] constexpr auto low_lanes(const std::size_t lanes) noexcept->std::uint64_t {
+	return lanes >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << lanes) - 1;
+}
+
+// scalar kernels
+
+template<typename T>
+[[nodiscard]] auto find_eq_scalar(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	for (std::size_t pos = 0; pos < count; ++pos) {
+		if (data[pos] == value) return pos;
+	}
+	return count;
+}
+
+template<typename T>
+[[nodiscard]] auto count_eq_scalar(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	std::size_t found = 0;
+	for (std::size_t pos = 0; pos < count; ++pos) found += data[pos] == value;
+	return found;
+}
+
+template<typename T>
+[[nodiscard]] auto find_eq_any_scalar(const T* data, const std::size_t count, const T* values, const std::size_t value_count) noexcept->std::size_t {
+	for (std::size_t pos = 0; pos < count; ++pos) {
+		for (std::size_t v = 0; v < value_count; ++v) {
+			if (data[pos] == values[v]) return pos;
+		}
+	}
+	return count;
+}
+
+// position of the first element of a that differs from the same position in b
+template<typename T>
+[[nodiscard]] auto mismatch_scalar(const T* a, const T* b, const std::size_t count) noexcept->std::size_t {
+	for (std::size_t pos = 0; pos < count; ++pos) {
+		if (!(a[pos] == b[pos])) return pos;
+	}
+	return count;
+}
+
+// writes the elements of src whose bit is set in keep to dst, in order and without branches, returning how many
+// were kept; dst may overlap src provided it does not start after it
+template<typename T>
+auto compress_block_scalar(T* dst, const T* src, const std::size_t count, const std::uint64_t keep) noexcept->std::size_t {
+	std::size_t write = 0;
+	for (std::size_t pos = 0; pos < count; ++pos) {
+		dst[write] = src[pos];
+		write += (keep >> pos) & 1;
+	}
+	return write;
+}
+
+// unrolled kernels, for a compile-time bound N on count: every position is tested without a loop-carried branch and
+// the matches gathered into a bitmask
+
+template<std::size_t N, typename T, std::size_t... Idx>
+[[nodiscard]] inline auto eq_mask_unrolled(const T* data, const std::size_t count, const T value, std::index_sequence<Idx...>) noexcept {
+	static_assert(N <= 64, "unrolled search is limited to 64 elements");
+	std::uint64_t mask = 0;
+	((mask |= static_cast<std::uint64_t>(Idx < count && data[Idx] == value) << Idx), ...);
+	return mask;
+}
+
+template<std::size_t N, typename T>
+[[nodiscard]] inline auto find_eq_unrolled(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	const auto mask = eq_mask_unrolled<N>(data, count, value, std::make_index_sequence<N>());
+	return mask ? countr_zero(mask) : count;
+}
+
+template<std::size_t N, typename T>
+[[nodiscard]] inline auto count_eq_unrolled(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	return popcount(eq_mask_unrolled<N>(data, count, value, std::make_index_sequence<N>()));
+}
+
+#if defined(PERFVECT_SIMD_X86)
+
+// SSE2 kernels: 16 bytes per step, masks have one bit per byte
+
+template<typename T>
+[[nodiscard]] inline auto splat_sse2(const T value) noexcept {
+	if constexpr (std::is_same_v<T, float>) return _mm_set1_ps(value);
+	else if constexpr (std::is_same_v<T, double>) return _mm_set1_pd(value);
+	else if constexpr (sizeof(T) == 1) return _mm_set1_epi8(static_cast<char>(bits_of(value)));
+	else if constexpr (sizeof(T) == 2) return _mm_set1_epi16(static_cast<short>(bits_of(value)));
+	else if constexpr (sizeof(T) == 4) return _mm_set1_epi32(static_cast<int>(bits_of(value)));
+	else return _mm_set1_epi64x(static_cast<long long>(bits_of(value)));
+}
+
+template<typename T, typename Vec>
+[[nodiscard]] inline auto eq_mask_sse2(const T* ptr, const Vec needle) noexcept->std::uint32_t {
+	if constexpr (std::is_same_v<T, float>) {
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(ptr), needle))));
+	}
+	else if constexpr (std::is_same_v<T, double>) {
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(ptr), needle))));
+	}
+	else {
+		const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		__m128i eq;
+		if constexpr (sizeof(T) == 1) eq = _mm_cmpeq_epi8(block, needle);
+		else if constexpr (sizeof(T) == 2) eq = _mm_cmpeq_epi16(block, needle);
+		else if constexpr (sizeof(T) == 4) eq = _mm_cmpeq_epi32(block, needle);
+		else {
+			// no 64-bit compare before SSE4.1: both 32-bit halves must match
+			eq = _mm_cmpeq_epi32(block, needle);
+			eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+		}
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(eq));
+	}
+}
+
+template<typename T>
+[[nodiscard]] auto find_eq_sse2(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	constexpr auto lanes = 16 / sizeof(T);
+	const auto needle = splat_sse2(value);
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		if (const auto mask = eq_mask_sse2(data + pos, needle)) return pos + countr_zero(mask) / sizeof(T);
+	}
+	return pos + find_eq_scalar(data + pos, count - pos, value);
+}
+
+template<typename T>
+[[nodiscard]] auto count_eq_sse2(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	constexpr auto lanes = 16 / sizeof(T);
+	const auto needle = splat_sse2(value);
+	std::size_t found = 0;
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) found += popcount(eq_mask_sse2(data + pos, needle));
+	return found / sizeof(T) + count_eq_scalar(data + pos, count - pos, value);
+}
+
+template<typename T>
+[[nodiscard]] auto find_eq_any_sse2(const T* data, const std::size_t count, const T* values, const std::size_t value_count) noexcept->std::size_t {
+	constexpr auto lanes = 16 / sizeof(T);
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		std::uint32_t mask = 0;
+		for (std::size_t v = 0; v < value_count; ++v) mask |= eq_mask_sse2(data + pos, splat_sse2(values[v]));
+		if (mask) return pos + countr_zero(mask) / sizeof(T);
+	}
+	return pos + find_eq_any_scalar(data + pos, count - pos, values, value_count);
+}
+
+template<typename T>
+[[nodiscard]] inline auto load_sse2(const T* ptr) noexcept {
+	if constexpr (std::is_same_v<T, float>) return _mm_loadu_ps(ptr);
+	else if constexpr (std::is_same_v<T, double>) return _mm_loadu_pd(ptr);
+	else return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+}
+
+template<typename T>
+[[nodiscard]] auto mismatch_sse2(const T* a, const T* b, const std::size_t count) noexcept->std::size_t {
+	constexpr auto lanes = 16 / sizeof(T);
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		const auto diff = ~eq_mask_sse2(a + pos, load_sse2(b + pos)) & 0xFFFFu;
+		if (diff) return pos + countr_zero(diff) / sizeof(T);
+	}
+	return pos + mismatch_scalar(a + pos, b + pos, count - pos);
+}
+
+#endif
+
+#if defined(PERFVECT_SIMD_DISPATCH)
+
+// AVX2 kernels: 32 bytes per step, masks have one bit per byte
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 inline auto splat_avx2(const T value) noexcept {
+	if constexpr (std::is_same_v<T, float>) return _mm256_set1_ps(value);
+	else if constexpr (std::is_same_v<T, double>) return _mm256_set1_pd(value);
+	else if constexpr (sizeof(T) == 1) return _mm256_set1_epi8(static_cast<char>(bits_of(value)));
+	else if constexpr (sizeof(T) == 2) return _mm256_set1_epi16(static_cast<short>(bits_of(value)));
+	else if constexpr (sizeof(T) == 4) return _mm256_set1_epi32(static_cast<int>(bits_of(value)));
+	else return _mm256_set1_epi64x(static_cast<long long>(bits_of(value)));
+}
+
+template<typename T, typename Vec>
+[[nodiscard]] PERFVECT_TARGET_AVX2 inline auto eq_mask_avx2(const T* ptr, const Vec needle) noexcept->std::uint32_t {
+	if constexpr (std::is_same_v<T, float>) {
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(ptr), needle, _CMP_EQ_OQ))));
+	}
+	else if constexpr (std::is_same_v<T, double>) {
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(ptr), needle, _CMP_EQ_OQ))));
+	}
+	else {
+		const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+		__m256i eq;
+		if constexpr (sizeof(T) == 1) eq = _mm256_cmpeq_epi8(block, needle);
+		else if constexpr (sizeof(T) == 2) eq = _mm256_cmpeq_epi16(block, needle);
+		else if constexpr (sizeof(T) == 4) eq = _mm256_cmpeq_epi32(block, needle);
+		else eq = _mm256_cmpeq_epi64(block, needle);
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+	}
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 auto find_eq_avx2(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	constexpr auto lanes = 32 / sizeof(T);
+	const auto needle = splat_avx2(value);
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		if (const auto mask = eq_mask_avx2(data + pos, needle)) return pos + countr_zero(mask) / sizeof(T);
+	}
+	return pos + find_eq_scalar(data + pos, count - pos, value);
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 auto count_eq_avx2(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	constexpr auto lanes = 32 / sizeof(T);
+	const auto needle = splat_avx2(value);
+	std::size_t found = 0;
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) found += popcount(eq_mask_avx2(data + pos, needle));
+	return found / sizeof(T) + count_eq_scalar(data + pos, count - pos, value);
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 auto find_eq_any_avx2(const T* data, const std::size_t count, const T* values, const std::size_t value_count) noexcept->std::size_t {
+	constexpr auto lanes = 32 / sizeof(T);
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		std::uint32_t mask = 0;
+		for (std::size_t v = 0; v < value_count; ++v) mask |= eq_mask_avx2(data + pos, splat_avx2(values[v]));
+		if (mask) return pos + countr_zero(mask) / sizeof(T);
+	}
+	return pos + find_eq_any_scalar(data + pos, count - pos, values, value_count);
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 inline auto load_avx2(const T* ptr) noexcept {
+	if constexpr (std::is_same_v<T, float>) return _mm256_loadu_ps(ptr);
+	else if constexpr (std::is_same_v<T, double>) return _mm256_loadu_pd(ptr);
+	else return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX2 auto mismatch_avx2(const T* a, const T* b, const std::size_t count) noexcept->std::size_t {
+	constexpr auto lanes = 32 / sizeof(T);
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		const auto diff = ~eq_mask_avx2(a + pos, load_avx2(b + pos));
+		if (diff) return pos + countr_zero(diff) / sizeof(T);
+	}
+	return pos + mismatch_scalar(a + pos, b + pos, count - pos);
+}
+
+// AVX-512 kernels: 64 bytes per step, masks have one bit per element; the tail is handled with a masked load rather
+// than a scalar loop, which cannot fault on the lanes outside the mask
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX512 inline auto splat_avx512(const T value) noexcept {
+	if constexpr (std::is_same_v<T, float>) return _mm512_set1_ps(value);
+	else if constexpr (std::is_same_v<T, double>) return _mm512_set1_pd(value);
+	else if constexpr (sizeof(T) == 1) return _mm512_set1_epi8(static_cast<char>(bits_of(value)));
+	else if constexpr (sizeof(T) == 2) return _mm512_set1_epi16(static_cast<short>(bits_of(value)));
+	else if constexpr (sizeof(T) == 4) return _mm512_set1_epi32(static_cast<int>(bits_of(value)));
+	else return _mm512_set1_epi64(static_cast<long long>(bits_of(value)));
+}
+
+// compares the lanes selected by load (all of them for a full block) against needle
+template<typename T, typename Vec>
+[[nodiscard]] PERFVECT_TARGET_AVX512 inline auto eq_mask_avx512(const T* ptr, const Vec needle, const std::uint64_t load) noexcept->std::uint64_t {
+	if constexpr (std::is_same_v<T, float>) {
+		const auto block = _mm512_maskz_loadu_ps(static_cast<__mmask16>(load), ptr);
+		return _mm512_mask_cmp_ps_mask(static_cast<__mmask16>(load), block, needle, _CMP_EQ_OQ);
+	}
+	else if constexpr (std::is_same_v<T, double>) {
+		const auto block = _mm512_maskz_loadu_pd(static_cast<__mmask8>(load), ptr);
+		return _mm512_mask_cmp_pd_mask(static_cast<__mmask8>(load), block, needle, _CMP_EQ_OQ);
+	}
+	else if constexpr (sizeof(T) == 1) {
+		return _mm512_mask_cmpeq_epi8_mask(load, _mm512_maskz_loadu_epi8(load, ptr), needle);
+	}
+	else if constexpr (sizeof(T) == 2) {
+		const auto lanes = static_cast<__mmask32>(load);
+		return _mm512_mask_cmpeq_epi16_mask(lanes, _mm512_maskz_loadu_epi16(lanes, ptr), needle);
+	}
+	else if constexpr (sizeof(T) == 4) {
+		const auto lanes = static_cast<__mmask16>(load);
+		return _mm512_mask_cmpeq_epi32_mask(lanes, _mm512_maskz_loadu_epi32(lanes, ptr), needle);
+	}
+	else {
+		const auto lanes = static_cast<__mmask8>(load);
+		return _mm512_mask_cmpeq_epi64_mask(lanes, _mm512_maskz_loadu_epi64(lanes, ptr), needle);
+	}
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX512 auto find_eq_avx512(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	constexpr auto lanes = 64 / sizeof(T);
+	const auto needle = splat_avx512(value);
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		if (const auto mask = eq_mask_avx512(data + pos, needle, ~std::uint64_t{0})) return pos + countr_zero(mask);
+	}
+	if (pos == count) return count;
+	const auto mask = eq_mask_avx512(data + pos, needle, low_lanes(count - pos));
+	return mask ? pos + countr_zero(mask) : count;
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX512 auto count_eq_avx512(const T* data, const std::size_t count, const T value) noexcept->std::size_t {
+	constexpr auto lanes = 64 / sizeof(T);
+	const auto needle = splat_avx512(value);
+	std::size_t found = 0;
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) found += popcount(eq_mask_avx512(data + pos, needle, ~std::uint64_t{0}));
+	if (pos == count) return found;
+	return found + popcount(eq_mask_avx512(data + pos, needle, low_lanes(count - pos)));
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX512 auto find_eq_any_avx512(const T* data, const std::size_t count, const T* values, const std::size_t value_count) noexcept->std::size_t {
+	constexpr auto lanes = 64 / sizeof(T);
+	for (std::size_t pos = 0; pos < count; pos += lanes) {
+		const auto load = low_lanes(count - pos < lanes ? count - pos : lanes);
+		std::uint64_t mask = 0;
+		for (std::size_t v = 0; v < value_count; ++v) mask |= eq_mask_avx512(data + pos, splat_avx512(values[v]), load);
+		if (mask) return pos + countr_zero(mask);
+	}
+	return count;
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX512 inline auto load_avx512(const T* ptr, const std::uint64_t load) noexcept {
+	if constexpr (std::is_same_v<T, float>) return _mm512_maskz_loadu_ps(static_cast<__mmask16>(load), ptr);
+	else if constexpr (std::is_same_v<T, double>) return _mm512_maskz_loadu_pd(static_cast<__mmask8>(load), ptr);
+	else if constexpr (sizeof(T) == 1) return _mm512_maskz_loadu_epi8(load, ptr);
+	else if constexpr (sizeof(T) == 2) return _mm512_maskz_loadu_epi16(static_cast<__mmask32>(load), ptr);
+	else if constexpr (sizeof(T) == 4) return _mm512_maskz_loadu_epi32(static_cast<__mmask16>(load), ptr);
+	else return _mm512_maskz_loadu_epi64(static_cast<__mmask8>(load), ptr);
+}
+
+// compress_block_scalar for 32 and 64-bit elements, with a compress and a full-width store per 64 bytes; the store
+// may write past the kept elements, but never beyond the end of the source block it came from
+template<typename T>
+PERFVECT_TARGET_AVX512 auto compress_block_avx512(T* dst, const T* src, const std::size_t count, const std::uint64_t keep) noexcept->std::size_t {
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8, "compress_block_avx512 needs 32 or 64-bit elements");
+	constexpr auto lanes = 64 / sizeof(T);
+	std::size_t write = 0;
+	std::size_t pos = 0;
+	for (; pos + lanes <= count; pos += lanes) {
+		const auto lane_keep = (keep >> pos) & low_lanes(lanes);
+		const auto block = _mm512_loadu_si512(src + pos);
+		if constexpr (sizeof(T) == 4) _mm512_storeu_si512(dst + write, _mm512_maskz_compress_epi32(static_cast<__mmask16>(lane_keep), block));
+		else _mm512_storeu_si512(dst + write, _mm512_maskz_compress_epi64(static_cast<__mmask8>(lane_keep), block));
+		write += popcount(lane_keep);
+	}
+	// a full block of 64 leaves no tail, and keep >> 64 would be undefined
+	if (pos == count) return write;
+	return write + compress_block_scalar(dst + write, src + pos, count - pos, keep >> pos);
+}
+
+template<typename T>
+[[nodiscard]] PERFVECT_TARGET_AVX512 auto mismatch_avx512(const T* a, const T* b, const std::size_t count) noexcept->std::size_t {
+	constexpr auto lanes = 64 / sizeof(T);
+	for (std::size_t pos = 0; pos < count; pos += lanes) {
+		const auto load = low_lanes(count - pos < lanes ? count - pos : lanes);
+		const auto diff = ~eq_mask_avx512(a + pos, load_avx512(b + pos, load), load) & load;
+		if (diff) return pos + countr_zero(diff);
+	}
+	return count;
+}
+
+#endif
+
+// below one full 64-byte block the masked AVX-512 tail costs more than the AVX2 kernel's scalar one
+[[nodiscard]] inline auto level_for(const simd_level level, const std::size_t bytes) noexcept {
+	return level == simd_level::avx512 && bytes < 64 ? simd_level::avx2 : level;
+}
+
+// dispatching entry points, taking the instruction set to use (which must be supported) for the sake of testing
+
+template<typename T>
+[[nodiscard]] auto find_eq(const T* data, const std::size_t count, const T value, const simd_level level = simd_level_supported()) noexcept->std::size_t {
+	switch (level_for(level, count * sizeof(T))) {
+		#if defined(PERFVECT_SIMD_DISPATCH)
+		case simd_level::avx512: return find_eq_avx512(data, count, value);
+		case simd_level::avx2: return find_eq_avx2(data, count, value);
+		#endif
+		#if defined(PERFVECT_SIMD_X86)
+		case simd_level::sse2: return find_eq_sse2(data, count, value);
+		#endif
+		default: return find_eq_scalar(data, count, value);
+	}
+}
+
+template<typename T>
+[[nodiscard]] auto count_eq(const T* data, const std::size_t count, const T value, const simd_level level = simd_level_supported()) noexcept->std::size_t {
+	switch (level_for(level, count * sizeof(T))) {
+		#if defined(PERFVECT_SIMD_DISPATCH)
+		case simd_level::avx512: return count_eq_avx512(data, count, value);
+		case simd_level::avx2: return count_eq_avx2(data, count, value);
+		#endif
+		#if defined(PERFVECT_SIMD_X86)
+		case simd_level::sse2: return count_eq_sse2(data, count, value);
+		#endif
+		default: return count_eq_scalar(data, count, value);
+	}
+}
+
+template<typename T>
+[[nodiscard]] auto find_eq_any(const T* data, const std::size_t count, const T* values, const std::size_t value_count, const simd_level level = simd_level_supported()) noexcept->std::size_t {
+	switch (level_for(level, count * sizeof(T))) {
+		#if defined(PERFVECT_SIMD_DISPATCH)
+		case simd_level::avx512: return find_eq_any_avx512(data, count, values, value_count);
+		case simd_level::avx2: return find_eq_any_avx2(data, count, values, value_count);
+		#endif
+		#if defined(PERFVECT_SIMD_X86)
+		case simd_level::sse2: return find_eq_any_sse2(data, count, values, value_count);
+		#endif
+		default: return find_eq_any_scalar(data, count, values, value_count);
+	}
+}
+
+
+template<typename T>
+[[nodiscard]] auto mismatch(const T* a, const T* b, const std::size_t count, const simd_level level = simd_level_supported()) noexcept->std::size_t {
+	switch (level_for(level, count * sizeof(T))) {
+		#if defined(PERFVECT_SIMD_DISPATCH)
+		case simd_level::avx512: return mismatch_avx512(a, b, count);
+		case simd_level::avx2: return mismatch_avx2(a, b, count);
+		#endif
+		#if defined(PERFVECT_SIMD_X86)
+		case simd_level::sse2: return mismatch_sse2(a, b, count);
+		#endif
+		default: return mismatch_scalar(a, b, count);
+	}
+}
+
+
+// stream compaction of trivially copyable elements: keeps, in order, those for which pred is false and returns how
+// many were kept; pred is evaluated once per element into a bitmask for each block of 64, which leaves its loop free
+// of branches, and the survivors are then packed down, with AVX-512 compress stores where available
+// a leading run with nothing removed is not rewritten
+template<typename T, typename Pred>
+[[nodiscard]] auto compact_if(T* data, const std::size_t count, Pred& pred, const simd_level level = simd_level_supported())->std::size_t {
+	std::size_t write = 0;
+	for (std::size_t base = 0; base < count; base += 64) {
+		const auto block = count - base < 64 ? count - base : 64;
+		std::uint64_t keep = 0;
+		for (std::size_t pos = 0; pos < block; ++pos) {
+			keep |= static_cast<std::uint64_t>(!pred(static_cast<const T&>(data[base + pos]))) << pos;
+		}
+
+		if (write == base && keep == low_lanes(block)) {
+			write += block;
+			continue;
+		}
+		#if defined(PERFVECT_SIMD_DISPATCH)
+		if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+			if (level == simd_level::avx512) {
+				write += compress_block_avx512(data + write, data + base, block, keep);
+				continue;
+			}
+		}
+		#endif
+		write += compress_block_scalar(data + write, data + base, block, keep);
+	}
+	(void)level;
+	return write;
+}
+
+}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,269 @@
+#ifndef PERFVECT_SLOT_MAP_H
+#define PERFVECT_SLOT_MAP_H
+
+#include "small_vector.h"
+#include "vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace perfvect {
+
+// stable reference to an element of a slot_map, invalidated only by erasing that element
+// a default constructed handle never refers to an element
+struct slot_handle {
+	std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+	std::uint32_t generation = 0;
+
+	[[nodiscard]] constexpr auto operator==(const slot_handle& other) const noexcept {
+		return index == other.index && generation == other.generation;
+	}
+
+	[[nodiscard]] constexpr auto operator!=(const slot_handle& other) const noexcept {
+		return !(*this == other);
+	}
+};
+
+namespace detail {
+	struct slot_entry {
+		// dense index while occupied, next free slot while free
+		std::uint32_t target;
+		// odd while occupied, incremented on every insert and erase
+		std::uint32_t generation;
+	};
+
+	struct dynamic_slot_storage {
+		template<typename T>
+		using type = vector<T>;
+	};
+
+	template<std::size_t StaticCapacity>
+	struct small_slot_storage {
+		template<typename T>
+		using type = small_vector<T, StaticCapacity>;
+	};
+}
+
+// values are kept densely packed for iteration, with a sparse array of generation-counted slots translating handles
+// to dense positions; insert, erase and lookup are O(1) and erase moves the last value into the hole
+template<typename T, typename Storage = detail::dynamic_slot_storage>
+class basic_slot_map {
+	template<typename U>
+	using storage_t = typename Storage::template type<U>;
+	using values_t = storage_t<T>;
+
+	static constexpr std::uint32_t no_slot = std::numeric_limits<std::uint32_t>::max();
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+	using iterator = typename values_t::iterator;
+	using const_iterator = typename values_t::const_iterator;
+	using handle_type = slot_handle;
+
+public:
+	// element access
+
+	[[nodiscard]] auto at(const handle_type handle)->reference {
+		const auto ptr = get(handle);
+		if (!ptr) throw std::out_of_range("invalid slot_map<T> handle");
+		return *ptr;
+	}
+
+	[[nodiscard]] auto at(const handle_type handle) const->const_reference {
+		const auto ptr = get(handle);
+		if (!ptr) throw std::out_of_range("invalid slot_map<T> handle");
+		return *ptr;
+	}
+
+	// handle must be valid
+	[[nodiscard]] auto operator[](const handle_type handle) noexcept->reference {
+		return m_values[m_slots[handle.index].target];
+	}
+
+	[[nodiscard]] auto operator[](const handle_type handle) const noexcept->const_reference {
+		return m_values[m_slots[handle.index].target];
+	}
+
+	// pointer to the element referred to by handle, or nullptr if it has been erased
+	[[nodiscard]] auto get(const handle_type handle) noexcept->pointer {
+		return contains(handle) ? m_values.data() + m_slots[handle.index].target : nullptr;
+	}
+
+	[[nodiscard]] auto get(const handle_type handle) const noexcept->const_pointer {
+		return contains(handle) ? m_values.data() + m_slots[handle.index].target : nullptr;
+	}
+
+	[[nodiscard]] auto contains(const handle_type handle) const noexcept->bool {
+		return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+	}
+
+	// handle of the element at a position in dense order
+	[[nodiscard]] auto handle_at(const size_type pos) const noexcept->handle_type {
+		const auto slot = m_dense_slots[pos];
+		return {slot, m_slots[slot].generation};
+	}
+
+	[[nodiscard]] auto data() noexcept->pointer {
+		return m_values.data();
+	}
+
+	[[nodiscard]] auto data() const noexcept->const_pointer {
+		return m_values.data();
+	}
+
+	// iterators, over the values in dense order
+
+	[[nodiscard]] auto begin() noexcept {
+		return m_values.begin();
+	}
+
+	[[nodiscard]] auto begin() const noexcept {
+		return m_values.begin();
+	}
+
+	[[nodiscard]] auto end() noexcept {
+		return m_values.end();
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return m_values.end();
+	}
+
+	[[nodiscard]] auto cbegin() const noexcept {
+		return begin();
+	}
+
+	[[nodiscard]] auto cend() const noexcept {
+		return end();
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_values.size();
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_values.empty();
+	}
+
+	[[nodiscard]] auto capacity() const noexcept->size_type {
+		return m_values.capacity();
+	}
+
+	auto reserve(const size_type new_cap) {
+		m_values.reserve(new_cap);
+		m_dense_slots.reserve(new_cap);
+		m_slots.reserve(new_cap);
+	}
+
+	// modifiers
+
+	template<typename... Args>
+	auto emplace(Args&&... args)->handle_type {
+		const auto slot = acquire_slot();
+		auto& entry = m_slots[slot];
+
+		try {
+			m_values.emplace_back(std::forward<Args>(args)...);
+			m_dense_slots.push_back(slot);
+		}
+		catch (...) {
+			if (m_values.size() > m_dense_slots.size()) m_values.pop_back();
+			release_slot(slot);
+			throw;
+		}
+
+		entry.target = static_cast<std::uint32_t>(m_values.size() - 1);
+		++entry.generation;
+		return {slot, entry.generation};
+	}
+
+	auto insert(const value_type& value)->handle_type {
+		return emplace(value);
+	}
+
+	auto insert(value_type&& value)->handle_type {
+		return emplace(std::move(value));
+	}
+
+	// erases the element referred to by handle if it still exists, moving the last value into its place
+	auto erase(const handle_type handle)->bool {
+		if (!contains(handle)) return false;
+
+		const auto pos = m_slots[handle.index].target;
+		const auto last = static_cast<std::uint32_t>(m_values.size() - 1);
+
+		if (pos != last) {
+			m_values[pos] = std::move(m_values[last]);
+			m_dense_slots[pos] = m_dense_slots[last];
+			m_slots[m_dense_slots[pos]].target = pos;
+		}
+
+		m_values.pop_back();
+		m_dense_slots.pop_back();
+		++m_slots[handle.index].generation;
+		release_slot(handle.index);
+		return true;
+	}
+
+	// invalidates every handle
+	auto clear() {
+		for (const auto slot : m_dense_slots) {
+			++m_slots[slot].generation;
+			release_slot(slot);
+		}
+		m_values.clear();
+		m_dense_slots.clear();
+	}
+
+	auto swap(basic_slot_map& other) {
+		m_values.swap(other.m_values);
+		m_dense_slots.swap(other.m_dense_slots);
+		m_slots.swap(other.m_slots);
+		std::swap(m_free_head, other.m_free_head);
+	}
+
+private:
+	auto acquire_slot()->std::uint32_t {
+		if (m_free_head != no_slot) {
+			const auto slot = m_free_head;
+			m_free_head = m_slots[slot].target;
+			return slot;
+		}
+
+		if (m_slots.size() >= no_slot) throw std::length_error("slot_map<T> too long");
+		m_slots.push_back(detail::slot_entry{no_slot, 0});
+		return static_cast<std::uint32_t>(m_slots.size() - 1);
+	}
+
+	auto release_slot(const std::uint32_t slot) noexcept {
+		m_slots[slot].target = m_free_head;
+		m_free_head = slot;
+	}
+
+private:
+	values_t m_values;
+	storage_t<std::uint32_t> m_dense_slots;
+	storage_t<detail::slot_entry> m_slots;
+	std::uint32_t m_free_head = no_slot;
+};
+
+template<typename T>
+using slot_map = basic_slot_map<T, detail::dynamic_slot_storage>;
+
+// slot_map keeping up to StaticCapacity values and slots inline
+template<typename T, std::size_t StaticCapacity = 16>
+using small_slot_map = basic_slot_map<T, detail::small_slot_storage<StaticCapacity>>;
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,274 @@
+#ifndef PERFVECT_SMALL_MAP_H
+#define PERFVECT_SMALL_MAP_H
+
+#include "hash.h"
+#include "small_vector.h"
+#include "vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace perfvect {
+
+// associative container keeping its entries densely in insertion order, in small_vector storage holding up to
+// StaticCapacity entries inline
+// lookups scan the entries linearly until the map first grows past StaticCapacity, after which an open-addressing
+// index of entry positions is built over the same storage and used from then on; entries are never reordered
+// keys must not be modified through iterators
+template<
+	typename Key,
+	typename T,
+	std::size_t StaticCapacity = 8,
+	typename Hash = std::hash<Key>,
+	typename KeyEqual = std::equal_to<Key>
+>
+class small_map {
+	using storage_t = small_vector<std::pair<Key, T>, StaticCapacity>;
+
+	static constexpr std::size_t min_index_size = 16;
+
+public:
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<Key, T>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using iterator = typename storage_t::iterator;
+	using const_iterator = typename storage_t::const_iterator;
+
+public:
+	// constructors
+
+	small_map() = default;
+
+	small_map(std::initializer_list<value_type> init) {
+		for (const auto& entry : init) insert(entry);
+	}
+
+	// element access
+
+	[[nodiscard]] auto at(const key_type& key)->mapped_type& {
+		const auto pos = find_position(key);
+		if (pos == npos) throw std::out_of_range("invalid small_map<K, V> key");
+		return m_entries[pos].second;
+	}
+
+	[[nodiscard]] auto at(const key_type& key) const->const mapped_type& {
+		const auto pos = find_position(key);
+		if (pos == npos) throw std::out_of_range("invalid small_map<K, V> key");
+		return m_entries[pos].second;
+	}
+
+	auto operator[](const key_type& key)->mapped_type& {
+		return try_emplace(key).first->second;
+	}
+
+	auto operator[](key_type&& key)->mapped_type& {
+		return try_emplace(std::move(key)).first->second;
+	}
+
+	// iterators, in insertion order
+
+	[[nodiscard]] auto begin() noexcept {
+		return m_entries.begin();
+	}
+
+	[[nodiscard]] auto begin() const noexcept {
+		return m_entries.begin();
+	}
+
+	[[nodiscard]] auto end() noexcept {
+		return m_entries.end();
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return m_entries.end();
+	}
+
+	[[nodiscard]] auto cbegin() const noexcept {
+		return begin();
+	}
+
+	[[nodiscard]] auto cend() const noexcept {
+		return end();
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_entries.size();
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_entries.empty();
+	}
+
+	// true once lookups go through the hash index rather than a linear scan
+	[[nodiscard]] auto is_indexed() const noexcept->bool {
+		return !m_index.empty();
+	}
+
+	auto reserve(const size_type count) {
+		m_entries.reserve(count);
+		if (count > StaticCapacity && index_size_for(count) > m_index.size()) rebuild_index(index_size_for(count));
+	}
+
+	// lookup
+
+	[[nodiscard]] auto find(const key_type& key) noexcept {
+		const auto pos = find_position(key);
+		return pos == npos ? end() : begin() + static_cast<difference_type>(pos);
+	}
+
+	[[nodiscard]] auto find(const key_type& key) const noexcept {
+		const auto pos = find_position(key);
+		return pos == npos ? end() : begin() + static_cast<difference_type>(pos);
+	}
+
+	[[nodiscard]] auto contains(const key_type& key) const noexcept->bool {
+		return find_position(key) != npos;
+	}
+
+	[[nodiscard]] auto count(const key_type& key) const noexcept->size_type {
+		return contains(key) ? 1 : 0;
+	}
+
+	// modifiers
+
+	template<typename K, typename... Args>
+	auto try_emplace(K&& key, Args&&... args)->std::pair<iterator, bool> {
+		const auto hash = is_indexed() ? m_hash(key) : 0;
+		const auto pos = is_indexed() ? find_indexed(key, hash) : find_linear(key);
+		if (pos != npos) return {begin() + static_cast<difference_type>(pos), false};
+
+		m_entries.emplace_back(
+			std::piecewise_construct,
+			std::forward_as_tuple(std::forward<K>(key)),
+			std::forward_as_tuple(std::forward<Args>(args)...)
+		);
+		on_append(hash);
+		return {begin() + static_cast<difference_type>(size() - 1), true};
+	}
+
+	auto insert(const value_type& value)->std::pair<iterator, bool> {
+		return try_emplace(value.first, value.second);
+	}
+
+	auto insert(value_type&& value)->std::pair<iterator, bool> {
+		return try_emplace(std::move(value.first), std::move(value.second));
+	}
+
+	template<typename K, typename M>
+	auto insert_or_assign(K&& key, M&& value)->std::pair<iterator, bool> {
+		auto result = try_emplace(std::forward<K>(key), std::forward<M>(value));
+		if (!result.second) result.first->second = std::forward<M>(value);
+		return result;
+	}
+
+	// O(n): later entries shift down to keep insertion order, and the index is rebuilt
+	auto erase(const_iterator pos)->iterator {
+		const auto idx = static_cast<size_type>(pos - cbegin());
+		m_entries.erase(pos);
+		if (is_indexed()) rebuild_index(m_index.size());
+		return begin() + static_cast<difference_type>(idx);
+	}
+
+	auto erase(const key_type& key)->size_type {
+		const auto pos = find_position(key);
+		if (pos == npos) return 0;
+		erase(cbegin() + static_cast<difference_type>(pos));
+		return 1;
+	}
+
+	// also drops the index, returning the map to linear lookups
+	auto clear() {
+		m_entries.clear();
+		m_index.clear();
+	}
+
+	auto swap(small_map& other) {
+		m_entries.swap(other.m_entries);
+		m_index.swap(other.m_index);
+		std::swap(m_hash, other.m_hash);
+		std::swap(m_equal, other.m_equal);
+	}
+
+private:
+	static constexpr auto npos = ~size_type{0};
+
+	[[nodiscard]] static auto fragment_of(const size_type hash) noexcept {
+		return static_cast<std::uint32_t>(static_cast<std::uint64_t>(hash) >> 32);
+	}
+
+	// power of two keeping the load factor at or below a half
+	[[nodiscard]] static auto index_size_for(const size_type count) noexcept {
+		auto slots = min_index_size;
+		while (slots < count * 2) slots *= 2;
+		return slots;
+	}
+
+	[[nodiscard]] auto find_position(const key_type& key) const noexcept->size_type {
+		return is_indexed() ? find_indexed(key, m_hash(key)) : find_linear(key);
+	}
+
+	template<typename K>
+	[[nodiscard]] auto find_linear(const K& key) const noexcept->size_type {
+		for (size_type pos = 0; pos < m_entries.size(); ++pos) {
+			if (m_equal(m_entries[pos].first, key)) return pos;
+		}
+		return npos;
+	}
+
+	template<typename K>
+	[[nodiscard]] auto find_indexed(const K& key, const size_type hash) const noexcept->size_type {
+		const auto mask = m_index.size() - 1;
+		const auto fragment = fragment_of(hash);
+		for (auto slot = hash & mask;; slot = (slot + 1) & mask) {
+			const auto& entry = m_index[slot];
+			if (!entry.entry) return npos;
+			if (entry.fragment == fragment && m_equal(m_entries[entry.entry - 1].first, key)) return entry.entry - 1;
+		}
+	}
+
+	auto insert_slot(const size_type hash, const size_type pos) noexcept {
+		const auto mask = m_index.size() - 1;
+		auto slot = hash & mask;
+		while (m_index[slot].entry) slot = (slot + 1) & mask;
+		m_index[slot] = detail::map_slot{static_cast<std::uint32_t>(pos + 1), fragment_of(hash)};
+	}
+
+	// indexes the entry just appended, promoting the map to indexed lookups once it outgrows StaticCapacity
+	auto on_append(const size_type hash) {
+		if (is_indexed()) {
+			if (size() * 2 > m_index.size()) rebuild_index(m_index.size() * 2);
+			else insert_slot(hash, size() - 1);
+		}
+		else if (size() > StaticCapacity) {
+			rebuild_index(index_size_for(size()));
+		}
+	}
+
+	auto rebuild_index(const size_type slots) {
+		m_index.clear();
+		m_index.resize(slots);
+		for (size_type pos = 0; pos < m_entries.size(); ++pos) insert_slot(m_hash(m_entries[pos].first), pos);
+	}
+
+private:
+	storage_t m_entries;
+	vector<detail::map_slot> m_index;
+	Hash m_hash;
+	KeyEqual m_equal;
+};
+
+}
+
+#endif
\ No newline at end of file
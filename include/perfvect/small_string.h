@@ -0,0 +1,399 @@
+#ifndef PERFVECT_SMALL_STRING_H
+#define PERFVECT_SMALL_STRING_H
+
+#include "small_vector.h"
+#include "static_vector.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace perfvect {
+
+template<typename CharT, typename Chars>
+class basic_small_string;
+
+namespace detail {
+	template<typename T>
+	struct is_small_string : std::false_type {};
+
+	template<typename CharT, typename Chars>
+	struct is_small_string<basic_small_string<CharT, Chars>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_small_string_v = is_small_string<T>::value;
+}
+
+// null-terminated character string using Chars (a static_vector or small_vector of CharT) as storage
+// the terminator is kept as the last element of Chars, so Chars needs room for one more than the string length
+// searching and comparison go through std::char_traits, which map onto the vectorized memchr/memcmp for char
+template<typename CharT, typename Chars>
+class basic_small_string {
+public:
+	using traits_type = std::char_traits<CharT>;
+	using value_type = CharT;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+	using iterator = typename Chars::iterator;
+	using const_iterator = typename Chars::const_iterator;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using view_type = std::basic_string_view<CharT>;
+
+	static constexpr size_type npos = view_type::npos;
+
+public:
+	// constructors
+
+	basic_small_string() {
+		m_chars.push_back(CharT());
+	}
+
+	basic_small_string(const CharT* str) : basic_small_string(view_type(str)) {}
+
+	explicit basic_small_string(view_type str) : basic_small_string() {
+		append(str);
+	}
+
+	basic_small_string(size_type count, CharT ch) : basic_small_string() {
+		append(count, ch);
+	}
+
+	// operations
+
+	auto& operator=(view_type str) {
+		assign(str);
+		return *this;
+	}
+
+	auto& operator=(const CharT* str) {
+		assign(view_type(str));
+		return *this;
+	}
+
+	auto assign(view_type str) {
+		m_chars.assign(str.begin(), str.end());
+		m_chars.push_back(CharT());
+	}
+
+	// element access
+
+	[[nodiscard]] constexpr auto at(size_type pos)->reference {
+		if (size() <= pos) {
+			throw std::out_of_range("invalid basic_small_string subscript");
+		}
+		return data()[pos];
+	}
+
+	[[nodiscard]] constexpr auto at(size_type pos) const->const_reference {
+		if (size() <= pos) {
+			throw std::out_of_range("invalid basic_small_string subscript");
+		}
+		return data()[pos];
+	}
+
+	[[nodiscard]] constexpr auto operator[](size_type pos) noexcept->reference {
+		return m_chars[pos];
+	}
+
+	[[nodiscard]] constexpr auto operator[](size_type pos) const noexcept->const_reference {
+		return m_chars[pos];
+	}
+
+	[[nodiscard]] constexpr auto front() noexcept->reference {
+		return *data();
+	}
+
+	[[nodiscard]] constexpr auto front() const noexcept->const_reference {
+		return *data();
+	}
+
+	[[nodiscard]] constexpr auto back() noexcept->reference {
+		return data()[size() - 1];
+	}
+
+	[[nodiscard]] constexpr auto back() const noexcept->const_reference {
+		return data()[size() - 1];
+	}
+
+	[[nodiscard]] constexpr auto data() noexcept->pointer {
+		return m_chars.data();
+	}
+
+	[[nodiscard]] constexpr auto data() const noexcept->const_pointer {
+		return m_chars.data();
+	}
+
+	[[nodiscard]] constexpr auto c_str() const noexcept->const_pointer {
+		return m_chars.data();
+	}
+
+	[[nodiscard]] constexpr auto view() const noexcept->view_type {
+		return view_type(data(), size());
+	}
+
+	[[nodiscard]] constexpr operator view_type() const noexcept {
+		return view();
+	}
+
+	// iterators
+
+	[[nodiscard]] constexpr auto begin() noexcept {
+		return m_chars.begin();
+	}
+
+	[[nodiscard]] constexpr auto begin() const noexcept {
+		return m_chars.begin();
+	}
+
+	[[nodiscard]] constexpr auto end() noexcept {
+		return m_chars.end() - 1;
+	}
+
+	[[nodiscard]] constexpr auto end() const noexcept {
+		return m_chars.end() - 1;
+	}
+
+	[[nodiscard]] constexpr auto rbegin() noexcept {
+		return reverse_iterator(end());
+	}
+
+	[[nodiscard]] constexpr auto rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+
+	[[nodiscard]] constexpr auto rend() noexcept {
+		return reverse_iterator(begin());
+	}
+
+	[[nodiscard]] constexpr auto rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+
+	[[nodiscard]] constexpr auto cbegin() const noexcept {
+		return begin();
+	}
+
+	[[nodiscard]] constexpr auto cend() const noexcept {
+		return end();
+	}
+
+	// capacity
+
+	[[nodiscard]] constexpr auto size() const noexcept->size_type {
+		return m_chars.size() - 1;
+	}
+
+	[[nodiscard]] constexpr auto length() const noexcept->size_type {
+		return size();
+	}
+
+	[[nodiscard]] constexpr auto empty() const noexcept->bool {
+		return size() == 0;
+	}
+
+	[[nodiscard]] constexpr auto capacity() const noexcept->size_type {
+		return m_chars.capacity() - 1;
+	}
+
+	auto reserve(size_type new_cap) {
+		m_chars.reserve(new_cap + 1);
+	}
+
+	// modifiers
+
+	auto clear() {
+		m_chars.resize(1);
+		m_chars[0] = CharT();
+	}
+
+	auto push_back(CharT ch) {
+		m_chars.back() = ch;
+		m_chars.push_back(CharT());
+	}
+
+	auto pop_back() {
+		m_chars.pop_back();
+		m_chars.back() = CharT();
+	}
+
+	auto append(view_type str)->basic_small_string& {
+		// str may view this string, whose characters move if it has to grow, so those are copied from their offset
+		if (str.data() >= data() && str.data() < data() + size()) {
+			const auto offset = static_cast<size_type>(str.data() - data());
+			const auto dest = append_uninitialized(str.size());
+			traits_type::copy(dest, data() + offset, str.size());
+			return *this;
+		}
+		traits_type::copy(append_uninitialized(str.size()), str.data(), str.size());
+		return *this;
+	}
+
+	auto append(size_type count, CharT ch)->basic_small_string& {
+		traits_type::assign(append_uninitialized(count), count, ch);
+		return *this;
+	}
+
+	auto operator+=(view_type str)->basic_small_string& {
+		return append(str);
+	}
+
+	auto operator+=(CharT ch)->basic_small_string& {
+		push_back(ch);
+		return *this;
+	}
+
+	// grows the string by count characters without initializing them and returns a pointer to the first
+	// the caller is expected to write all count characters, the terminator is already in place
+	[[nodiscard]] auto append_uninitialized(size_type count)->pointer {
+		const auto old_size = size();
+		m_chars.resize_default_init(old_size + count + 1);
+		data()[old_size + count] = CharT();
+		return data() + old_size;
+	}
+
+	auto resize(size_type count, CharT ch = CharT()) {
+		if (count > size()) append(count - size(), ch);
+		else resize_uninitialized(count);
+	}
+
+	// resizes without initializing any added characters
+	auto resize_uninitialized(size_type count) {
+		m_chars.resize_default_init(count + 1);
+		data()[count] = CharT();
+	}
+
+	auto swap(basic_small_string& other) {
+		m_chars.swap(other.m_chars);
+	}
+
+	// search
+
+	[[nodiscard]] auto find(CharT ch, size_type pos = 0) const noexcept->size_type {
+		if (pos >= size()) return npos;
+		const auto found = traits_type::find(data() + pos, size() - pos, ch);
+		return found ? static_cast<size_type>(found - data()) : npos;
+	}
+
+	[[nodiscard]] auto find(view_type str, size_type pos = 0) const noexcept->size_type {
+		return view().find(str, pos);
+	}
+
+	[[nodiscard]] auto rfind(CharT ch, size_type pos = npos) const noexcept->size_type {
+		return view().rfind(ch, pos);
+	}
+
+	[[nodiscard]] auto rfind(view_type str, size_type pos = npos) const noexcept->size_type {
+		return view().rfind(str, pos);
+	}
+
+	[[nodiscard]] auto contains(CharT ch) const noexcept->bool {
+		return find(ch) != npos;
+	}
+
+	[[nodiscard]] auto contains(view_type str) const noexcept->bool {
+		return find(str) != npos;
+	}
+
+	[[nodiscard]] auto starts_with(view_type str) const noexcept->bool {
+		return size() >= str.size() && traits_type::compare(data(), str.data(), str.size()) == 0;
+	}
+
+	[[nodiscard]] auto ends_with(view_type str) const noexcept->bool {
+		return size() >= str.size() && traits_type::compare(data() + size() - str.size(), str.data(), str.size()) == 0;
+	}
+
+	[[nodiscard]] auto compare(view_type str) const noexcept->int {
+		return view().compare(str);
+	}
+
+	// comparison with any type convertible to view_type, including other basic_small_string types
+
+	template<typename Rhs, typename = std::enable_if_t<std::is_convertible_v<const Rhs&, view_type>>>
+	[[nodiscard]] friend auto operator==(const basic_small_string& lhs, const Rhs& rhs) noexcept->bool {
+		const auto rhs_view = view_type(rhs);
+		return lhs.size() == rhs_view.size() && traits_type::compare(lhs.data(), rhs_view.data(), lhs.size()) == 0;
+	}
+
+	template<typename Lhs, typename = std::enable_if_t<std::is_convertible_v<const Lhs&, view_type> && !detail::is_small_string_v<Lhs>>>
+	[[nodiscard]] friend auto operator==(const Lhs& lhs, const basic_small_string& rhs) noexcept->bool {
+		return rhs == lhs;
+	}
+
+	template<typename Rhs, typename = std::enable_if_t<std::is_convertible_v<const Rhs&, view_type>>>
+	[[nodiscard]] friend auto operator!=(const basic_small_string& lhs, const Rhs& rhs) noexcept->bool {
+		return !(lhs == rhs);
+	}
+
+	template<typename Lhs, typename = std::enable_if_t<std::is_convertible_v<const Lhs&, view_type> && !detail::is_small_string_v<Lhs>>>
+	[[nodiscard]] friend auto operator!=(const Lhs& lhs, const basic_small_string& rhs) noexcept->bool {
+		return !(rhs == lhs);
+	}
+
+	template<typename Rhs, typename = std::enable_if_t<std::is_convertible_v<const Rhs&, view_type>>>
+	[[nodiscard]] friend auto operator<(const basic_small_string& lhs, const Rhs& rhs) noexcept->bool {
+		return lhs.compare(view_type(rhs)) < 0;
+	}
+
+	template<typename Lhs, typename = std::enable_if_t<std::is_convertible_v<const Lhs&, view_type> && !detail::is_small_string_v<Lhs>>>
+	[[nodiscard]] friend auto operator<(const Lhs& lhs, const basic_small_string& rhs) noexcept->bool {
+		return rhs.compare(view_type(lhs)) > 0;
+	}
+
+	template<typename Rhs, typename = std::enable_if_t<std::is_convertible_v<const Rhs&, view_type>>>
+	[[nodiscard]] friend auto operator>(const basic_small_string& lhs, const Rhs& rhs) noexcept->bool {
+		return lhs.compare(view_type(rhs)) > 0;
+	}
+
+	template<typename Lhs, typename = std::enable_if_t<std::is_convertible_v<const Lhs&, view_type> && !detail::is_small_string_v<Lhs>>>
+	[[nodiscard]] friend auto operator>(const Lhs& lhs, const basic_small_string& rhs) noexcept->bool {
+		return rhs.compare(view_type(lhs)) < 0;
+	}
+
+	template<typename Rhs, typename = std::enable_if_t<std::is_convertible_v<const Rhs&, view_type>>>
+	[[nodiscard]] friend auto operator<=(const basic_small_string& lhs, const Rhs& rhs) noexcept->bool {
+		return !(lhs > rhs);
+	}
+
+	template<typename Lhs, typename = std::enable_if_t<std::is_convertible_v<const Lhs&, view_type> && !detail::is_small_string_v<Lhs>>>
+	[[nodiscard]] friend auto operator<=(const Lhs& lhs, const basic_small_string& rhs) noexcept->bool {
+		return !(lhs > rhs);
+	}
+
+	template<typename Rhs, typename = std::enable_if_t<std::is_convertible_v<const Rhs&, view_type>>>
+	[[nodiscard]] friend auto operator>=(const basic_small_string& lhs, const Rhs& rhs) noexcept->bool {
+		return !(lhs < rhs);
+	}
+
+	template<typename Lhs, typename = std::enable_if_t<std::is_convertible_v<const Lhs&, view_type> && !detail::is_small_string_v<Lhs>>>
+	[[nodiscard]] friend auto operator>=(const Lhs& lhs, const basic_small_string& rhs) noexcept->bool {
+		return !(lhs < rhs);
+	}
+
+private:
+	Chars m_chars;
+};
+
+// string of at most Capacity characters, free of allocations
+template<std::size_t Capacity, typename CharT = char>
+using static_string = basic_small_string<CharT, static_vector<CharT, Capacity + 1>>;
+
+// string storing up to StaticCapacity characters inline before moving to dynamic storage
+template<std::size_t StaticCapacity = 31, typename CharT = char>
+using small_string = basic_small_string<CharT, small_vector<CharT, StaticCapacity + 1>>;
+
+}
+
+template<typename CharT, typename Chars>
+struct std::hash<perfvect::basic_small_string<CharT, Chars>> {
+	auto operator()(const perfvect::basic_small_string<CharT, Chars>& str) const noexcept->std::size_t {
+		return std::hash<std::basic_string_view<CharT>>()(str.view());
+	}
+};
+
+#endif
\ No newline at end of file
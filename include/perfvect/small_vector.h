@@ -98,6 +98,12 @@ public:
 		return *this;
 	}
 
+	template<typename Expr, typename = std::enable_if_t<detail::is_numeric_expr_of_v<Expr, T>>>
+	auto& operator=(const Expr& expr) {
+		base_t::operator=(expr);
+		return *this;
+	}
+
 	// modifiers
 	constexpr auto swap(small_vector& other) noexcept(noexcept(base_t::swap(other)))->void {
 		base_t::swap(other);
@@ -109,4 +115,7 @@ private:
 
 }
 
+template<typename T, std::size_t StaticCapacity, std::size_t DynamicCapacity, typename Allocator>
+struct std::hash<perfvect::small_vector<T, StaticCapacity, DynamicCapacity, Allocator>> : std::hash<perfvect::static_vector_base<T>> {};
+
 #endif
\ No newline at end of file
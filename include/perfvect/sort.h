@@ -0,0 +1,240 @@
+#ifndef PERFVECT_SORT_H
+#define PERFVECT_SORT_H
+
+#include "simd.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace perfvect {
+namespace detail {
+
+// sorting kernels behind static_vector_base::sort() and sort_by_key(): arithmetic keys are sorted by a branchless
+// sorting network while they fit one, by an LSD radix sort once there are enough of them to pay for its histograms
+// and scratch buffer, and by std::sort on raw pointers in between and for everything else
+
+// element and key types with a radix ordering: their values map onto unsigned integers of the same size
+template<typename T>
+inline constexpr bool is_radix_sortable_v = std::is_arithmetic_v<T>
+	&& (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+	&& !std::is_same_v<T, long double>;
+
+// largest number of elements sorted by the sorting network
+inline constexpr std::size_t network_sort_limit = 64;
+
+// smallest number of elements radix sorted, below which the passes over the histograms cost more than they save
+inline constexpr std::size_t radix_sort_threshold = 512;
+
+// largest number of values sort_by_key() radix sorts: past this the final gather into sorted order misses the cache on
+// nearly every value and loses to sorting the values themselves
+inline constexpr std::size_t radix_sort_by_key_limit = std::size_t{1} << 18;
+
+// unsigned integer ordered the same way as value: signed integers have their sign bit flipped, negative floating
+// point numbers all their bits and positive ones just the sign bit, which sorts NaNs to the ends by their sign
+template<typename T>
+[[nodiscard]] inline auto radix_key(const T value) noexcept {
+	using key_t = uint_of_size_t<sizeof(T)>;
+	constexpr auto sign = static_cast<key_t>(key_t{1} << (sizeof(T) * 8 - 1));
+	if constexpr (std::is_floating_point_v<T>) {
+		const auto bits = bits_of(value);
+		return static_cast<key_t>(bits & sign ? ~bits : bits | sign);
+	}
+	else if constexpr (std::is_signed_v<T>) {
+		return static_cast<key_t>(static_cast<key_t>(value) ^ sign);
+	}
+	else {
+		return static_cast<key_t>(value);
+	}
+}
+
+// uninitialized storage for count elements of type U, taken from (a rebound copy of) alloc for the duration of a sort
+template<typename U, typename Alloc>
+class scratch_buffer {
+	using alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+	using traits_t = std::allocator_traits<alloc_t>;
+
+public:
+	scratch_buffer(const Alloc& alloc, const std::size_t count) :
+		m_alloc(alloc), m_data(traits_t::allocate(m_alloc, count)), m_count(count)
+	{}
+
+	scratch_buffer(const scratch_buffer&) = delete;
+	auto operator=(const scratch_buffer&)->scratch_buffer& = delete;
+
+	~scratch_buffer() {
+		traits_t::deallocate(m_alloc, m_data, m_count);
+	}
+
+	[[nodiscard]] auto data() const noexcept->U* {
+		return std::addressof(*m_data);
+	}
+
+private:
+	alloc_t m_alloc;
+	typename traits_t::pointer m_data;
+	std::size_t m_count;
+};
+
+// sorting network
+
+template<typename T>
+inline auto compare_exchange(T& lo, T& hi) noexcept {
+	const auto a = lo;
+	const auto b = hi;
+	lo = b < a ? b : a;
+	hi = b < a ? a : b;
+}
+
+// bitonic sorting network over exactly Size values, Size a power of two; every comparator orders its pair the same
+// way (each merge starts by comparing mirrored positions instead of reversing half the block), and the comparators of
+// a step are laid out as runs of contiguous pairs so the compiler turns them into vector min/max instructions
+template<std::size_t Size, typename T>
+inline auto bitonic_sort(T* values) noexcept {
+	for (std::size_t block = 2; block <= Size; block *= 2) {
+		for (std::size_t base = 0; base < Size; base += block) {
+			for (std::size_t idx = 0; idx < block / 2; ++idx) compare_exchange(values[base + idx], values[base + block - 1 - idx]);
+		}
+		for (auto stride = block / 4; stride; stride /= 2) {
+			for (std::size_t base = 0; base < Size; base += stride * 2) {
+				for (std::size_t idx = 0; idx < stride; ++idx) compare_exchange(values[base + idx], values[base + stride + idx]);
+			}
+		}
+	}
+}
+
+// pads count values (at most Size) with the largest value of T, sorts them by network and copies them back
+// floating point values are sorted by their radix keys, as x86 has no vector min/max that matches operator< on NaNs and
+// signed zeros, which keeps the compiler from vectorising their comparators
+template<std::size_t Size, typename T>
+inline auto network_sort_padded(T* data, const std::size_t count) noexcept {
+	if constexpr (std::is_floating_point_v<T>) {
+		using key_t = uint_of_size_t<sizeof(T)>;
+		constexpr auto sign = static_cast<key_t>(key_t{1} << (sizeof(T) * 8 - 1));
+		key_t keys[Size];
+		for (std::size_t idx = 0; idx < count; ++idx) keys[idx] = radix_key(data[idx]);
+		std::fill(keys + count, keys + Size, std::numeric_limits<key_t>::max());
+		bitonic_sort<Size>(keys);
+		for (std::size_t idx = 0; idx < count; ++idx) {
+			const auto bits = static_cast<key_t>(keys[idx] & sign ? keys[idx] ^ sign : ~keys[idx]);
+			std::memcpy(data + idx, &bits, sizeof(T));
+		}
+	}
+	else {
+		T values[Size];
+		std::memcpy(values, data, count * sizeof(T));
+		std::fill(values + count, values + Size, std::numeric_limits<T>::max());
+		bitonic_sort<Size>(values);
+		std::memcpy(data, values, count * sizeof(T));
+	}
+}
+
+template<typename T>
+inline auto network_sort(T* data, const std::size_t count) noexcept {
+	if (count <= 1) return;
+	if (count <= 8) network_sort_padded<8>(data, count);
+	else if (count <= 16) network_sort_padded<16>(data, count);
+	else if (count <= 32) network_sort_padded<32>(data, count);
+	else network_sort_padded<64>(data, count);
+}
+
+// radix sort
+
+// stable LSD radix sort of count items by the unsigned key_of(item), a byte per pass, ping-ponging between data and
+// scratch; the histograms of every pass are counted up front in one read, and passes whose byte is the same for all
+// items are skipped
+template<typename Item, typename KeyOf>
+auto radix_sort(Item* data, Item* scratch, const std::size_t count, KeyOf key_of) noexcept {
+	using key_t = decltype(key_of(*data));
+	constexpr std::size_t passes = sizeof(key_t);
+
+	std::size_t counts[passes][256] = {};
+	for (std::size_t idx = 0; idx < count; ++idx) {
+		const auto key = key_of(data[idx]);
+		for (std::size_t pass = 0; pass < passes; ++pass) ++counts[pass][(key >> (pass * 8)) & 0xFF];
+	}
+
+	auto src = data;
+	auto dst = scratch;
+	for (std::size_t pass = 0; pass < passes; ++pass) {
+		auto& offsets = counts[pass];
+		const auto shift = pass * 8;
+		if (offsets[(key_of(src[0]) >> shift) & 0xFF] == count) continue;
+
+		std::size_t sum = 0;
+		for (auto& offset : offsets) {
+			const auto bucket = offset;
+			offset = sum;
+			sum += bucket;
+		}
+		for (std::size_t idx = 0; idx < count; ++idx) dst[offsets[(key_of(src[idx]) >> shift) & 0xFF]++] = src[idx];
+		std::swap(src, dst);
+	}
+	if (src != data) std::memcpy(data, src, count * sizeof(Item));
+}
+
+template<typename Key>
+struct keyed_index {
+	Key key;
+	std::uint32_t index;
+};
+
+// entry points
+
+// sorts count values ascending by operator<
+template<typename T, typename Alloc>
+auto sort_values(T* data, const std::size_t count, const Alloc& alloc) {
+	if constexpr (is_radix_sortable_v<T>) {
+		if (count <= network_sort_limit) return network_sort(data, count);
+		if (count >= radix_sort_threshold) {
+			const scratch_buffer<T, Alloc> scratch(alloc, count);
+			return radix_sort(data, scratch.data(), count, [](const T value) { return radix_key(value); });
+		}
+	}
+	std::sort(data, data + count);
+}
+
+// sorts count values ascending by proj(value); arithmetic keys of many nothrow-movable values are computed once each
+// and radix sorted along with their positions, after which the values are moved into the sorted order
+template<typename T, typename Proj, typename Alloc>
+auto sort_values_by_key(T* data, const std::size_t count, Proj& proj, const Alloc& alloc) {
+	using key_t = std::decay_t<std::invoke_result_t<Proj&, const T&>>;
+	if constexpr (is_radix_sortable_v<key_t> && std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>) {
+		if (count >= radix_sort_threshold && count <= radix_sort_by_key_limit) {
+			using item_t = keyed_index<uint_of_size_t<sizeof(key_t)>>;
+			const scratch_buffer<item_t, Alloc> items(alloc, count * 2);
+			for (std::size_t idx = 0; idx < count; ++idx) {
+				items.data()[idx] = item_t{radix_key(static_cast<key_t>(std::invoke(proj, std::as_const(data[idx])))), static_cast<std::uint32_t>(idx)};
+			}
+			radix_sort(items.data(), items.data() + count, count, [](const item_t& item) { return item.key; });
+
+			const scratch_buffer<T, Alloc> sorted(alloc, count);
+			if constexpr (std::is_trivially_copyable_v<T>) {
+				for (std::size_t idx = 0; idx < count; ++idx) std::memcpy(sorted.data() + idx, data + items.data()[idx].index, sizeof(T));
+				std::memcpy(data, sorted.data(), count * sizeof(T));
+			}
+			else {
+				for (std::size_t idx = 0; idx < count; ++idx) ::new (static_cast<void*>(sorted.data() + idx)) T(std::move(data[items.data()[idx].index]));
+				for (std::size_t idx = 0; idx < count; ++idx) {
+					data[idx] = std::move(sorted.data()[idx]);
+					sorted.data()[idx].~T();
+				}
+			}
+			return;
+		}
+	}
+	std::sort(data, data + count, [&proj](const T& lhs, const T& rhs) {
+		return std::invoke(proj, lhs) < std::invoke(proj, rhs);
+	});
+}
+
+}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,288 @@
+#ifndef PERFVECT_SORTED_VECTOR_H
+#define PERFVECT_SORTED_VECTOR_H
+
+#include "bit.h"
+#include "small_vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace perfvect {
+namespace detail {
+	inline auto prefetch(const void* addr) noexcept {
+		#if defined(_MSC_VER) && !defined(__clang__)
+		_mm_prefetch(static_cast<const char*>(addr), _MM_HINT_T0);
+		#else
+		__builtin_prefetch(addr);
+		#endif
+	}
+}
+
+enum class sorted_layout {
+	// ascending order, searched with a branchless binary search
+	sorted,
+	// breadth-first order of an implicit binary search tree, searched top-down with prefetching
+	eytzinger,
+};
+
+// vector kept ordered by Compare, optimised for lookups
+// with sorted_layout::eytzinger the storage order (begin() to end()) is the tree order rather than ascending order;
+// use for_each_sorted() to visit elements in ascending order regardless of layout
+template<
+	typename T,
+	std::size_t StaticCapacity = 16,
+	sorted_layout Layout = sorted_layout::sorted,
+	typename Compare = std::less<T>
+>
+class sorted_vector {
+	using storage_t = small_vector<T, StaticCapacity>;
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using const_reference = const value_type&;
+	using const_pointer = const value_type*;
+	using const_iterator = typename storage_t::const_iterator;
+	using key_compare = Compare;
+
+	static constexpr auto layout = Layout;
+
+public:
+	// constructors
+
+	sorted_vector() = default;
+
+	explicit sorted_vector(const Compare& comp) : m_comp(comp) {}
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	sorted_vector(InputIt first, InputIt last, const Compare& comp = Compare()) : m_comp(comp) {
+		assign(first, last);
+	}
+
+	sorted_vector(std::initializer_list<value_type> init, const Compare& comp = Compare()) : m_comp(comp) {
+		assign(init.begin(), init.end());
+	}
+
+	// bulk build, sorting the whole range once
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	auto assign(InputIt first, InputIt last) {
+		m_data.assign(first, last);
+		std::sort(m_data.data(), m_data.data() + m_data.size(), m_comp);
+		if constexpr (Layout == sorted_layout::eytzinger) build_eytzinger();
+	}
+
+	// element access
+
+	[[nodiscard]] auto operator[](size_type pos) const noexcept->const_reference {
+		return m_data[pos];
+	}
+
+	[[nodiscard]] auto data() const noexcept->const_pointer {
+		return m_data.data();
+	}
+
+	// iterators, in storage order
+
+	[[nodiscard]] auto begin() const noexcept {
+		return m_data.begin();
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return m_data.end();
+	}
+
+	// calls func(const T&) for every element in ascending order
+	template<typename Func>
+	auto for_each_sorted(Func&& func) const {
+		if constexpr (Layout == sorted_layout::sorted) {
+			for (const auto& value : m_data) func(value);
+		}
+		else {
+			for_each_in_order(1, func);
+		}
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_data.size();
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_data.empty();
+	}
+
+	[[nodiscard]] auto capacity() const noexcept->size_type {
+		return m_data.capacity();
+	}
+
+	auto reserve(size_type new_cap) {
+		m_data.reserve(new_cap);
+	}
+
+	// lookup
+
+	// first element not ordered before key, or end()
+	[[nodiscard]] auto lower_bound(const value_type& key) const noexcept->const_iterator {
+		return begin() + static_cast<difference_type>(lower_bound_index(key));
+	}
+
+	// storage index of the first element not ordered before key, or size()
+	[[nodiscard]] auto lower_bound_index(const value_type& key) const noexcept->size_type {
+		if constexpr (Layout == sorted_layout::sorted) return sorted_lower_bound(key);
+		else return eytzinger_lower_bound(key);
+	}
+
+	[[nodiscard]] auto find(const value_type& key) const noexcept->const_iterator {
+		const auto idx = lower_bound_index(key);
+		return idx != size() && !m_comp(key, m_data[idx]) ? begin() + static_cast<difference_type>(idx) : end();
+	}
+
+	[[nodiscard]] auto contains(const value_type& key) const noexcept->bool {
+		return find(key) != end();
+	}
+
+	// modifiers
+
+	auto clear() {
+		m_data.clear();
+	}
+
+	auto insert(const value_type& value) {
+		if constexpr (Layout == sorted_layout::sorted) {
+			const auto pos = std::upper_bound(m_data.data(), m_data.data() + m_data.size(), value, m_comp);
+			m_data.insert(m_data.begin() + (pos - m_data.data()), value);
+		}
+		else {
+			insert(&value, &value + 1);
+		}
+	}
+
+	// batched insert: sorts the batch then merges it in a single linear pass
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	auto insert(InputIt first, InputIt last) {
+		const auto old_size = m_data.size();
+		if constexpr (Layout == sorted_layout::sorted) {
+			m_data.insert(m_data.end(), first, last);
+			const auto mid = m_data.data() + old_size;
+			std::sort(mid, m_data.data() + m_data.size(), m_comp);
+			std::inplace_merge(m_data.data(), mid, m_data.data() + m_data.size(), m_comp);
+		}
+		else {
+			storage_t merged;
+			merged.reserve(old_size + static_cast<size_type>(std::distance(first, last)));
+			for_each_sorted([&merged](const value_type& value) { merged.push_back(value); });
+			merged.insert(merged.end(), first, last);
+			const auto mid = merged.data() + old_size;
+			std::sort(mid, merged.data() + merged.size(), m_comp);
+			std::inplace_merge(merged.data(), mid, merged.data() + merged.size(), m_comp);
+			m_data.swap(merged);
+			build_eytzinger();
+		}
+	}
+
+	auto insert(std::initializer_list<value_type> ilist) {
+		insert(ilist.begin(), ilist.end());
+	}
+
+	// removes every element equivalent to key and returns the number removed
+	auto erase(const value_type& key)->size_type {
+		const auto old_size = m_data.size();
+		if constexpr (Layout == sorted_layout::sorted) {
+			const auto [first, last] = std::equal_range(m_data.data(), m_data.data() + old_size, key, m_comp);
+			m_data.erase(m_data.begin() + (first - m_data.data()), m_data.begin() + (last - m_data.data()));
+		}
+		else {
+			if (!contains(key)) return 0;
+			storage_t kept;
+			kept.reserve(old_size);
+			for_each_sorted([&](const value_type& value) {
+				if (m_comp(value, key) || m_comp(key, value)) kept.push_back(value);
+			});
+			m_data.swap(kept);
+			build_eytzinger();
+		}
+		return old_size - m_data.size();
+	}
+
+	auto swap(sorted_vector& other) {
+		m_data.swap(other.m_data);
+		std::swap(m_comp, other.m_comp);
+	}
+
+private:
+	// branchless binary search: the loop trip count depends only on the size, and each step is a conditional move
+	[[nodiscard]] auto sorted_lower_bound(const value_type& key) const noexcept->size_type {
+		const auto first = m_data.data();
+		auto len = m_data.size();
+		if (!len) return 0;
+
+		auto base = first;
+		while (len > 1) {
+			const auto half = len / 2;
+			detail::prefetch(base + half / 2);
+			detail::prefetch(base + half + half / 2);
+			base = m_comp(base[half], key) ? base + half : base;
+			len -= half;
+		}
+		return static_cast<size_type>(base - first) + m_comp(*base, key);
+	}
+
+	// descends the implicit tree (node k has children 2k and 2k + 1, stored at k - 1) then recovers the last
+	// left turn, prefetching the cache line holding the descendants several levels below
+	[[nodiscard]] auto eytzinger_lower_bound(const value_type& key) const noexcept->size_type {
+		constexpr size_type line_elems = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+		const auto nodes = m_data.data();
+		const auto n = m_data.size();
+
+		size_type k = 1;
+		while (k <= n) {
+			detail::prefetch(nodes + std::min(k * line_elems, n) - 1);
+			k = 2 * k + m_comp(nodes[k - 1], key);
+		}
+		k >>= detail::countr_zero(~static_cast<std::uint64_t>(k)) + 1;
+		return k ? k - 1 : n;
+	}
+
+	// permutes the sorted contents into breadth-first order
+	auto build_eytzinger() {
+		const auto n = m_data.size();
+		if (n < 2) return;
+		storage_t sorted;
+		sorted.reserve(n);
+		sorted.insert(sorted.end(), std::make_move_iterator(m_data.begin()), std::make_move_iterator(m_data.end()));
+		size_type next = 0;
+		fill_eytzinger(sorted.data(), next, 1);
+	}
+
+	auto fill_eytzinger(value_type* sorted, size_type& next, const size_type k)->void {
+		if (k > m_data.size()) return;
+		fill_eytzinger(sorted, next, 2 * k);
+		m_data[k - 1] = std::move(sorted[next++]);
+		fill_eytzinger(sorted, next, 2 * k + 1);
+	}
+
+	template<typename Func>
+	auto for_each_in_order(const size_type k, Func& func) const->void {
+		if (k > m_data.size()) return;
+		for_each_in_order(2 * k, func);
+		func(m_data[k - 1]);
+		for_each_in_order(2 * k + 1, func);
+	}
+
+private:
+	storage_t m_data;
+	Compare m_comp;
+};
+
+}
+
+#endif
\ No newline at end of file
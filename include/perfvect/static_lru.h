@@ -0,0 +1,328 @@
+#ifndef PERFVECT_STATIC_LRU_H
+#define PERFVECT_STATIC_LRU_H
+
+#include "static_vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+namespace perfvect {
+namespace detail {
+	struct lru_slot {
+		// position of the node plus one, 0 for an empty slot
+		std::uint32_t node;
+		// low bits of the key's hash, which also give the slot's home bucket
+		std::uint32_t hash;
+	};
+
+	[[nodiscard]] constexpr auto lru_index_size(const std::size_t capacity) noexcept {
+		std::size_t slots = 8;
+		while (slots < capacity * 2) slots *= 2;
+		return slots;
+	}
+}
+
+// least-recently-used cache holding at most Capacity entries, with no dynamic allocation at all: the nodes live in a
+// static_vector, the recency list links them by position and a fixed open-addressing index (linear probing with
+// backward-shift deletion, so no tombstones) maps keys to nodes
+// inserting into a full cache evicts the least recently used entry; lookups through find() count hits and misses
+template<
+	typename Key,
+	typename T,
+	std::size_t Capacity,
+	typename Hash = std::hash<Key>,
+	typename KeyEqual = std::equal_to<Key>
+>
+class static_lru {
+	static_assert(Capacity > 0, "static_lru needs a capacity of at least 1");
+	static_assert(Capacity < std::numeric_limits<std::uint32_t>::max(), "static_lru capacity must fit in 32 bits");
+
+	static constexpr std::uint32_t nil = std::numeric_limits<std::uint32_t>::max();
+	static constexpr std::size_t index_size = detail::lru_index_size(Capacity);
+	static constexpr std::size_t index_mask = index_size - 1;
+
+	struct node {
+		template<typename K, typename... Args>
+		node(const std::uint32_t hash, K&& key, Args&&... args) :
+			entry(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...)),
+			hash(hash)
+		{}
+
+		std::pair<Key, T> entry;
+		std::uint32_t hash;
+		std::uint32_t prev = nil;
+		std::uint32_t next = nil;
+	};
+
+public:
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<Key, T>;
+	using size_type = std::size_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+
+public:
+	// constructors
+
+	static_lru() = default;
+
+	// lookup
+
+	// returns the value for key and marks it most recently used, or null on a miss
+	[[nodiscard]] auto find(const key_type& key)->mapped_type* {
+		const auto pos = find_node(key, hash_of(key));
+		if (pos == nil) {
+			++m_misses;
+			return nullptr;
+		}
+		++m_hits;
+		touch(pos);
+		return &m_nodes[pos].entry.second;
+	}
+
+	// returns the value for key without touching the recency order or the counters
+	[[nodiscard]] auto peek(const key_type& key) const->const mapped_type* {
+		const auto pos = find_node(key, hash_of(key));
+		return pos == nil ? nullptr : &m_nodes[pos].entry.second;
+	}
+
+	[[nodiscard]] auto contains(const key_type& key) const->bool {
+		return find_node(key, hash_of(key)) != nil;
+	}
+
+	// the most recently used entry
+	[[nodiscard]] auto front() const noexcept->const value_type& {
+		return m_nodes[m_head].entry;
+	}
+
+	// the least recently used entry, which is evicted next
+	[[nodiscard]] auto back() const noexcept->const value_type& {
+		return m_nodes[m_tail].entry;
+	}
+
+	// calls func(key, value) for every entry, most recently used first
+	template<typename Func>
+	auto for_each(Func&& func) const {
+		for (auto pos = m_head; pos != nil; pos = m_nodes[pos].next) {
+			func(m_nodes[pos].entry.first, m_nodes[pos].entry.second);
+		}
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_nodes.size();
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_nodes.empty();
+	}
+
+	[[nodiscard]] auto full() const noexcept->bool {
+		return m_nodes.size() == Capacity;
+	}
+
+	[[nodiscard]] static constexpr auto capacity() noexcept->size_type {
+		return Capacity;
+	}
+
+	// statistics
+
+	[[nodiscard]] auto hits() const noexcept->std::uint64_t {
+		return m_hits;
+	}
+
+	[[nodiscard]] auto misses() const noexcept->std::uint64_t {
+		return m_misses;
+	}
+
+	[[nodiscard]] auto evictions() const noexcept->std::uint64_t {
+		return m_evictions;
+	}
+
+	auto reset_stats() noexcept {
+		m_hits = 0;
+		m_misses = 0;
+		m_evictions = 0;
+	}
+
+	// modifiers
+
+	// inserts value under key as the most recently used entry, or assigns it if key is already cached
+	template<typename K, typename M>
+	auto insert_or_assign(K&& key, M&& value)->mapped_type& {
+		const auto hash = hash_of(key);
+		const auto pos = find_node(key, hash);
+		if (pos != nil) {
+			touch(pos);
+			return m_nodes[pos].entry.second = std::forward<M>(value);
+		}
+		return emplace_new(hash, std::forward<K>(key), std::forward<M>(value));
+	}
+
+	// constructs the value from args if key is not cached; either way the entry becomes the most recently used
+	template<typename K, typename... Args>
+	auto try_emplace(K&& key, Args&&... args)->std::pair<mapped_type&, bool> {
+		const auto hash = hash_of(key);
+		const auto pos = find_node(key, hash);
+		if (pos != nil) {
+			touch(pos);
+			return {m_nodes[pos].entry.second, false};
+		}
+		return {emplace_new(hash, std::forward<K>(key), std::forward<Args>(args)...), true};
+	}
+
+	// memoisation helper: returns the cached value for key, or caches and returns make() on a miss
+	// counts a hit or a miss like find()
+	template<typename K, typename Make>
+	auto get_or_insert_with(K&& key, Make&& make)->mapped_type& {
+		const auto hash = hash_of(key);
+		const auto pos = find_node(key, hash);
+		if (pos != nil) {
+			++m_hits;
+			touch(pos);
+			return m_nodes[pos].entry.second;
+		}
+		++m_misses;
+		return emplace_new(hash, std::forward<K>(key), std::forward<Make>(make)());
+	}
+
+	auto erase(const key_type& key)->bool {
+		const auto pos = find_node(key, hash_of(key));
+		if (pos == nil) return false;
+		remove_node(pos);
+		return true;
+	}
+
+	// removes the least recently used entry
+	auto pop_back() {
+		remove_node(m_tail);
+	}
+
+	auto clear() {
+		m_nodes.clear();
+		for (auto& slot : m_index) slot = detail::lru_slot{};
+		m_head = nil;
+		m_tail = nil;
+	}
+
+private:
+	[[nodiscard]] auto hash_of(const key_type& key) const->std::uint32_t {
+		return static_cast<std::uint32_t>(m_hash(key));
+	}
+
+	[[nodiscard]] auto find_node(const key_type& key, const std::uint32_t hash) const->std::uint32_t {
+		for (auto slot = hash & index_mask;; slot = (slot + 1) & index_mask) {
+			const auto& entry = m_index[slot];
+			if (!entry.node) return nil;
+			if (entry.hash == hash && m_equal(m_nodes[entry.node - 1].entry.first, key)) return entry.node - 1;
+		}
+	}
+
+	// index slot currently referring to the node at pos
+	[[nodiscard]] auto slot_of(const std::uint32_t pos) const noexcept->std::size_t {
+		auto slot = m_nodes[pos].hash & index_mask;
+		while (m_index[slot].node != pos + 1) slot = (slot + 1) & index_mask;
+		return slot;
+	}
+
+	// the key and value arguments may refer to the entry a full cache evicts, so there the new node is built aside
+	// first and moved in once the eviction is done, which also leaves the cache unchanged if building it throws
+	template<typename K, typename... Args>
+	auto emplace_new(const std::uint32_t hash, K&& key, Args&&... args)->mapped_type& {
+		if (full()) {
+			node fresh(hash, std::forward<K>(key), std::forward<Args>(args)...);
+			remove_node(m_tail);
+			++m_evictions;
+			return add_node(hash, std::move(fresh));
+		}
+		return add_node(hash, hash, std::forward<K>(key), std::forward<Args>(args)...);
+	}
+
+	// constructs a node from node_args after the others, indexes it under hash and makes it the most recently used
+	template<typename... NodeArgs>
+	auto add_node(const std::uint32_t hash, NodeArgs&&... node_args)->mapped_type& {
+		const auto pos = static_cast<std::uint32_t>(m_nodes.size());
+		m_nodes.emplace_back(std::forward<NodeArgs>(node_args)...);
+
+		auto slot = hash & index_mask;
+		while (m_index[slot].node) slot = (slot + 1) & index_mask;
+		m_index[slot] = detail::lru_slot{pos + 1, hash};
+
+		link_front(pos);
+		return m_nodes[pos].entry.second;
+	}
+
+	auto unlink(const std::uint32_t pos) noexcept {
+		auto& n = m_nodes[pos];
+		if (n.prev != nil) m_nodes[n.prev].next = n.next;
+		else m_head = n.next;
+		if (n.next != nil) m_nodes[n.next].prev = n.prev;
+		else m_tail = n.prev;
+	}
+
+	auto link_front(const std::uint32_t pos) noexcept {
+		auto& n = m_nodes[pos];
+		n.prev = nil;
+		n.next = m_head;
+		if (m_head != nil) m_nodes[m_head].prev = pos;
+		else m_tail = pos;
+		m_head = pos;
+	}
+
+	auto touch(const std::uint32_t pos) noexcept {
+		if (pos == m_head) return;
+		unlink(pos);
+		link_front(pos);
+	}
+
+	// drops the node's index slot, shifting later slots of the same probe run back into the gap
+	auto remove_slot(std::size_t hole) noexcept {
+		for (auto slot = (hole + 1) & index_mask; m_index[slot].node; slot = (slot + 1) & index_mask) {
+			const auto home = m_index[slot].hash & index_mask;
+			// the entry may only move back if the hole lies between its home bucket and its current slot
+			const auto reachable = hole <= slot ? (home <= hole || home > slot) : (home <= hole && home > slot);
+			if (!reachable) continue;
+			m_index[hole] = m_index[slot];
+			hole = slot;
+		}
+		m_index[hole] = detail::lru_slot{};
+	}
+
+	// removes the node at pos, moving the last node into its place to keep the nodes dense
+	auto remove_node(const std::uint32_t pos) {
+		unlink(pos);
+		remove_slot(slot_of(pos));
+
+		const auto last = static_cast<std::uint32_t>(m_nodes.size() - 1);
+		if (pos != last) {
+			m_index[slot_of(last)].node = pos + 1;
+			m_nodes[pos] = std::move(m_nodes[last]);
+			const auto& n = m_nodes[pos];
+			if (n.prev != nil) m_nodes[n.prev].next = pos;
+			else m_head = pos;
+			if (n.next != nil) m_nodes[n.next].prev = pos;
+			else m_tail = pos;
+		}
+		m_nodes.pop_back();
+	}
+
+private:
+	static_vector<node, Capacity> m_nodes;
+	detail::lru_slot m_index[index_size] = {};
+	std::uint32_t m_head = nil;
+	std::uint32_t m_tail = nil;
+	std::uint64_t m_hits = 0;
+	std::uint64_t m_misses = 0;
+	std::uint64_t m_evictions = 0;
+	Hash m_hash;
+	KeyEqual m_equal;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -69,12 +69,45 @@ public:
 		return *this;
 	}
 
+	template<typename Expr, typename = std::enable_if_t<detail::is_numeric_expr_of_v<Expr, T>>>
+	auto& operator=(const Expr& expr) {
+		base_t::template assign_expression<Capacity>(expr);
+		return *this;
+	}
+
 	// element access
 
 	constexpr auto swap(static_vector& other) noexcept(std::is_nothrow_swappable_v<T>)->void {
 		base_t::swap(other);
 	}
 
+	// search, fully unrolled over the capacity when it is small enough
+
+	[[nodiscard]] auto find(const value_type& value)->iterator {
+		return this->begin() + static_cast<difference_type>(find_index(value));
+	}
+
+	[[nodiscard]] auto find(const value_type& value) const->const_iterator {
+		return this->begin() + static_cast<difference_type>(find_index(value));
+	}
+
+	[[nodiscard]] auto contains(const value_type& value) const->bool {
+		return find_index(value) != this->size();
+	}
+
+	[[nodiscard]] auto count(const value_type& value) const->size_type {
+		if constexpr (unrolled_search) return detail::count_eq_unrolled<Capacity>(this->data(), this->size(), value);
+		else return base_t::count(value);
+	}
+
+private:
+	static constexpr bool unrolled_search = detail::is_simd_searchable_v<T> && Capacity <= detail::unrolled_search_limit;
+
+	[[nodiscard]] auto find_index(const value_type& value) const->size_type {
+		if constexpr (unrolled_search) return detail::find_eq_unrolled<Capacity>(this->data(), this->size(), value);
+		else return base_t::find_index(value);
+	}
+
 private:
 	alignas(T) std::byte m_storage[Capacity][sizeof(T)];
 };
@@ -84,4 +117,7 @@ private:
 template<typename T, std::size_t Capacity>
 class std::tuple_size<perfvect::static_vector<T, Capacity>> : public std::integral_constant<std::size_t, Capacity> {};
 
+template<typename T, std::size_t Capacity>
+struct std::hash<perfvect::static_vector<T, Capacity>> : std::hash<perfvect::static_vector_base<T>> {};
+
 #endif
\ No newline at end of file
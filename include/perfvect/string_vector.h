@@ -0,0 +1,364 @@
+#ifndef PERFVECT_STRING_VECTOR_H
+#define PERFVECT_STRING_VECTOR_H
+
+#include "small_vector.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace perfvect {
+
+// sequence of strings whose characters are all stored back to back in Chars, with Offsets recording where each
+// string starts; elements are returned as string views, which are invalidated by any operation that adds characters
+template<typename Chars, typename Offsets>
+class basic_string_vector {
+public:
+	using char_type = typename Chars::value_type;
+	using value_type = std::basic_string_view<char_type>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type;
+	using const_reference = value_type;
+
+	// random access iterator yielding string views
+	class const_iterator {
+		friend class basic_string_vector;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = typename basic_string_vector::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		constexpr const_iterator() noexcept = default;
+
+		[[nodiscard]] auto operator*() const noexcept->reference {
+			return (*m_vec)[m_idx];
+		}
+
+		[[nodiscard]] auto operator[](const difference_type off) const noexcept->reference {
+			return (*m_vec)[m_idx + static_cast<size_type>(off)];
+		}
+
+		constexpr auto& operator++() noexcept {
+			++m_idx;
+			return *this;
+		}
+
+		constexpr auto operator++(int) noexcept {
+			auto tmp = *this;
+			++m_idx;
+			return tmp;
+		}
+
+		constexpr auto& operator--() noexcept {
+			--m_idx;
+			return *this;
+		}
+
+		constexpr auto operator--(int) noexcept {
+			auto tmp = *this;
+			--m_idx;
+			return tmp;
+		}
+
+		constexpr auto& operator+=(const difference_type off) noexcept {
+			m_idx += static_cast<size_type>(off);
+			return *this;
+		}
+
+		constexpr auto& operator-=(const difference_type off) noexcept {
+			m_idx -= static_cast<size_type>(off);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr auto operator+(const difference_type off) const noexcept {
+			auto tmp = *this;
+			return tmp += off;
+		}
+
+		[[nodiscard]] constexpr auto operator-(const difference_type off) const noexcept {
+			auto tmp = *this;
+			return tmp -= off;
+		}
+
+		[[nodiscard]] constexpr auto operator-(const const_iterator& other) const noexcept->difference_type {
+			return static_cast<difference_type>(m_idx) - static_cast<difference_type>(other.m_idx);
+		}
+
+		[[nodiscard]] constexpr auto operator==(const const_iterator& other) const noexcept {
+			return m_idx == other.m_idx;
+		}
+
+		[[nodiscard]] constexpr auto operator!=(const const_iterator& other) const noexcept {
+			return m_idx != other.m_idx;
+		}
+
+		[[nodiscard]] constexpr auto operator<(const const_iterator& other) const noexcept {
+			return m_idx < other.m_idx;
+		}
+
+	private:
+		constexpr const_iterator(const basic_string_vector* vec, const size_type idx) noexcept : m_vec(vec), m_idx(idx) {}
+
+	private:
+		const basic_string_vector* m_vec = nullptr;
+		size_type m_idx = 0;
+	};
+
+	using iterator = const_iterator;
+
+public:
+	// constructors
+
+	basic_string_vector() = default;
+
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	basic_string_vector(InputIt first, InputIt last) {
+		append(first, last);
+	}
+
+	basic_string_vector(std::initializer_list<value_type> init) {
+		append(init.begin(), init.end());
+	}
+
+	// element access
+
+	[[nodiscard]] auto at(const size_type pos) const->value_type {
+		if (pos >= size()) throw std::out_of_range("invalid string_vector subscript");
+		return (*this)[pos];
+	}
+
+	[[nodiscard]] auto operator[](const size_type pos) const noexcept->value_type {
+		const auto first = m_offsets[pos];
+		return value_type(m_chars.data() + first, end_of(pos) - first);
+	}
+
+	[[nodiscard]] auto front() const noexcept->value_type {
+		return (*this)[0];
+	}
+
+	[[nodiscard]] auto back() const noexcept->value_type {
+		return (*this)[size() - 1];
+	}
+
+	// every character of every string, back to back
+	[[nodiscard]] auto chars() const noexcept->value_type {
+		return value_type(m_chars.data(), m_chars.size());
+	}
+
+	// iterators
+
+	[[nodiscard]] auto begin() const noexcept {
+		return const_iterator(this, 0);
+	}
+
+	[[nodiscard]] auto end() const noexcept {
+		return const_iterator(this, size());
+	}
+
+	[[nodiscard]] auto cbegin() const noexcept {
+		return begin();
+	}
+
+	[[nodiscard]] auto cend() const noexcept {
+		return end();
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		return m_offsets.size();
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return m_offsets.empty();
+	}
+
+	// total length of all strings
+	[[nodiscard]] auto char_count() const noexcept->size_type {
+		return m_chars.size();
+	}
+
+	auto reserve(const size_type count, const size_type chars) {
+		m_offsets.reserve(count);
+		m_chars.reserve(chars);
+	}
+
+	// modifiers
+
+	auto push_back(value_type str) {
+		// str may view characters of this vector, which move if the buffer has to grow, so room is made first and the
+		// view moved onto the grown buffer
+		if (holds(str)) {
+			const auto offset = static_cast<size_type>(str.data() - m_chars.data());
+			grow_to(m_chars, m_chars.size() + str.size());
+			str = value_type(m_chars.data() + offset, str.size());
+		}
+		m_offsets.push_back(m_chars.size());
+		try {
+			m_chars.insert(m_chars.end(), str.data(), str.data() + str.size());
+		}
+		catch (...) {
+			m_offsets.pop_back();
+			throw;
+		}
+	}
+
+	// appends every string in a range of string views, reserving for all of them up front when the range can be
+	// traversed twice
+	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+	auto append(InputIt first, InputIt last) {
+		using category = typename std::iterator_traits<InputIt>::iterator_category;
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+			size_type count = 0;
+			size_type chars = 0;
+			auto aliased = false;
+			for (auto it = first; it != last; ++it, ++count) {
+				const auto str = value_type(*it);
+				chars += str.size();
+				aliased = aliased || holds(str);
+			}
+
+			// views of this vector's own strings have to stay readable until they are copied, so the result is built
+			// in a separate vector and swapped in
+			if (aliased) {
+				basic_string_vector grown;
+				grown.reserve(size() + count, m_chars.size() + chars);
+				grown.m_chars.insert(grown.m_chars.end(), m_chars.begin(), m_chars.end());
+				grown.m_offsets.insert(grown.m_offsets.end(), m_offsets.begin(), m_offsets.end());
+				for (; first != last; ++first) grown.push_back(value_type(*first));
+				swap(grown);
+				return;
+			}
+
+			grow_to(m_offsets, m_offsets.size() + count);
+			grow_to(m_chars, m_chars.size() + chars);
+		}
+		for (; first != last; ++first) push_back(value_type(*first));
+	}
+
+	auto append(std::initializer_list<value_type> ilist) {
+		append(ilist.begin(), ilist.end());
+	}
+
+	// appends the tokens of text separated by delim, skipping empty tokens, with at most one allocation each for the
+	// characters and the offsets
+	auto append_split(value_type text, const char_type delim) {
+		const auto delims = static_cast<size_type>(std::count(text.begin(), text.end(), delim));
+		// text may view characters of this vector, which move if the buffer grows
+		const auto aliased = holds(text);
+		const auto offset = aliased ? static_cast<size_type>(text.data() - m_chars.data()) : 0;
+		grow_to(m_offsets, m_offsets.size() + delims + 1);
+		grow_to(m_chars, m_chars.size() + text.size() - delims);
+		if (aliased) text = value_type(m_chars.data() + offset, text.size());
+
+		size_type pos = 0;
+		while (pos < text.size()) {
+			auto next = text.find(delim, pos);
+			if (next == value_type::npos) next = text.size();
+			if (next != pos) push_back(text.substr(pos, next - pos));
+			pos = next + 1;
+		}
+	}
+
+	auto pop_back() {
+		m_chars.erase(m_chars.begin() + static_cast<difference_type>(m_offsets[size() - 1]), m_chars.end());
+		m_offsets.pop_back();
+	}
+
+	// removes the strings in [first, last), closing the gap in the character buffer straight away
+	auto erase(const const_iterator first, const const_iterator last)->iterator {
+		if (first == last) return last;
+
+		const auto char_first = m_offsets[first.m_idx];
+		const auto char_last = last.m_idx < size() ? m_offsets[last.m_idx] : m_chars.size();
+		const auto removed = char_last - char_first;
+
+		m_chars.erase(
+			m_chars.begin() + static_cast<difference_type>(char_first),
+			m_chars.begin() + static_cast<difference_type>(char_last)
+		);
+		m_offsets.erase(
+			m_offsets.begin() + static_cast<difference_type>(first.m_idx),
+			m_offsets.begin() + static_cast<difference_type>(last.m_idx)
+		);
+		for (auto idx = first.m_idx; idx < size(); ++idx) m_offsets[idx] -= removed;
+		return first;
+	}
+
+	auto erase(const const_iterator pos)->iterator {
+		return erase(pos, pos + 1);
+	}
+
+	// removes every string for which pred(view) is true and returns the number removed, compacting the character
+	// buffer and offsets in a single pass
+	template<typename Pred>
+	auto erase_if(Pred&& pred)->size_type {
+		const auto count = size();
+		const auto data = m_chars.data();
+		size_type kept = 0;
+		size_type write = 0;
+
+		for (size_type idx = 0; idx < count; ++idx) {
+			const auto first = m_offsets[idx];
+			const auto last = end_of(idx);
+			if (pred(value_type(data + first, last - first))) continue;
+
+			if (write != first) std::copy(data + first, data + last, data + write);
+			m_offsets[kept++] = write;
+			write += last - first;
+		}
+
+		m_chars.erase(m_chars.begin() + static_cast<difference_type>(write), m_chars.end());
+		m_offsets.erase(m_offsets.begin() + static_cast<difference_type>(kept), m_offsets.end());
+		return count - kept;
+	}
+
+	auto clear() {
+		m_chars.clear();
+		m_offsets.clear();
+	}
+
+	auto swap(basic_string_vector& other) {
+		m_chars.swap(other.m_chars);
+		m_offsets.swap(other.m_offsets);
+	}
+
+private:
+	// reserves geometrically so that repeated bulk appends stay amortised O(1) per character
+	template<typename Storage>
+	static auto grow_to(Storage& storage, const size_type required) {
+		if (required > storage.capacity()) storage.reserve(std::max(required, storage.capacity() * 2));
+	}
+
+	// whether str starts within the character buffer, and so is moved along with it
+	[[nodiscard]] auto holds(const value_type str) const noexcept->bool {
+		return str.data() >= m_chars.data() && str.data() < m_chars.data() + m_chars.size();
+	}
+
+	[[nodiscard]] auto end_of(const size_type pos) const noexcept->size_type {
+		return pos + 1 < size() ? m_offsets[pos + 1] : m_chars.size();
+	}
+
+private:
+	Chars m_chars;
+	Offsets m_offsets;
+};
+
+using string_vector = basic_string_vector<vector<char>, vector<std::size_t>>;
+
+// string_vector keeping up to StaticChars characters and StaticCount strings inline
+template<std::size_t StaticChars = 256, std::size_t StaticCount = 32>
+using small_string_vector = basic_string_vector<small_vector<char, StaticChars>, small_vector<std::size_t, StaticCount>>;
+
+}
+
+#endif
\ No newline at end of file
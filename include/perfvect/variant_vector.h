@@ -0,0 +1,284 @@
+#ifndef PERFVECT_VARIANT_VECTOR_H
+#define PERFVECT_VARIANT_VECTOR_H
+
+#include "vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace perfvect {
+namespace detail {
+	template<typename T, typename... Ts>
+	struct alternative_index;
+
+	template<typename T, typename... Ts>
+	struct alternative_index<T, T, Ts...> : std::integral_constant<std::size_t, 0> {};
+
+	template<typename T, typename U, typename... Ts>
+	struct alternative_index<T, U, Ts...> : std::integral_constant<std::size_t, 1 + alternative_index<T, Ts...>::value> {};
+
+	template<typename T, typename... Ts>
+	constexpr auto alternative_index_v = alternative_index<T, Ts...>::value;
+
+	template<typename T, typename... Ts>
+	constexpr auto alternative_count_v = (std::size_t{std::is_same_v<T, Ts>} + ...);
+
+	// position of an element in insertion order: which column, and where in it
+	struct variant_slot {
+		std::uint32_t alternative;
+		std::uint32_t index;
+	};
+}
+
+enum class variant_order {
+	// an index records insertion order, enabling positional access
+	preserved,
+	// elements are only reachable column by column
+	discarded,
+};
+
+// sequence of values of types Ts..., stored in one homogeneous column per type rather than as padded std::variants
+// visit_batched() walks each column in turn, so the per-element work is monomorphic and free of dispatch
+template<variant_order Order, typename... Ts>
+class basic_variant_vector {
+	static_assert(sizeof...(Ts) > 0, "variant_vector needs at least one alternative");
+	static_assert(((detail::alternative_count_v<Ts, Ts...> == 1) && ...), "variant_vector alternatives must be unique");
+
+	static constexpr auto ordered = Order == variant_order::preserved;
+
+	using columns_t = std::tuple<vector<Ts>...>;
+	using indices_t = std::index_sequence_for<Ts...>;
+
+public:
+	using variant_type = std::variant<Ts...>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	template<typename T>
+	static constexpr auto index_of = detail::alternative_index_v<T, Ts...>;
+
+	static constexpr auto alternatives = sizeof...(Ts);
+
+public:
+	// element access, in insertion order
+
+	// index of the alternative held by the element at pos
+	template<variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	[[nodiscard]] auto index(const size_type pos) const noexcept->size_type {
+		return m_order[pos].alternative;
+	}
+
+	template<typename T, variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	[[nodiscard]] auto holds(const size_type pos) const noexcept->bool {
+		return m_order[pos].alternative == index_of<T>;
+	}
+
+	template<typename T, variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	[[nodiscard]] auto get_if(const size_type pos) noexcept->T* {
+		return holds<T>(pos) ? mutable_column<T>().data() + m_order[pos].index : nullptr;
+	}
+
+	template<typename T, variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	[[nodiscard]] auto get_if(const size_type pos) const noexcept->const T* {
+		return holds<T>(pos) ? column<T>().data() + m_order[pos].index : nullptr;
+	}
+
+	template<typename T, variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	[[nodiscard]] auto get(const size_type pos)->T& {
+		if (!holds<T>(pos)) throw std::bad_variant_access();
+		return mutable_column<T>()[m_order[pos].index];
+	}
+
+	template<typename T, variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	[[nodiscard]] auto get(const size_type pos) const->const T& {
+		if (!holds<T>(pos)) throw std::bad_variant_access();
+		return column<T>()[m_order[pos].index];
+	}
+
+	// calls func with the value at pos, as std::visit would
+	template<typename Func, variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	decltype(auto) visit(const size_type pos, Func&& func) {
+		return dispatch(*this, m_order[pos], func);
+	}
+
+	template<typename Func, variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	decltype(auto) visit(const size_type pos, Func&& func) const {
+		return dispatch(*this, m_order[pos], func);
+	}
+
+	template<variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	[[nodiscard]] auto to_variant(const size_type pos) const->variant_type {
+		return visit(pos, [](const auto& value) { return variant_type(value); });
+	}
+
+	// calls func(value) for every element in insertion order, dispatching per element
+	template<typename Func, variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	auto visit_ordered(Func&& func) {
+		for (const auto slot : m_order) dispatch(*this, slot, func);
+	}
+
+	template<typename Func, variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	auto visit_ordered(Func&& func) const {
+		for (const auto slot : m_order) dispatch(*this, slot, func);
+	}
+
+	// columns
+
+	// every value holding T, in the order they were added
+	template<typename T>
+	[[nodiscard]] auto column() const noexcept->const vector<T>& {
+		return std::get<index_of<T>>(m_columns);
+	}
+
+	template<typename T>
+	[[nodiscard]] auto count() const noexcept->size_type {
+		return column<T>().size();
+	}
+
+	// calls func(value) for every element, one whole column at a time in the order of Ts
+	template<typename Func>
+	auto visit_batched(Func&& func) {
+		std::apply([&func](auto&... columns) {
+			(..., [&func](auto& column) { for (auto& value : column) func(value); }(columns));
+		}, m_columns);
+	}
+
+	template<typename Func>
+	auto visit_batched(Func&& func) const {
+		std::apply([&func](const auto&... columns) {
+			(..., [&func](const auto& column) { for (const auto& value : column) func(value); }(columns));
+		}, m_columns);
+	}
+
+	// calls func(T* data, size_type count) once per alternative, in the order of Ts
+	template<typename Func>
+	auto for_each_column(Func&& func) {
+		std::apply([&func](auto&... columns) { (..., func(columns.data(), columns.size())); }, m_columns);
+	}
+
+	template<typename Func>
+	auto for_each_column(Func&& func) const {
+		std::apply([&func](const auto&... columns) { (..., func(columns.data(), columns.size())); }, m_columns);
+	}
+
+	// capacity
+
+	[[nodiscard]] auto size() const noexcept->size_type {
+		if constexpr (ordered) return m_order.size();
+		else return std::apply([](const auto&... columns) { return (columns.size() + ...); }, m_columns);
+	}
+
+	[[nodiscard]] auto empty() const noexcept->bool {
+		return size() == 0;
+	}
+
+	template<typename T>
+	auto reserve(const size_type new_cap) {
+		mutable_column<T>().reserve(new_cap);
+	}
+
+	// reserves room for count elements across all columns in insertion order
+	template<variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	auto reserve_order(const size_type count) {
+		m_order.reserve(count);
+	}
+
+	// modifiers
+
+	template<typename T, typename... Args>
+	auto& emplace_back(Args&&... args) {
+		auto& col = mutable_column<T>();
+		if constexpr (ordered) {
+			m_order.push_back({static_cast<std::uint32_t>(index_of<T>), static_cast<std::uint32_t>(col.size())});
+			try {
+				return col.emplace_back(std::forward<Args>(args)...);
+			}
+			catch (...) {
+				m_order.pop_back();
+				throw;
+			}
+		}
+		else {
+			return col.emplace_back(std::forward<Args>(args)...);
+		}
+	}
+
+	template<typename T, typename = std::enable_if_t<(detail::alternative_count_v<std::decay_t<T>, Ts...> == 1)>>
+	auto push_back(T&& value) {
+		emplace_back<std::decay_t<T>>(std::forward<T>(value));
+	}
+
+	auto push_back(const variant_type& value) {
+		std::visit([this](const auto& alt) { emplace_back<std::decay_t<decltype(alt)>>(alt); }, value);
+	}
+
+	auto push_back(variant_type&& value) {
+		std::visit([this](auto&& alt) { emplace_back<std::decay_t<decltype(alt)>>(std::move(alt)); }, value);
+	}
+
+	// removes the most recently added element
+	template<variant_order O = Order, typename = std::enable_if_t<O == variant_order::preserved>>
+	auto pop_back() {
+		pop_column(m_order[m_order.size() - 1].alternative, indices_t{});
+		m_order.pop_back();
+	}
+
+	auto clear() {
+		std::apply([](auto&... columns) { (..., columns.clear()); }, m_columns);
+		if constexpr (ordered) m_order.clear();
+	}
+
+	auto swap(basic_variant_vector& other) {
+		swap_columns(other, indices_t{});
+		if constexpr (ordered) m_order.swap(other.m_order);
+	}
+
+private:
+	template<typename T>
+	[[nodiscard]] auto mutable_column() noexcept->vector<T>& {
+		return std::get<index_of<T>>(m_columns);
+	}
+
+	// chain of comparisons against each alternative, which the compiler can inline into the caller's loop unlike a
+	// jump table of function pointers
+	template<std::size_t I = 0, typename Self, typename Func>
+	static decltype(auto) dispatch(Self& self, const detail::variant_slot slot, Func& func) {
+		if constexpr (I + 1 == sizeof...(Ts)) {
+			return func(std::get<I>(self.m_columns)[slot.index]);
+		}
+		else {
+			if (slot.alternative == I) return func(std::get<I>(self.m_columns)[slot.index]);
+			return dispatch<I + 1>(self, slot, func);
+		}
+	}
+
+	template<std::size_t... Is>
+	auto swap_columns(basic_variant_vector& other, std::index_sequence<Is...>) {
+		(..., std::get<Is>(m_columns).swap(std::get<Is>(other.m_columns)));
+	}
+
+	template<std::size_t... Is>
+	auto pop_column(const std::uint32_t alternative, std::index_sequence<Is...>) {
+		(..., (alternative == Is ? std::get<Is>(m_columns).pop_back() : void()));
+	}
+
+private:
+	columns_t m_columns;
+	std::conditional_t<ordered, vector<detail::variant_slot>, std::tuple<>> m_order;
+};
+
+// columnar variant vector preserving insertion order
+template<typename... Ts>
+using variant_vector = basic_variant_vector<variant_order::preserved, Ts...>;
+
+// columnar variant vector without the order index, saving eight bytes per element
+template<typename... Ts>
+using unordered_variant_vector = basic_variant_vector<variant_order::discarded, Ts...>;
+
+}
+
+#endif
\ No newline at end of file
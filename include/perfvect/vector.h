@@ -1,13 +1,35 @@
 #ifndef PERFVECT_VECTOR_BASE_H
 #define PERFVECT_VECTOR_BASE_H
+#include "dedup.h"
+#include "hash.h"
 #include "iterator.h"
+#include "parallel.h"
+#include "simd.h"
+#include "sort.h"
 #include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <memory_resource>
+#include <utility>
 #include <variant>
 
 namespace perfvect {
+// element-wise arithmetic expression of numeric.h, which the containers' operator= evaluates into their storage
+template<typename Op, typename L, typename R>
+class numeric_expr;
+
 namespace detail {
+	// extent of a numeric_expr none of whose operands has a compile-time bound on its size
+	inline constexpr std::size_t unbounded_extent = std::numeric_limits<std::size_t>::max();
+
+	template<typename Expr, typename T>
+	inline constexpr bool is_numeric_expr_of_v = false;
+
+	template<typename Op, typename L, typename R, typename T>
+	inline constexpr bool is_numeric_expr_of_v<numeric_expr<Op, L, R>, T> = std::is_same_v<typename numeric_expr<Op, L, R>::value_type, T>;
+
 	template<typename Allocator>
 	struct vector_dynamic_allocator {
 		Allocator allocator;
@@ -66,6 +88,13 @@ public:
 		return *this;
 	}
 
+	// evaluates an element-wise expression of numeric.h in a single pass, taking on its size
+	template<typename Expr, typename = std::enable_if_t<detail::is_numeric_expr_of_v<Expr, T>>>
+	auto& operator=(const Expr& expr) {
+		assign_expression<detail::unbounded_extent>(expr);
+		return *this;
+	}
+
 	constexpr auto assign(size_type count, const value_type& value) {
 		if (m_size > count) destroy(count);
 		std::fill_n(data(), m_size, value);
@@ -186,6 +215,98 @@ public:
 		return rend();
 	}
 
+	// search
+	// arithmetic and enum elements are compared with SIMD kernels picked for the running CPU, others with std::find
+
+	[[nodiscard]] auto find(const value_type& value)->iterator {
+		return begin() + static_cast<difference_type>(find_index(value));
+	}
+
+	[[nodiscard]] auto find(const value_type& value) const->const_iterator {
+		return begin() + static_cast<difference_type>(find_index(value));
+	}
+
+	[[nodiscard]] auto contains(const value_type& value) const->bool {
+		return find_index(value) != m_size;
+	}
+
+	[[nodiscard]] auto count(const value_type& value) const->size_type {
+		if constexpr (detail::is_simd_searchable_v<T>) {
+			return detail::count_eq(data(), m_size, value);
+		}
+		else {
+			return static_cast<size_type>(std::count(data(), data() + m_size, value));
+		}
+	}
+
+	// first element equal to any of values
+	[[nodiscard]] auto find_if_eq_any(const_pointer values, const size_type value_count)->iterator {
+		return begin() + static_cast<difference_type>(find_any_index(values, value_count));
+	}
+
+	[[nodiscard]] auto find_if_eq_any(const_pointer values, const size_type value_count) const->const_iterator {
+		return begin() + static_cast<difference_type>(find_any_index(values, value_count));
+	}
+
+	[[nodiscard]] auto find_if_eq_any(std::initializer_list<value_type> values)->iterator {
+		return find_if_eq_any(values.begin(), values.size());
+	}
+
+	[[nodiscard]] auto find_if_eq_any(std::initializer_list<value_type> values) const->const_iterator {
+		return find_if_eq_any(values.begin(), values.size());
+	}
+
+	// sorting
+	// arithmetic elements go through a sorting network up to 64 elements and an LSD radix sort from a few hundred,
+	// anything else through std::sort; the radix sort's scratch buffer comes from the container's allocator, or the
+	// default memory resource where there is none
+
+	// sorts the elements ascending by operator<
+	auto sort() {
+		detail::sort_values(data(), m_size, std::pmr::polymorphic_allocator<T>{});
+	}
+
+	// sorts the elements ascending by proj(element); not stable
+	template<typename Proj>
+	auto sort_by_key(Proj proj) {
+		detail::sort_values_by_key(data(), m_size, proj, std::pmr::polymorphic_allocator<T>{});
+	}
+
+	// deduplication
+	// the kept elements are moved down into place in a single pass, each at most once; the hash table of the unordered
+	// forms is kept on the stack for up to 128 elements, and otherwise taken from the container's allocator, or the
+	// default memory resource where there is none
+
+	// removes all but the first of each run of equal elements, which leaves sorted elements without repeats; returns
+	// the number removed
+	auto dedup()->size_type {
+		return dedup_by(detail::identity_projection{});
+	}
+
+	// removes all but the first of each run of elements with equal proj(element)
+	template<typename Proj>
+	auto dedup_by(Proj proj)->size_type {
+		const auto kept = static_cast<size_type>(detail::dedup_adjacent(data(), m_size, proj));
+		const auto removed = m_size - kept;
+		destroy(kept);
+		return removed;
+	}
+
+	// removes all but the first of the elements equal to each other, wherever they are, keeping the order of the rest
+	// in O(size()); the elements need a std::hash
+	auto dedup_unordered()->size_type {
+		return dedup_unordered_by(detail::identity_projection{});
+	}
+
+	// removes all but the first of the elements with equal proj(element), whose type needs a std::hash
+	template<typename Proj>
+	auto dedup_unordered_by(Proj proj)->size_type {
+		const auto kept = static_cast<size_type>(detail::dedup_unordered(data(), m_size, proj, std::pmr::polymorphic_allocator<T>{}));
+		const auto removed = m_size - kept;
+		destroy(kept);
+		return removed;
+	}
+
 	// capacity
 
 	[[nodiscard]] constexpr auto capacity() const noexcept {
@@ -232,6 +353,88 @@ public:
 		return last;
 	}
 
+	// removes every element for which pred(element) is true in a single pass, keeping the order of the rest, and
+	// returns the number removed; trivially copyable elements go through the stream compaction kernel
+	template<typename Pred>
+	auto erase_if(Pred pred)->size_type {
+		size_type kept;
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			kept = detail::compact_if(data(), m_size, pred);
+		}
+		else {
+			kept = static_cast<size_type>(std::remove_if(begin(), end(), pred) - begin());
+		}
+		const auto removed = m_size - kept;
+		destroy(kept);
+		return removed;
+	}
+
+	// removes the elements at the given positions, which must be ascending and in range (repeats are ignored), moving
+	// each run of survivors down once; returns the number removed
+	auto erase_indices(const size_type* indices, const size_type count)->size_type {
+		if (!count) return 0;
+
+		auto write = indices[0];
+		auto read = indices[0];
+		for (size_type idx = 0; idx < count; ++idx) {
+			const auto pos = indices[idx];
+			if (pos < read) continue;
+			move_down(read, pos, write);
+			write += pos - read;
+			read = pos + 1;
+		}
+		move_down(read, m_size, write);
+		write += m_size - read;
+
+		const auto removed = m_size - write;
+		destroy(write);
+		return removed;
+	}
+
+	auto erase_indices(std::initializer_list<size_type> indices)->size_type {
+		return erase_indices(indices.begin(), indices.size());
+	}
+
+	// unordered erasure: holes are filled by moving elements in from the end, which costs O(removed) instead of
+	// O(size) but does not keep the order of the remaining elements
+
+	// replaces the element at pos with the last one
+	auto erase_unordered(const_iterator pos)->iterator {
+		const auto idx = static_cast<size_type>(iterator_offset(pos));
+		if (idx != m_size - 1) data()[idx] = std::move(data()[m_size - 1]);
+		destroy(m_size - 1);
+		return begin() + static_cast<difference_type>(idx);
+	}
+
+	// fills [first, last) with elements from the end, taking only those after last when fewer remain than were removed
+	auto erase_unordered(const_iterator first, const_iterator last)->iterator {
+		const auto from = static_cast<size_type>(iterator_offset(first));
+		const auto to = static_cast<size_type>(iterator_offset(last));
+		const auto count = to - from;
+		if (!count) return begin() + static_cast<difference_type>(from);
+
+		const auto source = std::max(to, m_size - count);
+		std::move(data() + source, data() + m_size, data() + from);
+		destroy(m_size - count);
+		return begin() + static_cast<difference_type>(from);
+	}
+
+	// removes every element for which pred(element) is true, evaluating pred once per element, and returns the number
+	// removed
+	template<typename Pred>
+	auto erase_unordered_if(Pred pred)->size_type {
+		const auto old_size = m_size;
+		for (size_type idx = 0; idx < m_size;) {
+			if (!pred(std::as_const(data()[idx]))) {
+				++idx;
+				continue;
+			}
+			if (idx != m_size - 1) data()[idx] = std::move(data()[m_size - 1]);
+			destroy(m_size - 1);
+		}
+		return old_size - m_size;
+	}
+
 	template<typename... Args>
 	auto& emplace_back(Args&&... args) {
 		return *construct(m_size++, std::forward<Args>(args)...);
@@ -245,6 +448,23 @@ public:
 		emplace_back(std::move(val));
 	}
 
+	// appends trivially copyable elements written by fill(pointer) straight into the storage after the last element,
+	// skipping per-element capacity checks; the capacity must already hold max_count more elements, and fill returns
+	// how many of them it wrote
+	template<typename Fill>
+	auto append_unchecked(const size_type max_count, Fill&& fill)->size_type {
+		static_assert(std::is_trivially_copyable_v<T>, "append_unchecked needs trivially copyable elements");
+		#if _DEBUG
+		if (m_capacity - m_size < max_count)
+			throw std::length_error("vector_base capacity exceeded on append_unchecked");
+		#endif
+		(void)max_count;
+
+		const auto written = static_cast<size_type>(fill(m_data + m_size));
+		m_size += written;
+		return written;
+	}
+
 	template<typename... Args>
 	auto emplace(const_iterator pos, Args&& ... args)->iterator {
 		emplace_back(std::forward<Args>(args)...);
@@ -283,6 +503,13 @@ public:
 		reallocate_at_least(count);
 		insert(end(), count - m_size, value);
 	}
+
+	// grows without value-initializing the new elements, leaving trivial types with indeterminate values
+	constexpr auto resize_default_init(size_type count) {
+		if (count <= m_size) return resize(count);
+		std::uninitialized_default_construct_n(end(), count - m_size);
+		m_size = count;
+	}
 	
 protected:
 	constexpr auto swap(static_vector_base& other) noexcept(std::is_nothrow_swappable_v<T>) {
@@ -315,6 +542,19 @@ protected:
 	}
 
 protected:
+	// writes the result of expr over the storage, which must already hold it; Extent bounds the capacity at compile
+	// time where it is fixed, letting expressions over operands of the same bound be fully unrolled
+	template<std::size_t Extent, typename Expr>
+	auto assign_expression(const Expr& expr) {
+		const auto count = expr.size();
+		#if _DEBUG
+		if (count > m_capacity)
+			throw std::length_error("vector_base capacity exceeded on expression assignment");
+		#endif
+		expr.template evaluate_into<Extent>(m_data);
+		m_size = count;
+	}
+
 	template<typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
 	constexpr auto assign_hint(const size_type count, const InputIt first, const InputIt last) {
 		const auto assign_count = count < m_size ? count : m_size;
@@ -368,6 +608,35 @@ protected:
 		return std::rotate(iterator_const_cast(to), end() - count, end()) - count;
 	}
 
+	// moves [first, last) down to start at dest, which is not after first
+	auto move_down(const size_type first, const size_type last, const size_type dest) {
+		if (first == last || first == dest) return;
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			std::memmove(static_cast<void*>(data() + dest), data() + first, (last - first) * sizeof(T));
+		}
+		else {
+			std::move(data() + first, data() + last, data() + dest);
+		}
+	}
+
+	[[nodiscard]] auto find_index(const value_type& value) const->size_type {
+		if constexpr (detail::is_simd_searchable_v<T>) {
+			return detail::find_eq(data(), m_size, value);
+		}
+		else {
+			return static_cast<size_type>(std::find(data(), data() + m_size, value) - data());
+		}
+	}
+
+	[[nodiscard]] auto find_any_index(const_pointer values, const size_type value_count) const->size_type {
+		if constexpr (detail::is_simd_searchable_v<T>) {
+			return detail::find_eq_any(data(), m_size, values, value_count);
+		}
+		else {
+			return static_cast<size_type>(std::find_first_of(data(), data() + m_size, values, values + value_count) - data());
+		}
+	}
+
 	constexpr auto get_address(const size_type idx)->pointer {
 		return std::launder(reinterpret_cast<pointer>(std::addressof(m_data[idx])));
 	}
@@ -413,6 +682,64 @@ protected:
 	size_type m_size = 0;
 };
 
+namespace detail {
+	// element types whose == is equality of their bytes
+	template<typename T>
+	inline constexpr bool is_bytewise_comparable_v = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+}
+
+// comparisons, between any two of static_vector, small_vector and vector of the same element type regardless of
+// capacity; sizes are compared first, then integral elements with memcmp and floating point ones with the SIMD
+// mismatch kernel
+
+template<typename T>
+[[nodiscard]] auto operator==(const static_vector_base<T>& lhs, const static_vector_base<T>& rhs)->bool {
+	if (lhs.size() != rhs.size()) return false;
+	if (lhs.empty()) return true;
+	if constexpr (detail::is_bytewise_comparable_v<T>) {
+		return std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0;
+	}
+	else if constexpr (detail::is_simd_searchable_v<T>) {
+		return detail::mismatch(lhs.data(), rhs.data(), lhs.size()) == lhs.size();
+	}
+	else {
+		return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+}
+
+template<typename T>
+[[nodiscard]] auto operator!=(const static_vector_base<T>& lhs, const static_vector_base<T>& rhs)->bool {
+	return !(lhs == rhs);
+}
+
+// lexicographical, like std::vector; integral elements skip straight to the first mismatch
+template<typename T>
+[[nodiscard]] auto operator<(const static_vector_base<T>& lhs, const static_vector_base<T>& rhs)->bool {
+	if constexpr (detail::is_bytewise_comparable_v<T> && detail::is_simd_searchable_v<T>) {
+		const auto common = std::min(lhs.size(), rhs.size());
+		const auto pos = common ? detail::mismatch(lhs.data(), rhs.data(), common) : 0;
+		return pos == common ? lhs.size() < rhs.size() : lhs.data()[pos] < rhs.data()[pos];
+	}
+	else {
+		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+}
+
+template<typename T>
+[[nodiscard]] auto operator>(const static_vector_base<T>& lhs, const static_vector_base<T>& rhs)->bool {
+	return rhs < lhs;
+}
+
+template<typename T>
+[[nodiscard]] auto operator<=(const static_vector_base<T>& lhs, const static_vector_base<T>& rhs)->bool {
+	return !(rhs < lhs);
+}
+
+template<typename T>
+[[nodiscard]] auto operator>=(const static_vector_base<T>& lhs, const static_vector_base<T>& rhs)->bool {
+	return !(lhs < rhs);
+}
+
 template<typename T, typename Allocator = std::pmr::polymorphic_allocator<T>>
 class vector : public static_vector_base<T> {
 	using base_t = static_vector_base<T>;
@@ -469,6 +796,15 @@ public:
 		this->assign_hint(other.size(), other.cbegin(), other.cend());
 	}
 
+	// copies other with the workers of policy, each constructing (and so first touching) its own chunk
+	vector(const parallel_policy& policy, const vector& other) : vector() {
+		reallocate_at_least(other.size());
+		const auto src = other.data();
+		append_parallel(policy, other.size(), [src](const pointer dest, const size_type first, const size_type last) {
+			std::uninitialized_copy(src + first, src + last, dest);
+		});
+	}
+
 	template<typename Alloc = Allocator>
 	constexpr vector(vector<T, Alloc>&& other) noexcept : vector() {
 		reallocate_at_least(other.size());
@@ -505,6 +841,13 @@ public:
 		return *this;
 	}
 
+	template<typename Expr, typename = std::enable_if_t<detail::is_numeric_expr_of_v<Expr, T>>>
+	auto& operator=(const Expr& expr) {
+		reallocate_at_least(expr.size());
+		this->template assign_expression<detail::unbounded_extent>(expr);
+		return *this;
+	}
+
 	constexpr auto assign(size_type count, const value_type& value) {
 		reallocate_at_least(count);
 		base_t::assign_hint(count, value);
@@ -523,6 +866,62 @@ public:
 		base_t::assign_hint(count, ilist.begin(), ilist.end());
 	}
 
+	// parallel bulk operations
+	// overloads taking a parallel_policy (perfvect::par for the default pool) split their range into a contiguous chunk
+	// per worker; storage they allocate is first written by the workers, so first-touch NUMA placement puts each chunk's
+	// pages near the worker that gets the same chunk in later operations on a range of the same size
+	// a throwing element constructor leaves no partially built elements behind: the vector keeps its elements up to
+	// where the operation started writing new ones
+
+	// replaces the elements with count copies of value; when the capacity must grow the old elements are destroyed
+	// first, so the new storage is written only by the workers
+	auto assign(const parallel_policy& policy, const size_type count, const value_type& value) {
+		if (count > this->m_capacity) {
+			destroy_parallel(policy, 0);
+			reallocate_at_least(count);
+		}
+		const auto assigned = std::min(count, this->m_size);
+		detail::parallel_for(policy, assigned, [this, &value](const size_type first, const size_type last) {
+			std::fill(this->data() + first, this->data() + last, value);
+		});
+		if (count < this->m_size) destroy_parallel(policy, count);
+		else append_parallel(policy, count - this->m_size, [&value](const pointer dest, const size_type first, const size_type last) {
+			std::uninitialized_fill(dest, dest + (last - first), value);
+		});
+	}
+
+	using base_t::fill;
+
+	// fills the whole capacity with value, like fill(value)
+	auto fill(const parallel_policy& policy, const value_type& value) {
+		assign(policy, this->m_capacity, value);
+	}
+
+	// sorting, with radix sort scratch taken from this vector's allocator
+
+	auto sort() {
+		detail::sort_values(this->data(), this->size(), m_alloc.allocator);
+	}
+
+	template<typename Proj>
+	auto sort_by_key(Proj proj) {
+		detail::sort_values_by_key(this->data(), this->size(), proj, m_alloc.allocator);
+	}
+
+	// unordered deduplication, with a hash table too large for the stack taken from this vector's allocator
+
+	auto dedup_unordered()->size_type {
+		return dedup_unordered_by(detail::identity_projection{});
+	}
+
+	template<typename Proj>
+	auto dedup_unordered_by(Proj proj)->size_type {
+		const auto kept = static_cast<size_type>(detail::dedup_unordered(this->data(), this->m_size, proj, m_alloc.allocator));
+		const auto removed = this->m_size - kept;
+		this->destroy(kept);
+		return removed;
+	}
+
 	// capacity
 
 	[[nodiscard]] constexpr auto is_static() const noexcept->bool {
@@ -606,6 +1005,90 @@ public:
 		return base_t::resize(count, value);
 	}
 
+	constexpr auto resize_default_init(size_type count) {
+		reallocate_at_least(count);
+		return base_t::resize_default_init(count);
+	}
+
+	// grows by relocating the existing elements and value-initializing the new ones in parallel
+	auto resize(const parallel_policy& policy, const size_type count) {
+		if (count <= this->m_size) return destroy_parallel(policy, count);
+		reserve_parallel(policy, count);
+		append_parallel(policy, count - this->m_size, [](const pointer dest, const size_type first, const size_type last) {
+			std::uninitialized_value_construct(dest, dest + (last - first));
+		});
+	}
+
+	auto resize(const parallel_policy& policy, const size_type count, const value_type& value) {
+		if (count <= this->m_size) return destroy_parallel(policy, count);
+		reserve_parallel(policy, count);
+		append_parallel(policy, count - this->m_size, [&value](const pointer dest, const size_type first, const size_type last) {
+			std::uninitialized_fill(dest, dest + (last - first), value);
+		});
+	}
+
+	// inserts copies of the random access range [first, last) before pos; trivially copyable elements have the tail
+	// moved up once and the range copied into the gap in parallel, others are appended in parallel and rotated into
+	// place
+	template<typename Iter, typename = std::enable_if_t<detail::is_iterator_v<Iter>>>
+	auto insert_range(const parallel_policy& policy, const_iterator pos, Iter first, Iter last)->iterator {
+		static_assert(
+			std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>,
+			"parallel insert_range needs random access iterators"
+		);
+		const auto count = static_cast<size_type>(std::distance(first, last));
+		const auto offset = static_cast<size_type>(this->iterator_offset(pos));
+		reserve_parallel(policy, this->m_size + count);
+
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			const auto gap = this->data() + offset;
+			std::memmove(static_cast<void*>(gap + count), gap, (this->m_size - offset) * sizeof(T));
+			detail::parallel_for(policy, count, [gap, first](const size_type from, const size_type to) {
+				std::copy(first + static_cast<difference_type>(from), first + static_cast<difference_type>(to), gap + from);
+			});
+			this->m_size += count;
+			return this->begin() + static_cast<difference_type>(offset);
+		}
+		else {
+			append_parallel(policy, count, [first](const pointer dest, const size_type from, const size_type to) {
+				std::uninitialized_copy(first + static_cast<difference_type>(from), first + static_cast<difference_type>(to), dest);
+			});
+			return this->rotate_inserted_to(count, this->cbegin() + static_cast<difference_type>(offset));
+		}
+	}
+
+	using base_t::erase_if;
+
+	// removes every element for which pred(element) is true, keeping the order of the rest: each worker compacts its
+	// own chunk, then the compacted chunks are moved down into place in order; pred is called concurrently
+	template<typename Pred>
+	auto erase_if(const parallel_policy& policy, Pred pred)->size_type {
+		const auto count = this->m_size;
+		if (!count) return 0;
+		const auto workers = policy.workers_for(count);
+		const auto kept = std::make_unique<size_type[]>(workers);
+		policy.pool().run(workers, [&](const unsigned worker) {
+			const auto bounds = detail::chunk_of(count, workers, worker);
+			const auto chunk = this->data() + bounds.first;
+			if constexpr (std::is_trivially_copyable_v<T>) {
+				kept[worker] = detail::compact_if(chunk, bounds.second - bounds.first, pred);
+			}
+			else {
+				kept[worker] = static_cast<size_type>(std::remove_if(chunk, this->data() + bounds.second, pred) - chunk);
+			}
+		});
+
+		// every chunk lands at or before its own start, so moving them in order never overwrites one not yet moved
+		auto write = kept[0];
+		for (auto worker = 1u; worker < workers; ++worker) {
+			const auto first = detail::chunk_of(count, workers, worker).first;
+			this->move_down(first, first + kept[worker], write);
+			write += kept[worker];
+		}
+		destroy_parallel(policy, write);
+		return count - write;
+	}
+
 	auto push_back(const value_type& val) {
 		emplace_back(val);
 	}
@@ -686,6 +1169,48 @@ protected:
 		set_alloc(mem, new_cap);
 	}
 
+	// grows the capacity like reallocate_at_least, relocating the elements with the workers of policy
+	auto reserve_parallel(const parallel_policy& policy, const size_type count) {
+		if (count <= this->m_capacity) return;
+		const auto calc_cap = this->m_capacity * 2;
+		auto new_cap = calc_cap > count ? calc_cap : count;
+
+		const auto use_static = m_alloc.staticCap >= new_cap;
+		if (!use_static) new_cap = std::max(new_cap, m_alloc.dynamicMinCap);
+		const auto mem = use_static ? m_alloc.staticStorage : m_alloc.allocator.allocate(new_cap);
+		if (use_static) new_cap = m_alloc.staticCap;
+
+		const auto src = this->data();
+		try {
+			detail::parallel_construct(policy, mem, this->m_size, [src](const pointer dest, const size_type first, const size_type last) {
+				if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+					std::uninitialized_move(src + first, src + last, dest);
+				else
+					std::uninitialized_copy(src + first, src + last, dest);
+			});
+		}
+		catch (...) {
+			if (!use_static) m_alloc.allocator.deallocate(mem, new_cap);
+			throw;
+		}
+
+		detail::parallel_destroy(policy, src, this->m_size);
+		if (!is_static()) m_alloc.allocator.deallocate(this->m_data, this->m_capacity);
+		set_alloc(mem, new_cap);
+	}
+
+	// constructs count elements after the last with construct(dest, first, last) per chunk
+	template<typename Construct>
+	auto append_parallel(const parallel_policy& policy, const size_type count, Construct&& construct) {
+		detail::parallel_construct(policy, this->data() + this->m_size, count, construct);
+		this->m_size += count;
+	}
+
+	auto destroy_parallel(const parallel_policy& policy, const size_type from) {
+		detail::parallel_destroy(policy, this->data() + from, this->m_size - from);
+		this->m_size = from;
+	}
+
 	auto set_alloc(T* const mem, const size_type cap) {
 		this->m_data = mem;
 		this->m_capacity = cap;
@@ -697,4 +1222,21 @@ protected:
 
 }
 
+// hashes the elements, bytewise for the types operator== compares bytewise and with std::hash of each element
+// otherwise, so equal vectors of any capacity hash equally
+template<typename T>
+struct std::hash<perfvect::static_vector_base<T>> {
+	[[nodiscard]] auto operator()(const perfvect::static_vector_base<T>& vec) const noexcept->std::size_t {
+		if constexpr (perfvect::detail::is_bytewise_comparable_v<T>) {
+			return static_cast<std::size_t>(perfvect::detail::hash_bytes(vec.data(), vec.size() * sizeof(T)));
+		}
+		else {
+			return static_cast<std::size_t>(perfvect::detail::hash_elements(vec.data(), vec.size()));
+		}
+	}
+};
+
+template<typename T, typename Allocator>
+struct std::hash<perfvect::vector<T, Allocator>> : std::hash<perfvect::static_vector_base<T>> {};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "catch.hpp"
+#include <perfvect/bitvector.h>
+
+using namespace perfvect;
+
+TEST_CASE("static_bitvector(), static_bitvector::size(), static_bitvector::capacity()") {
+	static_bitvector<100> bits;
+	CHECK(bits.size() == 0);
+	CHECK(bits.empty());
+	CHECK(bits.capacity() == 128);
+	CHECK(bits.num_words() == 0);
+}
+
+TEST_CASE("static_bitvector(size_type, bool)") {
+	SECTION("unset") {
+		static_bitvector<100> bits(70);
+		CHECK(bits.size() == 70);
+		CHECK(bits.num_words() == 2);
+		CHECK(bits.none());
+	}
+
+	SECTION("set") {
+		static_bitvector<100> bits(70, true);
+		CHECK(bits.all());
+		CHECK(bits.count() == 70);
+		CHECK(bits.word_data()[1] == 0x3Fu);
+	}
+}
+
+TEST_CASE("static_bitvector(std::initializer_list)") {
+	static_bitvector<8> bits{true, false, true};
+	REQUIRE(bits.size() == 3);
+	CHECK(bits[0]);
+	CHECK(!bits[1]);
+	CHECK(bits[2]);
+	CHECK(bits.word_data()[0] == 0b101u);
+}
+
+TEST_CASE("basic_bitvector::test(size_type)") {
+	static_bitvector<8> bits{true, false};
+	CHECK(bits.test(0));
+	CHECK(!bits.test(1));
+	CHECK_THROWS_AS(bits.test(2), std::out_of_range);
+}
+
+TEST_CASE("basic_bitvector::set(), basic_bitvector::reset(), basic_bitvector::flip()") {
+	small_bitvector<64> bits(130);
+
+	SECTION("single bits") {
+		bits.set(3).set(64).set(129);
+		CHECK(bits.count() == 3);
+		bits.reset(64);
+		CHECK(!bits[64]);
+		bits.flip(0);
+		CHECK(bits[0]);
+		CHECK(bits.count() == 3);
+	}
+
+	SECTION("all bits") {
+		bits.set();
+		CHECK(bits.count() == 130);
+		bits.flip();
+		CHECK(bits.none());
+		bits.flip();
+		CHECK(bits.all());
+		bits.reset();
+		CHECK(bits.none());
+	}
+
+	SECTION("through reference") {
+		bits[5] = true;
+		bits[6] = bits[5];
+		CHECK(bits[6]);
+		CHECK(~bits[7]);
+	}
+}
+
+TEST_CASE("basic_bitvector::push_back(bool), basic_bitvector::pop_back()") {
+	SECTION("static variant") {
+		static_bitvector<128> bits;
+		for (auto i = 0; i < 100; ++i) bits.push_back(i % 3 == 0);
+		CHECK(bits.size() == 100);
+		CHECK(bits.count() == 34);
+		bits.pop_back();
+		CHECK(bits.size() == 99);
+		CHECK(bits.count() == 33);
+	}
+
+	SECTION("small variant moves to dynamic storage") {
+		small_bitvector<64> bits;
+		for (auto i = 0; i < 64; ++i) bits.push_back(true);
+		CHECK(bits.capacity() == 64);
+		bits.push_back(true);
+		CHECK(bits.capacity() >= 128);
+		CHECK(bits.size() == 65);
+		CHECK(bits.all());
+	}
+}
+
+TEST_CASE("basic_bitvector::resize(size_type, bool)") {
+	small_bitvector<64> bits(10);
+	bits.resize(200, true);
+	CHECK(bits.count() == 190);
+	CHECK(!bits[9]);
+	CHECK(bits[10]);
+	bits.resize(5, true);
+	CHECK(bits.none());
+	bits.resize(70);
+	CHECK(bits.none());
+}
+
+TEST_CASE("basic_bitvector::find_first(), basic_bitvector::find_next(size_type)") {
+	small_bitvector<64> bits(300);
+
+	SECTION("empty") {
+		CHECK(bits.find_first() == bits.npos);
+		CHECK(small_bitvector<64>().find_first() == bits.npos);
+	}
+
+	SECTION("iterate set bits") {
+		bits.set(0).set(63).set(64).set(200).set(299);
+		std::vector<std::size_t> found;
+		for (auto pos = bits.find_first(); pos != bits.npos; pos = bits.find_next(pos)) {
+			found.push_back(pos);
+		}
+		CHECK(found == std::vector<std::size_t>{0, 63, 64, 200, 299});
+	}
+}
+
+TEST_CASE("basic_bitvector bulk bitwise operations") {
+	small_bitvector<64> lhs(130);
+	static_bitvector<128> rhs(70);
+	lhs.set(1).set(2).set(100);
+	rhs.set(2).set(3).set(69);
+
+	SECTION("operator&=") {
+		lhs &= rhs;
+		CHECK(lhs.count() == 1);
+		CHECK(lhs[2]);
+	}
+
+	SECTION("operator|=") {
+		lhs |= rhs;
+		CHECK(lhs.count() == 5);
+		CHECK(lhs[69]);
+		CHECK(lhs[100]);
+	}
+
+	SECTION("operator^=") {
+		lhs ^= rhs;
+		CHECK(lhs.count() == 4);
+		CHECK(!lhs[2]);
+	}
+
+	SECTION("subtract") {
+		lhs.subtract(rhs);
+		CHECK(lhs.count() == 2);
+		CHECK(lhs[1]);
+		CHECK(lhs[100]);
+	}
+
+	SECTION("longer operand does not set bits past size") {
+		rhs.set();
+		static_bitvector<128> shorter(10);
+		shorter |= rhs;
+		CHECK(shorter.count() == 10);
+	}
+}
+
+TEST_CASE("basic_bitvector::operator==") {
+	small_bitvector<64> lhs{true, false, true};
+	static_bitvector<64> rhs{true, false, true};
+	CHECK(lhs == rhs);
+	rhs.push_back(false);
+	CHECK(lhs != rhs);
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/concurrent_vector.h>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace perfvect;
+
+TEST_CASE("concurrent_vector(), concurrent_vector::size(), concurrent_vector::empty()") {
+	concurrent_vector<int> vec;
+	CHECK(vec.size() == 0);
+	CHECK(vec.empty());
+	CHECK(vec.begin() == vec.end());
+}
+
+TEST_CASE("concurrent_vector::push_back(const T&), concurrent_vector::emplace_back()") {
+	concurrent_vector<int> vec;
+
+	SECTION("returns index") {
+		CHECK(vec.push_back(5) == 0);
+		CHECK(vec.push_back(6) == 1);
+		CHECK(vec.emplace_back(7) == 7);
+		REQUIRE(vec.size() == 3);
+		CHECK(vec[0] == 5);
+		CHECK(vec[2] == 7);
+	}
+
+	SECTION("elements are never relocated") {
+		const auto& first = vec.emplace_back(1);
+		for (auto i = 0; i < 1000; ++i) vec.push_back(i);
+		CHECK(&first == &vec[0]);
+		CHECK(vec.size() == 1001);
+		CHECK(vec[1000] == 999);
+	}
+}
+
+TEST_CASE("concurrent_vector::grow_by(size_type, const T&)") {
+	concurrent_vector<int> vec;
+	vec.push_back(1);
+	CHECK(vec.grow_by(100, 9) == 1);
+	REQUIRE(vec.size() == 101);
+	CHECK(std::count(vec.begin(), vec.end(), 9) == 100);
+	CHECK(vec.grow_by(0) == 101);
+
+	SECTION("a throwing copy leaves no elements behind") {
+		{
+			concurrent_vector<fragile> fragiles;
+			const fragile val;
+			fragile::copies_left = 2;
+			CHECK_THROWS_AS(fragiles.grow_by(5, val), std::runtime_error);
+			CHECK(fragiles.empty());
+			CHECK(fragile::live == 1);
+		}
+		CHECK(fragile::live == 0);
+	}
+}
+
+TEST_CASE("concurrent_vector::at(size_type)") {
+	concurrent_vector<int> vec;
+	vec.push_back(1);
+	CHECK(vec.at(0) == 1);
+	CHECK_THROWS_AS(vec.at(1), std::out_of_range);
+}
+
+TEST_CASE("concurrent_vector::snapshot()") {
+	concurrent_vector<int> vec;
+	for (auto i = 0; i < 100; ++i) vec.push_back(i);
+	const auto view = vec.snapshot();
+	vec.push_back(100);
+
+	CHECK(view.size() == 100);
+	CHECK(view[99] == 99);
+	CHECK(std::accumulate(view.begin(), view.end(), 0) == 4950);
+
+	SECTION("for_each_span covers every element in order") {
+		auto expected = 0;
+		auto spans = 0;
+		view.for_each_span([&](const int* data, std::size_t count) {
+			for (std::size_t i = 0; i < count; ++i) CHECK(data[i] == expected++);
+			++spans;
+		});
+		CHECK(expected == 100);
+		CHECK(spans == 3);
+	}
+}
+
+TEST_CASE("concurrent_vector::clear(), ~concurrent_vector()") {
+	TestStruct::setup();
+	{
+		concurrent_vector<TestStruct> vec;
+		vec.grow_by(40, TestStruct(1));
+		vec.clear();
+		CHECK(TestStruct::destructed == 41);
+		CHECK(vec.empty());
+		vec.emplace_back(2);
+	}
+	CHECK(TestStruct::destructed == 42);
+}
+
+TEST_CASE("concurrent_vector concurrent appends") {
+	constexpr auto threads = 4;
+	constexpr auto per_thread = 5000;
+	concurrent_vector<int> vec;
+	std::vector<std::thread> workers;
+
+	for (auto t = 0; t < threads; ++t) {
+		workers.emplace_back([&vec, t] {
+			for (auto i = 0; i < per_thread; ++i) {
+				if (i % 10 == 0) vec.grow_by(2, t * per_thread + i);
+				else vec.push_back(t * per_thread + i);
+			}
+		});
+	}
+	for (auto& worker : workers) worker.join();
+
+	REQUIRE(vec.size() == threads * (per_thread + per_thread / 10));
+	std::vector<int> values(vec.begin(), vec.end());
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+	CHECK(values.size() == threads * per_thread);
+}
\ No newline at end of file
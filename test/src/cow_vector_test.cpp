@@ -0,0 +1,159 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/cow_vector.h>
+#include <string>
+
+using namespace std::literals;
+using namespace perfvect;
+
+TEST_CASE("cow_vector(), cow_vector::size(), cow_vector::capacity()") {
+	cow_vector<int> vec;
+	CHECK(vec.size() == 0);
+	CHECK(vec.capacity() == 0);
+	CHECK(vec.empty());
+	CHECK(vec.begin() == vec.end());
+	CHECK(!vec.is_shared());
+}
+
+TEST_CASE("cow_vector(std::initializer_list)") {
+	cow_vector<int> vec{1, 2, 3};
+	REQUIRE(vec.size() == 3);
+	CHECK(vec[0] == 1);
+	CHECK(vec[2] == 3);
+	CHECK(!vec.is_static());
+}
+
+TEST_CASE("cow_vector(const cow_vector&)") {
+	SECTION("copies share the buffer") {
+		cow_vector<TestStruct> vec{1, 2, 3};
+		TestStruct::setup();
+		const cow_vector<TestStruct> copy(vec);
+		CHECK(TestStruct::constructed == 0);
+		CHECK(vec.is_shared());
+		CHECK(copy.is_shared());
+		CHECK(copy.data() == std::as_const(vec).data());
+	}
+
+	SECTION("small variant copies inline elements") {
+		small_cow_vector<int, 4> vec{1, 2};
+		small_cow_vector<int, 4> copy(vec);
+		CHECK(copy.is_static());
+		CHECK(!vec.is_shared());
+		CHECK(copy.data() != std::as_const(vec).data());
+		CHECK(copy[1] == 2);
+	}
+
+	SECTION("small variant shares heap elements") {
+		small_cow_vector<int, 2> vec{1, 2, 3};
+		small_cow_vector<int, 2> copy(vec);
+		CHECK(!copy.is_static());
+		CHECK(copy.is_shared());
+	}
+}
+
+TEST_CASE("cow_vector mutation clones a shared buffer") {
+	cow_vector<TestStruct> vec{1, 2, 3};
+	cow_vector<TestStruct> copy(vec);
+	TestStruct::setup();
+
+	SECTION("through operator[]") {
+		copy[0] = 10;
+		CHECK(TestStruct::copyConstructed == 3);
+		CHECK(!vec.is_shared());
+		CHECK(!copy.is_shared());
+		CHECK(std::as_const(vec)[0] == 1);
+		CHECK(std::as_const(copy)[0] == 10);
+	}
+
+	SECTION("through push_back") {
+		copy.push_back(4);
+		CHECK(std::as_const(vec).size() == 3);
+		CHECK(copy.size() == 4);
+		CHECK(std::as_const(copy)[3] == 4);
+	}
+
+	SECTION("unique buffer is not cloned") {
+		copy.clear();
+		CHECK(TestStruct::destructed == 0);
+		vec[0] = 10;
+		CHECK(TestStruct::copyConstructed == 0);
+		CHECK(std::as_const(vec)[0] == 10);
+	}
+
+	SECTION("const access does not clone") {
+		const auto& ref = copy;
+		CHECK(ref[1] == 2);
+		CHECK(ref.front() == 1);
+		CHECK(*ref.begin() == 1);
+		CHECK(TestStruct::copyConstructed == 0);
+		CHECK(copy.is_shared());
+	}
+}
+
+TEST_CASE("cow_vector(cow_vector&&)") {
+	SECTION("heap buffer is stolen") {
+		cow_vector<std::string> vec{"a"s, "b"s};
+		const auto data = std::as_const(vec).data();
+		cow_vector<std::string> moved(std::move(vec));
+		CHECK(std::as_const(moved).data() == data);
+		CHECK(vec.empty());
+	}
+
+	SECTION("inline elements are moved") {
+		small_cow_vector<std::string, 4> vec{"a"s, "b"s};
+		small_cow_vector<std::string, 4> moved(std::move(vec));
+		CHECK(moved.size() == 2);
+		CHECK(vec.empty());
+	}
+}
+
+TEST_CASE("cow_vector::operator=(const cow_vector&)") {
+	cow_vector<int> vec{1, 2, 3};
+	cow_vector<int> other{4};
+	other = vec;
+	CHECK(other.is_shared());
+	CHECK(std::as_const(other)[2] == 3);
+	other = other;
+	CHECK(other.is_shared());
+}
+
+TEST_CASE("cow_vector::insert(), cow_vector::erase()") {
+	small_cow_vector<int, 2> vec{1, 2, 3};
+	const auto copy = vec;
+
+	vec.insert(vec.cbegin() + 1, {7, 8});
+	vec.erase(vec.cbegin());
+	vec.insert(vec.cend(), 2, 9);
+	REQUIRE(vec.size() == 6);
+	CHECK(std::vector<int>(vec.cbegin(), vec.cend()) == std::vector<int>{7, 8, 2, 3, 9, 9});
+	CHECK(std::vector<int>(copy.cbegin(), copy.cend()) == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("cow_vector::resize()") {
+	small_cow_vector<int, 2> vec{1, 2, 3};
+	const auto copy = vec;
+
+	SECTION("shrinking a shared buffer moves back inline") {
+		vec.resize(1);
+		CHECK(vec.is_static());
+		CHECK(vec.size() == 1);
+		CHECK(copy.size() == 3);
+	}
+
+	SECTION("growing with value") {
+		vec.resize(5, 7);
+		CHECK(std::vector<int>(vec.cbegin(), vec.cend()) == std::vector<int>{1, 2, 3, 7, 7});
+	}
+}
+
+TEST_CASE("~cow_vector()") {
+	TestStruct::setup();
+	{
+		cow_vector<TestStruct> vec{1, 2};
+		{
+			const auto copy = vec;
+		}
+		CHECK(TestStruct::destructed == 2);
+	}
+	CHECK(TestStruct::destructed == 4);
+}
\ No newline at end of file
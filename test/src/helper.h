@@ -1,6 +1,13 @@
 #ifndef PERFVECT_TEST_HELPER_H
 #define PERFVECT_TEST_HELPER_H
 
+#include <perfvect/simd.h>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
 // Useful for testing how the containers manage their types i.e. whether they construct, assign, move or copy them.
 // The static vars will count the total number of constructions/assignments/moves/copies since the last setup() call.
 struct TestStruct {
@@ -99,4 +106,73 @@ inline unsigned int TestStruct::moveAssigned = 0;
 inline unsigned int TestStruct::copyConstructed = 0;
 inline unsigned int TestStruct::copyAssigned = 0;
 
+// element whose copy constructor throws once a shared countdown runs out, counting the live instances, for checking
+// that containers destroy what they built when an operation fails partway
+struct fragile {
+	static std::atomic<int> live;
+	static std::atomic<int> copies_left;
+
+	fragile() : value(0) {
+		++live;
+	}
+
+	explicit fragile(const int value) : value(value) {
+		++live;
+	}
+
+	fragile(const fragile& other) : value(other.value) {
+		if (copies_left-- <= 0) throw std::runtime_error("copy failed");
+		++live;
+	}
+
+	fragile(fragile&& other) noexcept : value(other.value) {
+		++live;
+	}
+
+	auto operator=(const fragile&)->fragile& = default;
+	auto operator=(fragile&&) noexcept->fragile& = default;
+
+	~fragile() {
+		--live;
+	}
+
+	int value;
+};
+
+inline std::atomic<int> fragile::live{0};
+inline std::atomic<int> fragile::copies_left{0};
+
+// sends every key to one of three neighbouring buckets, near the end of a 16-slot table, so that lookups have to
+// probe, probe runs wrap around and erasure has to shift them back
+struct clustered_hash {
+	auto operator()(const int key) const noexcept->std::size_t {
+		return static_cast<std::size_t>(key % 3) + 13;
+	}
+};
+
+// every instruction set the SIMD kernels can be forced to on this machine, for checking them against the scalar ones
+inline auto simd_levels() {
+	using perfvect::detail::simd_level;
+	std::vector<simd_level> levels{simd_level::scalar};
+	#if defined(PERFVECT_SIMD_X86)
+	levels.push_back(simd_level::sse2);
+	#endif
+	if (perfvect::detail::simd_level_supported() >= simd_level::avx2) levels.push_back(simd_level::avx2);
+	if (perfvect::detail::simd_level_supported() >= simd_level::avx512) levels.push_back(simd_level::avx512);
+	return levels;
+}
+
+// count random values of an arithmetic type: small whole numbers, so that sums of floating point values are exact in
+// any order and integer arithmetic does not overflow, or integers over their whole range when full_range is set, so
+// that sums wrap
+template<typename T, typename Rng>
+auto make_values(Rng& rng, const std::size_t count, const bool full_range = false) {
+	std::vector<T> values;
+	for (std::size_t i = 0; i < count; ++i) {
+		if (std::is_integral_v<T> && full_range) values.push_back(static_cast<T>(rng()));
+		else values.push_back(static_cast<T>(static_cast<int>(rng() % 41) - (std::is_signed_v<T> ? 20 : 0)));
+	}
+	return values;
+}
+
 #endif
\ No newline at end of file
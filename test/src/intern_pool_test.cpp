@@ -0,0 +1,138 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/intern_pool.h>
+#include <perfvect/small_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace perfvect;
+
+namespace {
+	using labels = small_vector<std::uint32_t, 8>;
+
+	auto make_labels(const std::uint32_t seed, const std::uint32_t count) {
+		labels vec;
+		for (std::uint32_t i = 0; i < count; ++i) vec.push_back(seed * 31 + i);
+		return vec;
+	}
+
+	auto same(const labels& a, const labels& b) {
+		return std::equal(a.begin(), a.end(), b.begin(), b.end());
+	}
+}
+
+TEST_CASE("detail::hash_bytes(const void*, size_t)") {
+	std::vector<unsigned char> bytes(100);
+	for (std::size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<unsigned char>(i);
+
+	std::unordered_set<std::uint64_t> hashes;
+	for (std::size_t size = 0; size <= bytes.size(); ++size) hashes.insert(detail::hash_bytes(bytes.data(), size));
+	CHECK(hashes.size() == bytes.size() + 1);
+
+	const auto before = detail::hash_bytes(bytes.data(), bytes.size());
+	bytes[57] ^= 1;
+	CHECK(detail::hash_bytes(bytes.data(), bytes.size()) != before);
+	CHECK(detail::hash_bytes(bytes.data(), bytes.size(), 1) != detail::hash_bytes(bytes.data(), bytes.size()));
+}
+
+TEST_CASE("intern_pool::intern(const value_type&)") {
+	intern_pool<labels> pool;
+	CHECK(pool.empty());
+
+	const auto a = pool.intern(make_labels(1, 3));
+	const auto b = pool.intern(make_labels(2, 3));
+	const auto c = pool.intern(make_labels(1, 3));
+	const auto empty = pool.intern(labels{});
+
+	CHECK(a.valid());
+	CHECK(a == c);
+	CHECK(a != b);
+	CHECK(empty != a);
+	CHECK(pool.size() == 3);
+	CHECK(pool.element_count() == 6);
+	CHECK(pool[empty].empty());
+
+	SECTION("views and values reproduce the interned elements") {
+		const auto view = pool[b];
+		REQUIRE(view.size() == 3);
+		CHECK(view[0] == 62);
+		CHECK(view[2] == 64);
+		CHECK(same(pool.value(b), make_labels(2, 3)));
+		CHECK_THROWS_AS(pool.at(intern_handle{}), std::out_of_range);
+	}
+
+	SECTION("find does not intern") {
+		CHECK(pool.find(make_labels(2, 3)) == b);
+		CHECK_FALSE(pool.find(make_labels(3, 3)).valid());
+		CHECK(pool.size() == 3);
+	}
+
+	SECTION("views stay valid as the pool grows") {
+		const auto view = pool[a];
+		for (std::uint32_t i = 0; i < 5000; ++i) pool.intern(make_labels(i + 10, i % 20));
+		CHECK(pool[a].data() == view.data());
+		CHECK(same(pool.value(a), make_labels(1, 3)));
+		for (std::uint32_t i = 0; i < 5000; ++i) CHECK(pool.find(make_labels(i + 10, i % 20)).valid());
+	}
+
+	SECTION("clear") {
+		pool.clear();
+		CHECK(pool.empty());
+		CHECK(pool.element_count() == 0);
+		CHECK_FALSE(pool.find(make_labels(1, 3)).valid());
+	}
+}
+
+TEST_CASE("intern_pool with elements hashed by value") {
+	intern_pool<small_vector<double, 4>> pool;
+	const auto a = pool.intern(small_vector<double, 4>{1.5, 2.5});
+	CHECK(pool.intern(small_vector<double, 4>{1.5, 2.5}) == a);
+	CHECK(pool.intern(small_vector<double, 4>{2.5, 1.5}) != a);
+	CHECK(pool.size() == 2);
+}
+
+TEST_CASE("concurrent_intern_pool::intern(const value_type&)") {
+	concurrent_intern_pool<labels> pool;
+	const auto a = pool.intern(make_labels(7, 5));
+	CHECK(pool.intern(make_labels(7, 5)) == a);
+	CHECK(pool.find(make_labels(7, 5)) == a);
+	CHECK_FALSE(pool.find(make_labels(8, 5)).valid());
+	CHECK(same(pool.value(a), make_labels(7, 5)));
+
+	SECTION("threads interning overlapping sets agree on handles") {
+		constexpr auto thread_count = 4;
+		constexpr std::uint32_t distinct = 2000;
+		std::vector<std::vector<intern_handle>> results(thread_count);
+		std::vector<std::thread> threads;
+		for (auto t = 0; t < thread_count; ++t) {
+			threads.emplace_back([&pool, &results, t] {
+				for (std::uint32_t i = 0; i < distinct; ++i) {
+					const auto key = (i * 7 + static_cast<std::uint32_t>(t) * 13) % distinct;
+					results[t].push_back(pool.intern(make_labels(key, key % 9 + 1)));
+				}
+			});
+		}
+		for (auto& thread : threads) thread.join();
+
+		CHECK(pool.size() == distinct + 1);
+		CHECK(pool.element_count() == 5 + [] {
+			std::size_t total = 0;
+			for (std::uint32_t key = 0; key < distinct; ++key) total += key % 9 + 1;
+			return total;
+		}());
+		for (std::uint32_t key = 0; key < distinct; ++key) {
+			const auto handle = pool.find(make_labels(key, key % 9 + 1));
+			REQUIRE(handle.valid());
+			CHECK(same(pool.value(handle), make_labels(key, key % 9 + 1)));
+		}
+		for (auto t = 0; t < thread_count; ++t) {
+			for (std::uint32_t i = 0; i < distinct; ++i) {
+				const auto key = (i * 7 + static_cast<std::uint32_t>(t) * 13) % distinct;
+				CHECK(results[t][i] == pool.find(make_labels(key, key % 9 + 1)));
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/jagged_vector.h>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace perfvect;
+
+namespace {
+	auto row_values(jagged_vector<int>::const_row_reference row) {
+		return std::vector<int>(row.begin(), row.end());
+	}
+}
+
+TEST_CASE("jagged_vector(), jagged_vector::size(), jagged_vector::empty()") {
+	jagged_vector<int> vec;
+	CHECK(vec.size() == 0);
+	CHECK(vec.empty());
+	CHECK(vec.value_count() == 0);
+	CHECK(vec.begin() == vec.end());
+}
+
+TEST_CASE("jagged_vector(std::initializer_list<std::initializer_list<T>>)") {
+	const jagged_vector<int> vec{{1, 2, 3}, {}, {4}};
+	REQUIRE(vec.size() == 3);
+	CHECK(vec.value_count() == 4);
+	CHECK(row_values(vec[0]) == std::vector<int>{1, 2, 3});
+	CHECK(vec[1].empty());
+	CHECK(vec[2].front() == 4);
+	CHECK(vec.back().back() == 4);
+	CHECK(vec[0].data() + 3 == vec[2].data());
+	CHECK(vec.at(0).at(2) == 3);
+	CHECK_THROWS_AS(vec.at(3), std::out_of_range);
+	CHECK_THROWS_AS(vec[0].at(3), std::out_of_range);
+
+	auto total = 0;
+	for (const auto row : vec) total += std::accumulate(row.begin(), row.end(), 0);
+	CHECK(total == 10);
+}
+
+TEST_CASE("jagged_vector::append_row(), jagged_vector::append_to_last_row(const T&)") {
+	jagged_vector<int> vec;
+	vec.append_row({1, 2});
+	vec.append_row(3, 7);
+	vec.append_to_last_row(8);
+	vec.emplace_to_last_row(9);
+	const int extra[] = {10, 11};
+	vec.append_to_last_row(std::begin(extra), std::end(extra));
+	vec.append_row();
+
+	REQUIRE(vec.size() == 3);
+	CHECK(row_values(vec[0]) == std::vector<int>{1, 2});
+	CHECK(row_values(vec[1]) == std::vector<int>{7, 7, 7, 8, 9, 10, 11});
+	CHECK(vec[2].empty());
+	CHECK(vec.is_compact());
+}
+
+TEST_CASE("jagged_vector::basic_row modifiers") {
+	jagged_vector<int> vec{{1, 2, 3, 4}, {5, 6}, {7}};
+
+	SECTION("removals leave slack which compact() squeezes out") {
+		vec[0].erase(vec[0].cbegin() + 1);
+		vec[0].pop_back();
+		CHECK(row_values(vec[0]) == std::vector<int>{1, 3});
+		CHECK(vec[0].capacity() == 4);
+		CHECK_FALSE(vec.is_compact());
+		CHECK(vec.value_count() == 5);
+
+		vec.compact();
+		CHECK(vec.is_compact());
+		CHECK(vec[0].capacity() == 2);
+		CHECK(row_values(vec[0]) == std::vector<int>{1, 3});
+		CHECK(row_values(vec[1]) == std::vector<int>{5, 6});
+		CHECK(row_values(vec[2]) == std::vector<int>{7});
+	}
+
+	SECTION("erase(const_iterator, const_iterator)") {
+		vec[2].erase(vec[2].cbegin(), vec[2].cend());
+		CHECK(vec[2].empty());
+		vec[0].erase(vec[0].cbegin() + 2, vec[0].cend());
+		CHECK(row_values(vec[0]) == std::vector<int>{1, 2});
+		CHECK(vec[0].erase(vec[0].cbegin(), vec[0].cbegin()) == vec[0].begin());
+		CHECK(row_values(vec[0]) == std::vector<int>{1, 2});
+
+		jagged_vector<std::string> strings{{"alpha", "beta"}};
+		strings[0].erase(strings[0].cbegin(), strings[0].cbegin());
+		CHECK(strings[0][0] == "alpha");
+		CHECK(strings[0][1] == "beta");
+	}
+
+	SECTION("push_back reuses slack before moving later rows") {
+		vec[0].clear();
+		vec[0].push_back(9);
+		CHECK(vec[0].data() + 4 == vec[1].data());
+		CHECK(row_values(vec[0]) == std::vector<int>{9});
+
+		vec[1].push_back(10);
+		CHECK(row_values(vec[1]) == std::vector<int>{5, 6, 10});
+		CHECK(row_values(vec[2]) == std::vector<int>{7});
+		CHECK(vec[1].data() + 3 == vec[2].data());
+	}
+
+	SECTION("pop_row()") {
+		vec.pop_row();
+		CHECK(vec.size() == 2);
+		CHECK(vec.value_count() == 6);
+		vec.append_to_last_row(0);
+		CHECK(row_values(vec[1]) == std::vector<int>{5, 6, 0});
+	}
+}
+
+TEST_CASE("jagged_vector::clear()") {
+	TestStruct::setup();
+	{
+		jagged_vector<TestStruct> vec;
+		vec.reserve(2, 3);
+		vec.append_row(2, TestStruct(1));
+		vec.append_row(1, TestStruct(2));
+		TestStruct::setup();
+		vec.clear();
+		CHECK(TestStruct::destructed == 3);
+		CHECK(vec.empty());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/numeric.h>
+#include <perfvect/small_vector.h>
+#include <perfvect/static_vector.h>
+#include <perfvect/vector.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace perfvect;
+
+namespace {
+	template<typename Vec, typename Expected>
+	auto same(const Vec& vec, const Expected& expected) {
+		return std::equal(vec.begin(), vec.end(), expected.begin(), expected.end());
+	}
+}
+
+TEMPLATE_TEST_CASE("detail::evaluate(...), detail::reduce(...)", "", std::int8_t, std::uint16_t, int, std::int64_t, float, double) {
+	std::mt19937 rng(7);
+	for (const std::size_t size : {0, 1, 3, 15, 16, 33, 64, 100, 257}) {
+		const auto a = make_values<TestType>(rng, size);
+		const auto b = make_values<TestType>(rng, size);
+		const vector<TestType> va(a.begin(), a.end());
+		const vector<TestType> vb(b.begin(), b.end());
+
+		std::vector<TestType> expected;
+		for (std::size_t i = 0; i < size; ++i) expected.push_back(static_cast<TestType>(static_cast<TestType>(a[i] * b[i]) - static_cast<TestType>(3 * a[i])));
+		auto expected_sum = TestType{};
+		for (const auto value : a) expected_sum = static_cast<TestType>(expected_sum + value);
+
+		const auto expr = va * vb - TestType{3} * va;
+		const auto operand = detail::to_operand<TestType>(va);
+		for (const auto level : simd_levels()) {
+			std::vector<TestType> out(size);
+			detail::evaluate<detail::unbounded_extent>(expr, out.data(), size, level);
+			REQUIRE(out == expected);
+
+			CHECK(detail::reduce<detail::unbounded_extent, detail::sum_reduction<TestType>>(operand, size, level) == expected_sum);
+			if (!size) continue;
+			using min_t = detail::extremum_reduction<TestType, std::less<>>;
+			using max_t = detail::extremum_reduction<TestType, std::greater<>>;
+			using argmin_t = detail::arg_reduction<TestType, std::uint32_t, std::less<>>;
+			using argmax_t = detail::arg_reduction<TestType, std::uint64_t, std::greater<>>;
+			CHECK(detail::reduce<detail::unbounded_extent, min_t>(operand, size, level) == *std::min_element(a.begin(), a.end()));
+			CHECK(detail::reduce<detail::unbounded_extent, max_t>(operand, size, level) == *std::max_element(a.begin(), a.end()));
+			CHECK(detail::reduce<detail::unbounded_extent, argmin_t>(operand, size, level) == static_cast<std::size_t>(std::min_element(a.begin(), a.end()) - a.begin()));
+			CHECK(detail::reduce<detail::unbounded_extent, argmax_t>(operand, size, level) == static_cast<std::size_t>(std::max_element(a.begin(), a.end()) - a.begin()));
+		}
+	}
+}
+
+TEST_CASE("element-wise expressions") {
+	SECTION("a = b * s + c over static_vector") {
+		static_vector<float, 8> a;
+		const static_vector<float, 8> b{1, 2, 3, 4, 5, 6, 7, 8};
+		const static_vector<float, 8> c{8, 7, 6, 5, 4, 3, 2, 1};
+		a = b * 2.0f + c;
+		CHECK(same(a, std::vector<float>{10, 11, 12, 13, 14, 15, 16, 17}));
+
+		a = -(b - c) / 2.0f;
+		CHECK(same(a, std::vector<float>{3.5f, 2.5f, 1.5f, 0.5f, -0.5f, -1.5f, -2.5f, -3.5f}));
+
+		const static_vector<float, 8> partial{1, 2, 3};
+		a = 10.0f - partial;
+		CHECK(same(a, std::vector<float>{9, 8, 7}));
+	}
+
+	SECTION("the destination is resized to the expression") {
+		small_vector<int, 4> a{1, 2};
+		vector<int> b(100, 3);
+		a = b * b;
+		CHECK(a.is_dynamic());
+		CHECK(same(a, std::vector<int>(100, 9)));
+
+		vector<int> shrunk(200, 1);
+		shrunk = a + 1;
+		CHECK(same(shrunk, std::vector<int>(100, 10)));
+
+		static_vector_base<int>& base = shrunk;
+		base = b - 4;
+		CHECK(same(shrunk, std::vector<int>(100, -1)));
+	}
+
+	SECTION("the destination may be an operand") {
+		vector<double> a{1, 2, 3, 4, 5};
+		a = a * a + a;
+		CHECK(same(a, std::vector<double>{2, 6, 12, 20, 30}));
+	}
+
+	SECTION("compound assignment") {
+		small_vector<std::int64_t> a{1, 2, 3};
+		const small_vector<std::int64_t> b{10, 20, 30};
+		a += b;
+		a *= 2;
+		a -= b * 3;
+		CHECK(same(a, std::vector<std::int64_t>{-8, -16, -24}));
+		a /= -8;
+		CHECK(same(a, std::vector<std::int64_t>{1, 2, 3}));
+	}
+
+	SECTION("scalars must convert to the element type without narrowing") {
+		using ints = static_vector<int, 4>;
+		static_assert(detail::is_numeric_pair_v<ints, int>);
+		static_assert(detail::is_numeric_pair_v<short, ints>);
+		static_assert(!detail::is_numeric_pair_v<ints, double>);
+		static_assert(!detail::is_numeric_pair_v<std::int64_t, ints>);
+		static_assert(!detail::is_numeric_pair_v<vector<float>, int>);
+		static_assert(detail::is_numeric_pair_v<vector<double>, float>);
+		static_assert(!detail::is_numeric_pair_v<ints, vector<std::int64_t>>);
+	}
+
+	SECTION("narrow integers wrap like the element type") {
+		static_vector<std::uint8_t, 4> a{200, 100, 255, 0};
+		a = a + a;
+		CHECK(same(a, std::vector<std::uint8_t>{144, 200, 254, 0}));
+	}
+
+	SECTION("full static_vector operands take the unrolled kernels") {
+		static_vector<int, 20> a;
+		static_vector<int, 20> b;
+		for (auto i = 0; i < 20; ++i) {
+			a.push_back(i);
+			b.push_back(20 - i);
+		}
+		static_vector<int, 20> c;
+		c = a * b;
+		for (auto i = 0; i < 20; ++i) CHECK(c[i] == i * (20 - i));
+		CHECK(sum(c) == 1330);
+		CHECK(dot(a, b) == 1330);
+		CHECK(argmax(c) == 10);
+		CHECK(min(c) == 0);
+	}
+}
+
+TEST_CASE("sum(e), dot(l, r), norm(e), min(e), max(e), argmin(e), argmax(e)") {
+	const small_vector<float> a{3, -1, 4, -1, 5, 9, -2, 6};
+	const small_vector<float> b{1, 1, 1, 1, 1, 1, 1, 1};
+
+	CHECK(sum(a) == 23);
+	CHECK(sum(a - b) == 15);
+	CHECK(dot(a, b) == 23);
+	CHECK(dot(a, a * 2.0f) == 2 * 173);
+	CHECK(norm(static_vector<double, 2>{3, 4}) == 5);
+	CHECK(norm(vector<int>{3, 4}) == 5.0);
+	CHECK(min(a) == -2);
+	CHECK(max(a * -1.0f) == 2);
+	CHECK(argmin(a) == 6);
+	CHECK(argmax(a) == 5);
+
+	SECTION("the first of equal elements is found") {
+		vector<int> values(1000, 5);
+		values[300] = 1;
+		values[700] = 1;
+		values[10] = 9;
+		values[999] = 9;
+		CHECK(argmin(values) == 300);
+		CHECK(argmax(values) == 10);
+	}
+
+	SECTION("NaNs are treated like std::min_element and std::max_element treat them") {
+		const auto nan = std::numeric_limits<double>::quiet_NaN();
+		vector<double> values(100, 1.0);
+		values[50] = nan;
+		values[60] = -1.0;
+		CHECK(min(values) == -1.0);
+		CHECK(argmin(values) == 60);
+		CHECK(argmax(values) == 0);
+
+		values[0] = nan;
+		CHECK(std::isnan(min(values)));
+		CHECK(argmin(values) == 0);
+		CHECK(argmax(values) == 0);
+	}
+
+	SECTION("empty ranges") {
+		const vector<int> empty;
+		CHECK(sum(empty) == 0);
+		CHECK(dot(empty, empty) == 0);
+		CHECK(argmin(empty) == 0);
+		CHECK(argmax(empty) == 0);
+	}
+}
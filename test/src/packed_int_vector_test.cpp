@@ -0,0 +1,138 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/packed_int_vector.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace perfvect;
+
+TEST_CASE("packed_int_vector(), packed_int_vector::size(), packed_int_vector::empty()") {
+	packed_int_vector<10> vec;
+	CHECK(vec.size() == 0);
+	CHECK(vec.empty());
+	CHECK(vec.begin() == vec.end());
+	CHECK(std::is_same_v<packed_int_vector<10>::value_type, std::uint16_t>);
+	CHECK(packed_int_vector<10>::max_value == 1023);
+}
+
+TEST_CASE("packed_int_vector::push_back(value_type), packed_int_vector::operator[](size_type)") {
+	packed_int_vector<13> vec;
+	std::vector<std::uint16_t> expected;
+	for (std::uint16_t i = 0; i < 1000; ++i) {
+		const auto value = static_cast<std::uint16_t>((i * 7919) & 0x1FFF);
+		vec.push_back(value);
+		expected.push_back(value);
+	}
+
+	REQUIRE(vec.size() == 1000);
+	CHECK(vec.memory_bytes() == (1000 * 13 + 63) / 64 * 8);
+	CHECK(std::vector<std::uint16_t>(vec.begin(), vec.end()) == expected);
+	CHECK(vec.at(999) == expected[999]);
+	CHECK_THROWS_AS(vec.at(1000), std::out_of_range);
+
+	SECTION("values are truncated to the width") {
+		vec.push_back(0xFFFF);
+		CHECK(vec.back() == 0x1FFF);
+	}
+
+	SECTION("reference assignment leaves neighbours untouched") {
+		vec[4] = 0x1FFF;
+		vec[5] = 0;
+		CHECK(vec[3] == expected[3]);
+		CHECK(vec[4] == 0x1FFF);
+		CHECK(vec[5] == 0);
+		CHECK(vec[6] == expected[6]);
+	}
+
+	SECTION("unpack(size_type, size_type, value_type*)") {
+		std::vector<std::uint16_t> out(300);
+		vec.unpack(128, 300, out.data());
+		CHECK(std::equal(out.begin(), out.end(), expected.begin() + 128));
+		vec.unpack(5, 100, out.data());
+		CHECK(std::equal(out.begin(), out.begin() + 100, expected.begin() + 5));
+	}
+
+	SECTION("pop_back(), resize()") {
+		vec.pop_back();
+		CHECK(vec.size() == 999);
+		vec.resize(10);
+		CHECK(vec.size() == 10);
+		CHECK(vec.memory_bytes() == 24);
+		vec.resize(20, 5);
+		CHECK(vec[9] == expected[9]);
+		CHECK(vec[19] == 5);
+	}
+}
+
+TEST_CASE("packed_int_vector<64>") {
+	packed_int_vector<64> vec{~std::uint64_t{0}, 1, 2};
+	CHECK(vec[0] == ~std::uint64_t{0});
+	CHECK(vec[2] == 2);
+}
+
+TEST_CASE("compressed_int_vector(), compressed_int_vector::size()") {
+	compressed_int_vector<> vec;
+	CHECK(vec.size() == 0);
+	CHECK(vec.empty());
+	CHECK(vec.begin() == vec.end());
+	CHECK(vec.memory_bytes() == 0);
+}
+
+TEST_CASE("compressed_int_vector::push_back(value_type)") {
+	std::mt19937 rng(7);
+	std::vector<std::uint32_t> expected;
+
+	SECTION("values in a narrow range pack tightly") {
+		for (auto i = 0; i < 10000; ++i) expected.push_back(1000000 + rng() % 1024);
+	}
+
+	SECTION("descending values") {
+		for (std::uint32_t i = 0; i < 10000; ++i) expected.push_back(50000 - i * 3);
+	}
+
+	SECTION("mixed widths") {
+		for (auto i = 0; i < 10000; ++i) expected.push_back(i % 1000 == 0 ? 0xFFFFFFFF : rng() % (1u << (i % 20)));
+	}
+
+	SECTION("runs of equal values") {
+		for (auto i = 0; i < 1000; ++i) expected.push_back(42);
+		expected.push_back(41);
+	}
+
+	const compressed_int_vector<> vec(expected.begin(), expected.end());
+	REQUIRE(vec.size() == expected.size());
+	CHECK(vec.block_count() == (expected.size() + 127) / 128);
+	for (std::size_t i = 0; i < expected.size(); ++i) REQUIRE(vec[i] == expected[i]);
+	CHECK(std::vector<std::uint32_t>(vec.begin(), vec.end()) == expected);
+
+	std::vector<std::uint32_t> blocks;
+	vec.for_each_block([&blocks](const std::uint32_t* values, const std::size_t count) {
+		blocks.insert(blocks.end(), values, values + count);
+	});
+	CHECK(blocks == expected);
+}
+
+TEST_CASE("compressed_int_vector frame-of-reference width") {
+	compressed_int_vector<> vec;
+	for (std::uint32_t i = 0; i < 128; ++i) vec.push_back(1u << 30 | (i & 0x3FF));
+	vec.push_back(7);
+	CHECK(vec.block_bits(0) == 7);
+	CHECK(vec.block_bits(1) == 0);
+	CHECK(vec.memory_bytes() < 128 * sizeof(std::uint32_t) / 3);
+	CHECK(vec.at(128) == 7);
+	CHECK_THROWS_AS(vec.at(129), std::out_of_range);
+}
+
+TEST_CASE("compressed_int_vector::pop_back()") {
+	compressed_int_vector<std::uint64_t> vec{1, 2, 3};
+	for (std::uint64_t i = 0; i < 200; ++i) vec.push_back(i << 40);
+	vec.pop_back();
+	CHECK(vec.size() == 202);
+	CHECK(vec.back() == std::uint64_t{198} << 40);
+	while (vec.size() > 128) vec.pop_back();
+	CHECK(vec.block_count() == 1);
+	vec.push_back(5);
+	CHECK(vec[128] == 5);
+	CHECK(vec[2] == 3);
+}
\ No newline at end of file
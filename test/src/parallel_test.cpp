@@ -0,0 +1,219 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/parallel.h>
+#include <perfvect/small_vector.h>
+#include <perfvect/vector.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace perfvect;
+
+namespace {
+	template<typename Vec, typename Expected>
+	auto same(const Vec& vec, const Expected& expected) {
+		return std::equal(vec.begin(), vec.end(), expected.begin(), expected.end());
+	}
+}
+
+TEST_CASE("thread_pool::run(unsigned, Task&&)") {
+	thread_pool pool(4);
+	CHECK(pool.size() == 4);
+
+	SECTION("each worker runs the task once") {
+		std::atomic<int> calls[4] = {};
+		std::thread::id caller;
+		pool.run(4, [&](const unsigned worker) {
+			++calls[worker];
+			if (worker == 0) caller = std::this_thread::get_id();
+		});
+		for (const auto& count : calls) CHECK(count == 1);
+		CHECK(caller == std::this_thread::get_id());
+	}
+
+	SECTION("workers are clamped to the pool size") {
+		std::atomic<unsigned> calls{0};
+		pool.run(100, [&](unsigned) { ++calls; });
+		CHECK(calls == 4);
+		pool.run(0, [&](unsigned) { ++calls; });
+		CHECK(calls == 5);
+	}
+
+	SECTION("repeated runs") {
+		std::atomic<unsigned> total{0};
+		for (auto run = 0; run < 200; ++run) pool.run(1 + run % 4, [&](const unsigned worker) { total += worker + 1; });
+		CHECK(total == 50 * (1 + 3 + 6 + 10));
+	}
+
+	SECTION("the first exception is rethrown after every worker finishes") {
+		std::atomic<unsigned> finished{0};
+		CHECK_THROWS_AS(pool.run(4, [&](const unsigned worker) {
+			if (worker == 2) throw std::runtime_error("worker failed");
+			++finished;
+		}), std::runtime_error);
+		CHECK(finished == 3);
+
+		std::atomic<unsigned> calls{0};
+		pool.run(4, [&](unsigned) { ++calls; });
+		CHECK(calls == 4);
+	}
+}
+
+TEST_CASE("detail::chunk_of(size_t, unsigned, unsigned)") {
+	for (const std::size_t count : {0, 1, 7, 100, 1001}) {
+		for (const auto workers : {1u, 3u, 8u}) {
+			std::size_t next = 0;
+			for (auto worker = 0u; worker < workers; ++worker) {
+				const auto bounds = detail::chunk_of(count, workers, worker);
+				CHECK(bounds.first == next);
+				CHECK(bounds.second - bounds.first <= count / workers + 1);
+				next = bounds.second;
+			}
+			CHECK(next == count);
+		}
+	}
+}
+
+TEST_CASE("vector parallel bulk operations") {
+	thread_pool pool(4);
+	const parallel_policy policy(pool, 16);
+
+	std::vector<int> source(1000);
+	std::iota(source.begin(), source.end(), 0);
+
+	SECTION("copy construction") {
+		vector<int> original(source.begin(), source.end());
+		vector<int> copy(policy, original);
+		CHECK(same(copy, source));
+		CHECK(same(vector<int>(policy, vector<int>()), std::vector<int>()));
+	}
+
+	SECTION("assign(parallel_policy, size_type, const T&)") {
+		vector<int> vec{1, 2, 3};
+		vec.assign(policy, 500, 7);
+		CHECK(same(vec, std::vector<int>(500, 7)));
+		vec.assign(policy, 100, 8);
+		CHECK(same(vec, std::vector<int>(100, 8)));
+		vec.assign(policy, 300, 9);
+		CHECK(same(vec, std::vector<int>(300, 9)));
+	}
+
+	SECTION("fill(parallel_policy, const T&)") {
+		vector<int> vec(source.begin(), source.end());
+		vec.reserve(1500);
+		vec.fill(policy, 3);
+		CHECK(vec.size() == vec.capacity());
+		CHECK(same(vec, std::vector<int>(vec.capacity(), 3)));
+
+		small_vector<int, 4> small;
+		small.fill(policy, 4);
+		CHECK(same(small, std::vector<int>(4, 4)));
+	}
+
+	SECTION("resize(parallel_policy, size_type)") {
+		vector<int> vec(source.begin(), source.begin() + 10);
+		vec.resize(policy, 1000);
+		std::vector<int> expected(source.begin(), source.begin() + 10);
+		expected.resize(1000);
+		CHECK(same(vec, expected));
+
+		vec.resize(policy, 2000, 5);
+		expected.resize(2000, 5);
+		CHECK(same(vec, expected));
+
+		vec.resize(policy, 3);
+		CHECK(same(vec, std::vector<int>{0, 1, 2}));
+	}
+
+	SECTION("insert_range(parallel_policy, const_iterator, Iter, Iter)") {
+		for (const std::size_t pos : {0, 250, 1000}) {
+			vector<int> vec(source.begin(), source.end());
+			const std::vector<int> range(300, -1);
+			const auto it = vec.insert_range(policy, vec.begin() + pos, range.begin(), range.end());
+			CHECK(it == vec.begin() + pos);
+
+			auto expected = source;
+			expected.insert(expected.begin() + pos, range.begin(), range.end());
+			CHECK(same(vec, expected));
+		}
+
+		vector<std::string> strings{"a", "d"};
+		const std::vector<std::string> range(100, "x");
+		strings.insert_range(policy, strings.begin() + 1, range.begin(), range.end());
+		REQUIRE(strings.size() == 102);
+		CHECK(strings.front() == "a");
+		CHECK(strings[1] == "x");
+		CHECK(strings[100] == "x");
+		CHECK(strings.back() == "d");
+	}
+
+	SECTION("erase_if(parallel_policy, Pred)") {
+		for (const auto divisor : {1, 2, 3, 7, 2000}) {
+			const auto pred = [divisor](const int value) { return value % divisor == 0; };
+			vector<int> vec(source.begin(), source.end());
+			auto expected = source;
+			expected.erase(std::remove_if(expected.begin(), expected.end(), pred), expected.end());
+			CHECK(vec.erase_if(policy, pred) == source.size() - expected.size());
+			CHECK(same(vec, expected));
+		}
+
+		vector<std::string> strings;
+		for (auto i = 0; i < 200; ++i) strings.push_back(std::to_string(i));
+		CHECK(strings.erase_if(policy, [](const std::string& str) { return str.back() != '0'; }) == 180);
+		REQUIRE(strings.size() == 20);
+		CHECK(strings[1] == "10");
+		CHECK(strings.back() == "190");
+
+		CHECK(strings.erase_if([](const std::string& str) { return str.size() > 2; }) == 10);
+	}
+
+	SECTION("small_vector growing out of its static storage") {
+		small_vector<int, 64> vec{1, 2, 3};
+		vec.resize(policy, 50, 4);
+		CHECK(vec.is_static());
+		vec.resize(policy, 500, 5);
+		CHECK(vec.is_dynamic());
+		REQUIRE(vec.size() == 500);
+		CHECK(vec[2] == 3);
+		CHECK(vec[49] == 4);
+		CHECK(vec[499] == 5);
+	}
+}
+
+TEST_CASE("vector parallel bulk operations with throwing copies") {
+	thread_pool pool(4);
+	const parallel_policy policy(pool, 8);
+
+	SECTION("resize destroys the chunks that were built") {
+		{
+			fragile::copies_left = 60;
+			vector<fragile> vec(10, fragile(0));
+			CHECK_THROWS_AS(vec.resize(policy, 200, fragile(1)), std::runtime_error);
+			CHECK(vec.size() == 10);
+			CHECK(fragile::live == 10);
+		}
+		CHECK(fragile::live == 0);
+	}
+
+	SECTION("copy construction") {
+		fragile::copies_left = 160;
+		vector<fragile> original(100, fragile(0));
+		CHECK_THROWS_AS(vector<fragile>(policy, original), std::runtime_error);
+		CHECK(fragile::live == 100);
+	}
+
+	SECTION("copies that succeed") {
+		{
+			fragile::copies_left = 1000;
+			vector<fragile> original(100, fragile(0));
+			vector<fragile> copy(policy, original);
+			CHECK(copy.size() == 100);
+			CHECK(fragile::live == 200);
+		}
+		CHECK(fragile::live == 0);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/poly_vector.h>
+#include <cstdint>
+#include <string>
+
+using namespace perfvect;
+
+namespace {
+	struct Shape {
+		static inline int alive = 0;
+
+		Shape() { ++alive; }
+		Shape(const Shape&) { ++alive; }
+		virtual ~Shape() { --alive; }
+		[[nodiscard]] virtual auto area() const->int = 0;
+	};
+
+	struct Square : Shape {
+		int side;
+		explicit Square(int side) : side(side) {}
+		[[nodiscard]] auto area() const->int override { return side * side; }
+	};
+
+	struct Rect : Shape {
+		std::int8_t tag = 0;
+		double width;
+		std::string name;
+		Rect(double width, std::string name) : width(width), name(std::move(name)) {}
+		[[nodiscard]] auto area() const->int override { return static_cast<int>(width) * 2; }
+	};
+
+	struct Named {
+		virtual ~Named() = default;
+		std::string label = "named";
+	};
+
+	// Shape is not the first base, so its subobject is not at the start of the object
+	struct Labelled : Named, Shape {
+		[[nodiscard]] auto area() const->int override { return static_cast<int>(label.size()); }
+	};
+
+	template<typename Vec>
+	auto total_area(const Vec& vec) {
+		auto total = 0;
+		for (const auto& shape : vec) total += shape.area();
+		return total;
+	}
+}
+
+TEST_CASE("poly_vector(), poly_vector::size(), poly_vector::empty()") {
+	poly_vector<Shape> vec;
+	CHECK(vec.size() == 0);
+	CHECK(vec.empty());
+	CHECK(vec.bytes_used() == 0);
+	CHECK(vec.begin() == vec.end());
+}
+
+TEST_CASE("poly_vector::emplace_back<Derived>(Args&&...)") {
+	Shape::alive = 0;
+	{
+		poly_vector<Shape> vec;
+		auto& square = vec.emplace_back<Square>(3);
+		CHECK(square.side == 3);
+		vec.emplace_back<Rect>(5.0, "a rectangle whose name defeats the small string optimisation");
+		vec.emplace_back<Labelled>();
+		vec.push_back(Square(4));
+
+		REQUIRE(vec.size() == 4);
+		CHECK(Shape::alive == 4);
+		CHECK(vec[0].area() == 9);
+		CHECK(vec[1].area() == 10);
+		CHECK(vec.at(2).area() == 5);
+		CHECK(vec.back().area() == 16);
+		CHECK_THROWS_AS(vec.at(4), std::out_of_range);
+		CHECK(total_area(vec) == 40);
+		CHECK(vec.end() - vec.begin() == 4);
+
+		SECTION("elements relocate correctly on growth") {
+			for (auto i = 0; i < 200; ++i) vec.emplace_back<Rect>(1.0, std::to_string(i));
+			CHECK(Shape::alive == 204);
+			CHECK(vec.size() == 204);
+			CHECK(total_area(vec) == 440);
+			CHECK(static_cast<Rect&>(vec[1]).name.size() > 50);
+			CHECK(static_cast<Rect&>(vec[203]).name == "199");
+			CHECK(dynamic_cast<Labelled&>(vec[2]).label == "named");
+		}
+
+		SECTION("pop_back() reuses the space") {
+			const auto used = vec.bytes_used();
+			vec.pop_back();
+			CHECK(Shape::alive == 3);
+			CHECK(vec.bytes_used() < used);
+			vec.emplace_back<Square>(1);
+			CHECK(vec.bytes_used() == used);
+		}
+
+		SECTION("move construction steals the buffer") {
+			const auto first = &vec[0];
+			auto moved = std::move(vec);
+			CHECK(&moved[0] == first);
+			CHECK(moved.size() == 4);
+			CHECK(vec.empty());
+			CHECK(Shape::alive == 4);
+		}
+	}
+	CHECK(Shape::alive == 0);
+}
+
+TEST_CASE("poly_vector::clear()") {
+	Shape::alive = 0;
+	poly_vector<Shape> vec;
+	vec.reserve(256, 8);
+	CHECK(vec.byte_capacity() >= 256);
+	for (auto i = 0; i < 8; ++i) vec.emplace_back<Square>(i);
+	vec.clear();
+	CHECK(vec.empty());
+	CHECK(vec.bytes_used() == 0);
+	CHECK(Shape::alive == 0);
+}
+
+TEST_CASE("static_poly_vector") {
+	Shape::alive = 0;
+	{
+		static_poly_vector<Shape, 4 * sizeof(Square)> vec;
+		for (auto i = 1; i <= 4; ++i) vec.emplace_back<Square>(i);
+		CHECK(vec.size() == 4);
+		CHECK(total_area(vec) == 30);
+		CHECK_THROWS_AS(vec.emplace_back<Square>(5), std::length_error);
+		CHECK(Shape::alive == 4);
+
+		SECTION("move construction relocates the elements") {
+			auto moved = std::move(vec);
+			CHECK(moved.size() == 4);
+			CHECK(total_area(moved) == 30);
+			CHECK(vec.empty());
+			CHECK(Shape::alive == 4);
+		}
+	}
+	CHECK(Shape::alive == 0);
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/priority_queue.h>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace perfvect;
+
+namespace {
+	template<typename Queue>
+	auto drain(Queue& queue) {
+		std::vector<int> values;
+		while (!queue.empty()) {
+			values.push_back(queue.top());
+			queue.pop();
+		}
+		return values;
+	}
+
+	auto random_values(const std::size_t count, const unsigned seed) {
+		std::mt19937 rng(seed);
+		std::vector<int> values(count);
+		for (auto& value : values) value = static_cast<int>(rng() % 1000);
+		return values;
+	}
+
+	struct by_value {
+		auto operator()(const TestStruct& lhs, const TestStruct& rhs) const { return lhs.value < rhs.value; }
+	};
+}
+
+TEST_CASE("small_priority_queue(), small_priority_queue::size(), small_priority_queue::empty()") {
+	small_priority_queue<int> queue;
+	CHECK(queue.size() == 0);
+	CHECK(queue.empty());
+	CHECK(queue.capacity() == 16);
+}
+
+TEMPLATE_TEST_CASE_SIG("small_priority_queue::push(const T&), small_priority_queue::pop()", "", ((std::size_t Arity), Arity), 2, 4, 8) {
+	const auto values = random_values(500, Arity);
+	small_priority_queue<int, 16, std::less<int>, Arity> queue;
+	std::priority_queue<int> expected;
+	for (const auto value : values) {
+		queue.push(value);
+		expected.push(value);
+		REQUIRE(queue.top() == expected.top());
+	}
+
+	std::vector<int> expected_order;
+	while (!expected.empty()) {
+		expected_order.push_back(expected.top());
+		expected.pop();
+	}
+	CHECK(drain(queue) == expected_order);
+}
+
+TEST_CASE("small_priority_queue::push_range(InputIt, InputIt)") {
+	auto values = random_values(300, 1);
+	small_priority_queue<int, 16, std::greater<int>, 8> queue;
+
+	SECTION("heapifies a large batch") {
+		queue.push(5);
+		queue.push_range(values.begin(), values.end());
+	}
+
+	SECTION("sifts up a small batch") {
+		queue.push_range(values.begin(), values.begin() + 200);
+		queue.push_range(values.begin() + 200, values.end());
+		values.push_back(5);
+		queue.push(5);
+	}
+
+	if (values.size() == 300) values.push_back(5);
+	std::sort(values.begin(), values.end());
+	CHECK(queue.size() == values.size());
+	CHECK(drain(queue) == values);
+}
+
+TEST_CASE("small_priority_queue::pop_n(size_type)") {
+	small_priority_queue<int> queue{4, 9, 1, 7, 3};
+	const auto batch = queue.pop_n(3);
+	CHECK(std::vector<int>(batch.begin(), batch.end()) == std::vector<int>{9, 7, 4});
+	CHECK(queue.size() == 2);
+
+	std::vector<int> rest;
+	queue.pop_n(10, std::back_inserter(rest));
+	CHECK(rest == std::vector<int>{3, 1});
+	CHECK(queue.empty());
+}
+
+TEST_CASE("small_priority_queue::emplace(Args&&...)") {
+	TestStruct::setup();
+	small_priority_queue<TestStruct, 8, by_value, 4> queue;
+	for (auto i = 0; i < 8; ++i) queue.emplace(i);
+	CHECK(queue.top().value == 7);
+	queue.pop();
+	CHECK(queue.top().value == 6);
+	CHECK(TestStruct::copyConstructed == 0);
+	CHECK(TestStruct::copyAssigned == 0);
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/parallel.h>
+#include <perfvect/scan.h>
+#include <perfvect/small_vector.h>
+#include <perfvect/static_vector.h>
+#include <perfvect/vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace perfvect;
+
+namespace {
+	template<typename T>
+	auto expected_scan(const std::vector<T>& values, const bool exclusive, T carry) {
+		std::vector<T> expected;
+		for (const auto value : values) {
+			const auto next = detail::wrapping_add(carry, value);
+			expected.push_back(exclusive ? carry : next);
+			carry = next;
+		}
+		return std::make_pair(expected, carry);
+	}
+
+	template<typename Vec, typename Expected>
+	auto same(const Vec& vec, const Expected& expected) {
+		return std::equal(vec.begin(), vec.end(), expected.begin(), expected.end());
+	}
+}
+
+TEMPLATE_TEST_CASE("detail::scan(...), detail::delta_encode(...)", "", std::int8_t, std::uint16_t, std::int32_t, std::uint32_t, std::int64_t, float, double) {
+	std::mt19937_64 rng(5);
+	for (const std::size_t size : {0, 1, 2, 7, 8, 15, 16, 31, 33, 64, 100, 257}) {
+		const auto values = make_values<TestType>(rng, size, true);
+		const auto carry = static_cast<TestType>(3);
+		const auto inclusive = expected_scan(values, false, carry);
+		const auto exclusive = expected_scan(values, true, carry);
+
+		std::vector<TestType> deltas;
+		for (std::size_t i = 0; i < size; ++i) deltas.push_back(detail::wrapping_sub(values[i], i ? values[i - 1] : carry));
+
+		for (const auto level : simd_levels()) {
+			std::vector<TestType> out(size);
+			CHECK(detail::scan<false>(values.data(), out.data(), size, carry, level) == inclusive.second);
+			CHECK(out == inclusive.first);
+			CHECK(detail::scan<true>(values.data(), out.data(), size, carry, level) == exclusive.second);
+			CHECK(out == exclusive.first);
+
+			detail::delta_encode(values.data(), out.data(), size, carry, level);
+			CHECK(out == deltas);
+
+			auto in_place = values;
+			detail::scan<false>(in_place.data(), in_place.data(), size, carry, level);
+			CHECK(in_place == inclusive.first);
+			in_place = values;
+			detail::scan<true>(in_place.data(), in_place.data(), size, carry, level);
+			CHECK(in_place == exclusive.first);
+			in_place = values;
+			detail::delta_encode(in_place.data(), in_place.data(), size, carry, level);
+			CHECK(in_place == deltas);
+		}
+	}
+}
+
+TEST_CASE("inclusive_scan(vec), exclusive_scan(vec), delta_encode(vec), delta_decode(vec)") {
+	small_vector<std::uint32_t, 4> values{3, 1, 4, 1, 5, 9, 2, 6};
+
+	CHECK(inclusive_scan(values) == 31);
+	CHECK(same(values, std::vector<std::uint32_t>{3, 4, 8, 9, 14, 23, 25, 31}));
+
+	delta_encode(values);
+	CHECK(same(values, std::vector<std::uint32_t>{3, 1, 4, 1, 5, 9, 2, 6}));
+
+	CHECK(exclusive_scan(values, 10) == 41);
+	CHECK(same(values, std::vector<std::uint32_t>{10, 13, 14, 18, 19, 24, 33, 35}));
+
+	delta_encode(values, 10);
+	CHECK(same(values, std::vector<std::uint32_t>{0, 3, 1, 4, 1, 5, 9, 2}));
+	delta_decode(values, 10);
+	CHECK(same(values, std::vector<std::uint32_t>{10, 13, 14, 18, 19, 24, 33, 35}));
+
+	SECTION("signed integers wrap") {
+		static_vector<std::int32_t, 4> wrapping{std::numeric_limits<std::int32_t>::max(), 1, -1};
+		CHECK(inclusive_scan(wrapping) == std::numeric_limits<std::int32_t>::max());
+		CHECK(same(wrapping, std::vector<std::int32_t>{std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()}));
+		delta_encode(wrapping);
+		CHECK(same(wrapping, std::vector<std::int32_t>{std::numeric_limits<std::int32_t>::max(), 1, -1}));
+	}
+
+	SECTION("empty containers") {
+		vector<double> empty;
+		CHECK(inclusive_scan(empty, 2.5) == 2.5);
+		CHECK(exclusive_scan(empty) == 0.0);
+		delta_encode(empty);
+		delta_decode(empty);
+		CHECK(empty.empty());
+	}
+}
+
+TEST_CASE("inclusive_scan_into(src, out), exclusive_scan_into(src, out), delta_encode_into(src, out), delta_decode_into(src, out)") {
+	const vector<std::int64_t> src{5, -2, 7, 0, 3};
+
+	SECTION("the result is appended") {
+		small_vector<std::int64_t, 4> out{100};
+		out.reserve(11);
+		CHECK(inclusive_scan_into(src, out) == 13);
+		CHECK(exclusive_scan_into(src, out, 1) == 14);
+		CHECK(same(out, std::vector<std::int64_t>{100, 5, 3, 10, 10, 13, 1, 6, 4, 11, 11}));
+	}
+
+	SECTION("delta coding round trips") {
+		static_vector<std::int64_t, 8> deltas;
+		delta_encode_into(src, deltas, 1);
+		CHECK(same(deltas, std::vector<std::int64_t>{4, -7, 9, -7, 3}));
+		static_vector<std::int64_t, 8> decoded;
+		delta_decode_into(deltas, decoded, 1);
+		CHECK(same(decoded, src));
+	}
+
+	SECTION("out needs spare capacity for every element") {
+		static_vector<std::int64_t, 8> out{1, 2, 3, 4};
+		CHECK_THROWS_AS(inclusive_scan_into(src, out), std::length_error);
+		CHECK_THROWS_AS(delta_encode_into(src, out), std::length_error);
+		CHECK(out.size() == 4);
+	}
+}
+
+TEST_CASE("histogram(values, counts)") {
+	const vector<std::int16_t> values{0, 3, 3, -1, 7, 2, 3, 0, 100, 5};
+	vector<std::uint32_t> counts(6, 0);
+
+	CHECK(histogram(values, counts) == 3);
+	CHECK(same(counts, std::vector<std::uint32_t>{2, 0, 1, 3, 0, 1}));
+
+	SECTION("counts are added to") {
+		CHECK(histogram(values, counts) == 3);
+		CHECK(same(counts, std::vector<std::uint32_t>{4, 0, 2, 6, 0, 2}));
+	}
+
+	SECTION("every path matches a plain count") {
+		std::mt19937_64 rng(9);
+		for (const std::size_t bins : {1, 5, 256, 300, 2000}) {
+			for (const std::size_t size : {3, 100, 5000}) {
+				vector<std::uint8_t> bytes;
+				vector<std::uint64_t> wide;
+				for (std::size_t i = 0; i < size; ++i) {
+					bytes.push_back(static_cast<std::uint8_t>(rng()));
+					wide.push_back(rng() % (bins + bins / 4 + 1));
+				}
+
+				std::vector<std::size_t> expected_bytes(bins, 0);
+				std::vector<std::size_t> expected_wide(bins, 0);
+				std::size_t outside_bytes = 0;
+				std::size_t outside_wide = 0;
+				for (const auto value : bytes) value < bins ? ++expected_bytes[value] : ++outside_bytes;
+				for (const auto value : wide) value < bins ? ++expected_wide[static_cast<std::size_t>(value)] : ++outside_wide;
+
+				vector<std::size_t> byte_counts(bins, 0);
+				vector<std::size_t> wide_counts(bins, 0);
+				CHECK(histogram(bytes, byte_counts) == outside_bytes);
+				CHECK(histogram(wide, wide_counts) == outside_wide);
+				CHECK(same(byte_counts, expected_bytes));
+				CHECK(same(wide_counts, expected_wide));
+			}
+		}
+	}
+}
+
+TEST_CASE("parallel scans, delta coding and histograms") {
+	thread_pool pool(4);
+	const parallel_policy policy(pool, 16);
+
+	std::mt19937_64 rng(13);
+	for (const std::size_t size : {0, 10, 63, 64, 1000, 4099}) {
+		vector<std::uint32_t> values;
+		for (std::size_t i = 0; i < size; ++i) values.push_back(static_cast<std::uint32_t>(rng()));
+		const std::vector<std::uint32_t> original(values.begin(), values.end());
+		const auto inclusive = expected_scan(original, false, std::uint32_t{7});
+		const auto exclusive = expected_scan(original, true, std::uint32_t{7});
+
+		auto scanned = values;
+		CHECK(inclusive_scan(policy, scanned, 7) == inclusive.second);
+		CHECK(same(scanned, inclusive.first));
+		scanned = values;
+		CHECK(exclusive_scan(policy, scanned, 7) == exclusive.second);
+		CHECK(same(scanned, exclusive.first));
+
+		vector<std::uint32_t> out;
+		out.reserve(2 * size);
+		CHECK(inclusive_scan_into(policy, values, out, 7) == inclusive.second);
+		CHECK(exclusive_scan_into(policy, values, out, 7) == exclusive.second);
+		CHECK(std::equal(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(size), inclusive.first.begin(), inclusive.first.end()));
+		CHECK(std::equal(out.begin() + static_cast<std::ptrdiff_t>(size), out.end(), exclusive.first.begin(), exclusive.first.end()));
+
+		auto coded = values;
+		delta_encode(policy, coded, 7);
+		vector<std::uint32_t> serial = values;
+		delta_encode(serial, 7);
+		CHECK(same(coded, serial));
+		vector<std::uint32_t> decoded;
+		decoded.reserve(size);
+		delta_decode_into(policy, coded, decoded, 7);
+		CHECK(same(decoded, original));
+		vector<std::uint32_t> encoded;
+		encoded.reserve(size);
+		delta_encode_into(policy, values, encoded, 7);
+		CHECK(same(encoded, serial));
+		delta_decode(policy, coded, 7);
+		CHECK(same(coded, original));
+
+		vector<std::uint32_t> small_values;
+		for (const auto value : original) small_values.push_back(value % 40);
+		vector<std::uint64_t> counts(32, 1);
+		vector<std::uint64_t> serial_counts(32, 1);
+		CHECK(histogram(policy, small_values, counts) == histogram(small_values, serial_counts));
+		CHECK(counts == serial_counts);
+	}
+
+	SECTION("chunk totals wrap like the serial scan") {
+		vector<std::int32_t> values(1000, std::numeric_limits<std::int32_t>::max() / 100);
+		std::vector<std::int32_t> original(values.begin(), values.end());
+		const auto expected = expected_scan(original, false, std::int32_t{0});
+		CHECK(inclusive_scan(policy, values) == expected.second);
+		CHECK(same(values, expected.first));
+	}
+}
@@ -0,0 +1,139 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/set_operations.h>
+#include <perfvect/small_vector.h>
+#include <perfvect/static_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace perfvect;
+
+namespace {
+	// ascending values without repeats, about one in every stride of the value range
+	template<typename T>
+	auto make_set(std::mt19937& rng, const std::size_t count, const int stride) {
+		std::vector<T> values;
+		auto value = std::is_signed_v<T> ? static_cast<long long>(rng() % 8) - 4 : static_cast<long long>(rng() % 8);
+		for (std::size_t i = 0; i < count; ++i) {
+			value += 1 + static_cast<long long>(rng() % static_cast<unsigned>(stride));
+			values.push_back(static_cast<T>(value));
+		}
+		return values;
+	}
+}
+
+TEMPLATE_TEST_CASE("detail::intersect_sorted(...), detail::difference_sorted(...)", "", std::int16_t, std::uint32_t, int, std::int64_t, std::uint64_t, float) {
+	std::vector<detail::simd_level> levels{detail::simd_level::scalar};
+	if (detail::simd_level_supported() >= detail::simd_level::avx2) levels.push_back(detail::simd_level::avx2);
+
+	std::mt19937 rng(3);
+	const std::pair<std::size_t, std::size_t> sizes[] = {{0, 0}, {0, 10}, {10, 0}, {1, 1}, {7, 9}, {37, 41}, {200, 190}, {500, 3}, {3, 500}, {40, 2000}};
+	for (const auto& size : sizes) {
+		for (const auto stride : {1, 2, 5}) {
+			const auto a = make_set<TestType>(rng, size.first, stride);
+			const auto b = make_set<TestType>(rng, size.second, stride);
+
+			std::vector<TestType> intersection;
+			std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(intersection));
+			std::vector<TestType> difference;
+			std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(difference));
+
+			for (const auto level : levels) {
+				std::vector<TestType> out(a.size() + b.size());
+				out.resize(detail::intersect_sorted(a.data(), a.size(), b.data(), b.size(), out.data(), level));
+				REQUIRE(out == intersection);
+
+				out.assign(a.size(), TestType{});
+				out.resize(detail::difference_sorted(a.data(), a.size(), b.data(), b.size(), out.data(), level));
+				REQUIRE(out == difference);
+			}
+		}
+	}
+}
+
+TEST_CASE("intersect_into(a, b, out), union_into(a, b, out), difference_into(a, b, out), merge_into(a, b, out)") {
+	std::mt19937 rng(11);
+	const std::pair<std::size_t, std::size_t> sizes[] = {{0, 5}, {5, 0}, {60, 70}, {1000, 900}, {3000, 20}, {20, 3000}};
+	for (const auto& size : sizes) {
+		const auto a_values = make_set<std::uint32_t>(rng, size.first, 3);
+		const auto b_values = make_set<std::uint32_t>(rng, size.second, 3);
+		const small_vector<std::uint32_t, 64> a(a_values.begin(), a_values.end());
+		const small_vector<std::uint32_t, 64> b(b_values.begin(), b_values.end());
+		small_vector<std::uint32_t, 16> out{7};
+		out.reserve(1 + a.size() + b.size());
+
+		std::vector<std::uint32_t> expected{7};
+		const auto intersect_count = intersect_into(a, b, out);
+		CHECK(intersect_count == out.size() - 1);
+		std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+		CHECK(std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+
+		out.erase(out.begin() + 1, out.end());
+		expected.resize(1);
+		const auto union_count = union_into(a, b, out);
+		CHECK(union_count == out.size() - 1);
+		std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+		CHECK(std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+
+		out.erase(out.begin() + 1, out.end());
+		expected.resize(1);
+		const auto difference_count = difference_into(a, b, out);
+		CHECK(difference_count == out.size() - 1);
+		std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+		CHECK(std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+	}
+
+	SECTION("merge keeps repeats, those of a first") {
+		const static_vector<double, 8> a{1.0, 2.0, 2.0, 5.0};
+		const static_vector<double, 8> b{0.5, 2.0, 5.0, 5.0, 9.0};
+		static_vector<double, 16> out;
+		CHECK(merge_into(a, b, out) == 9);
+		CHECK(out == static_vector<double, 16>{0.5, 1.0, 2.0, 2.0, 2.0, 5.0, 5.0, 5.0, 9.0});
+
+		for (const std::size_t size : {4, 64, 1000}) {
+			std::vector<int> big(size);
+			for (std::size_t i = 0; i < size; ++i) big[i] = static_cast<int>(i / 3);
+			const vector<int> large(big.begin(), big.end());
+			const vector<int> small{-1, 0, 1, 1, 100000};
+			for (const auto swapped : {false, true}) {
+				vector<int> merged;
+				merged.reserve(large.size() + small.size());
+				const auto& first = swapped ? small : large;
+				const auto& second = swapped ? large : small;
+				CHECK(merge_into(first, second, merged) == large.size() + small.size());
+				CHECK(std::is_sorted(merged.begin(), merged.end()));
+			}
+		}
+	}
+
+	SECTION("other element types go through the std algorithms") {
+		const small_vector<std::string, 4> a{"ant", "bee", "cat", "dog"};
+		const small_vector<std::string, 4> b{"bee", "dog", "eel"};
+		small_vector<std::string, 8> out;
+		CHECK(intersect_into(a, b, out) == 2);
+		CHECK(out == small_vector<std::string, 8>{"bee", "dog"});
+		out.clear();
+		CHECK(union_into(a, b, out) == 5);
+		out.clear();
+		CHECK(difference_into(a, b, out) == 2);
+		CHECK(out == small_vector<std::string, 8>{"ant", "cat"});
+		out.clear();
+		CHECK(merge_into(a, b, out) == 7);
+	}
+
+	SECTION("the destination needs spare capacity for the largest result") {
+		const static_vector<int, 8> a{1, 2, 3};
+		const static_vector<int, 8> b{2, 3, 4};
+		static_vector<int, 5> out{9, 9};
+		CHECK(intersect_into(a, b, out) == 2);
+		CHECK_THROWS_AS(union_into(a, b, out), std::length_error);
+		CHECK_THROWS_AS(difference_into(a, b, out), std::length_error);
+		CHECK(out == static_vector<int, 5>{9, 9, 2, 3});
+	}
+}
\ No newline at end of file
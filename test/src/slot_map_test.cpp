@@ -0,0 +1,112 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/slot_map.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace perfvect;
+
+TEST_CASE("slot_map(), slot_map::size(), slot_map::empty()") {
+	slot_map<int> map;
+	CHECK(map.size() == 0);
+	CHECK(map.empty());
+	CHECK(map.begin() == map.end());
+	CHECK_FALSE(map.contains(slot_handle{}));
+}
+
+TEST_CASE("slot_map::insert(const T&), slot_map::emplace(Args&&...)") {
+	slot_map<int> map;
+	const auto a = map.insert(1);
+	const auto b = map.emplace(2);
+	REQUIRE(map.size() == 2);
+	CHECK(a != b);
+	CHECK(map.contains(a));
+	CHECK(map.contains(b));
+	CHECK(map[a] == 1);
+	CHECK(map[b] == 2);
+	CHECK(*map.get(b) == 2);
+	CHECK(std::accumulate(map.begin(), map.end(), 0) == 3);
+}
+
+TEST_CASE("slot_map::erase(handle_type)") {
+	slot_map<int> map;
+	std::vector<slot_handle> handles;
+	for (auto i = 0; i < 10; ++i) handles.push_back(map.insert(i));
+
+	SECTION("moves the last value into the hole") {
+		CHECK(map.erase(handles[2]));
+		REQUIRE(map.size() == 9);
+		CHECK(map.data()[2] == 9);
+		CHECK(map.handle_at(2) == handles[9]);
+		for (auto i = 0; i < 10; ++i) {
+			if (i == 2) continue;
+			REQUIRE(map.contains(handles[i]));
+			CHECK(map[handles[i]] == i);
+		}
+	}
+
+	SECTION("stale handles are rejected") {
+		CHECK(map.erase(handles[4]));
+		CHECK_FALSE(map.erase(handles[4]));
+		CHECK_FALSE(map.contains(handles[4]));
+		CHECK(map.get(handles[4]) == nullptr);
+		CHECK_THROWS_AS(map.at(handles[4]), std::out_of_range);
+
+		const auto reused = map.insert(40);
+		CHECK(reused.index == handles[4].index);
+		CHECK(reused.generation != handles[4].generation);
+		CHECK_FALSE(map.contains(handles[4]));
+		CHECK(map.at(reused) == 40);
+	}
+
+	SECTION("erase every element") {
+		for (const auto handle : handles) CHECK(map.erase(handle));
+		CHECK(map.empty());
+		for (const auto handle : handles) CHECK_FALSE(map.contains(handle));
+	}
+}
+
+TEST_CASE("slot_map::clear()") {
+	TestStruct::setup();
+	slot_map<TestStruct> map;
+	map.reserve(2);
+	const auto a = map.emplace(1);
+	const auto b = map.emplace(2);
+	map.clear();
+	CHECK(map.empty());
+	CHECK_FALSE(map.contains(a));
+	CHECK_FALSE(map.contains(b));
+	CHECK(TestStruct::destructed == 2);
+
+	const auto c = map.emplace(3);
+	CHECK(map.contains(c));
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("small_slot_map") {
+	small_slot_map<int, 4> map;
+	std::vector<slot_handle> handles;
+	for (auto i = 0; i < 4; ++i) handles.push_back(map.insert(i));
+	CHECK(map.capacity() == 4);
+
+	SECTION("grows past static capacity") {
+		for (auto i = 4; i < 20; ++i) handles.push_back(map.insert(i));
+		REQUIRE(map.size() == 20);
+		for (auto i = 0; i < 20; ++i) CHECK(map[handles[i]] == i);
+	}
+
+	SECTION("churn keeps handles consistent") {
+		for (auto round = 0; round < 50; ++round) {
+			const auto victim = static_cast<std::size_t>(round) % handles.size();
+			const auto value = map[handles[victim]];
+			REQUIRE(map.erase(handles[victim]));
+			handles[victim] = map.insert(value);
+		}
+		REQUIRE(map.size() == 4);
+		for (auto i = 0; i < 4; ++i) CHECK(map[handles[i]] == i);
+		std::vector<int> values(map.begin(), map.end());
+		std::sort(values.begin(), values.end());
+		CHECK(values == std::vector<int>{0, 1, 2, 3});
+	}
+}
\ No newline at end of file
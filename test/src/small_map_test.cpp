@@ -0,0 +1,148 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/small_map.h>
+#include <string>
+#include <vector>
+
+using namespace perfvect;
+
+TEST_CASE("small_map(), small_map::size(), small_map::empty()") {
+	small_map<int, int, 4> map;
+	CHECK(map.size() == 0);
+	CHECK(map.empty());
+	CHECK_FALSE(map.is_indexed());
+	CHECK(map.begin() == map.end());
+	CHECK(map.find(1) == map.end());
+	CHECK_FALSE(map.contains(1));
+}
+
+TEST_CASE("small_map::try_emplace(K&&, Args&&...), small_map::insert(value_type)") {
+	small_map<std::string, int, 4> map;
+	const auto [it, inserted] = map.try_emplace("one", 1);
+	CHECK(inserted);
+	CHECK(it->first == "one");
+	CHECK(it->second == 1);
+
+	SECTION("existing keys are left alone") {
+		const auto [again, inserted_again] = map.try_emplace("one", 10);
+		CHECK_FALSE(inserted_again);
+		CHECK(again == it);
+		CHECK(map.at("one") == 1);
+		CHECK_FALSE(map.insert({"one", 11}).second);
+		CHECK(map.size() == 1);
+	}
+
+	SECTION("insert_or_assign overwrites") {
+		CHECK_FALSE(map.insert_or_assign("one", 12).second);
+		CHECK(map.insert_or_assign("two", 2).second);
+		CHECK(map.at("one") == 12);
+		CHECK(map.at("two") == 2);
+	}
+
+	SECTION("operator[] default constructs missing values") {
+		map["two"] += 2;
+		CHECK(map["two"] == 2);
+		CHECK(map.size() == 2);
+	}
+
+	SECTION("at throws for missing keys") {
+		CHECK_THROWS_AS(map.at("missing"), std::out_of_range);
+		const auto& cmap = map;
+		CHECK_THROWS_AS(cmap.at("missing"), std::out_of_range);
+	}
+}
+
+TEST_CASE("small_map::is_indexed()") {
+	small_map<int, int, 4> map;
+	for (auto i = 0; i < 4; ++i) map[i] = i * 10;
+	CHECK_FALSE(map.is_indexed());
+
+	map[4] = 40;
+	CHECK(map.is_indexed());
+
+	SECTION("entries keep insertion order across promotion and growth") {
+		for (auto i = 5; i < 200; ++i) map[i] = i * 10;
+		auto expected = 0;
+		for (const auto& [key, value] : map) {
+			REQUIRE(key == expected);
+			CHECK(value == expected * 10);
+			++expected;
+		}
+		CHECK(expected == 200);
+		for (auto i = 0; i < 200; ++i) CHECK(map.at(i) == i * 10);
+		CHECK_FALSE(map.contains(200));
+	}
+
+	SECTION("clear returns the map to linear lookups") {
+		map.clear();
+		CHECK(map.empty());
+		CHECK_FALSE(map.is_indexed());
+		map[1] = 1;
+		CHECK_FALSE(map.is_indexed());
+	}
+
+	SECTION("promotion does not move the entries already inline") {
+		small_map<int, int, 8> inline_map;
+		for (auto i = 0; i < 4; ++i) inline_map[i] = i;
+		const auto data = &*inline_map.begin();
+		inline_map.reserve(8);
+		CHECK(&*inline_map.begin() == data);
+	}
+}
+
+TEST_CASE("small_map::erase(const key_type&), small_map::erase(const_iterator)") {
+	SECTION("linear") {
+		small_map<int, int, 8> map{{1, 1}, {2, 2}, {3, 3}};
+		CHECK(map.erase(2) == 1);
+		CHECK(map.erase(2) == 0);
+		REQUIRE(map.size() == 2);
+		CHECK(map.begin()->first == 1);
+		CHECK((map.begin() + 1)->first == 3);
+	}
+
+	SECTION("indexed, with colliding hashes") {
+		small_map<int, int, 4, clustered_hash> map;
+		for (auto i = 0; i < 50; ++i) map[i] = i;
+		REQUIRE(map.is_indexed());
+
+		for (auto i = 0; i < 50; i += 2) CHECK(map.erase(i) == 1);
+		REQUIRE(map.size() == 25);
+		auto expected = 1;
+		for (const auto& entry : map) {
+			CHECK(entry.first == expected);
+			expected += 2;
+		}
+		for (auto i = 0; i < 50; ++i) CHECK(map.contains(i) == (i % 2 == 1));
+
+		const auto next = map.erase(map.find(25));
+		CHECK(next->first == 27);
+		CHECK_FALSE(map.contains(25));
+		CHECK(map.at(27) == 27);
+	}
+}
+
+TEST_CASE("small_map::reserve(size_type)") {
+	small_map<int, TestStruct, 4> map;
+	map.reserve(64);
+	CHECK(map.is_indexed());
+
+	TestStruct::setup();
+	for (auto i = 0; i < 64; ++i) map.try_emplace(i, i);
+	CHECK(TestStruct::valueConstructed == 64);
+	CHECK(TestStruct::moveConstructed == 0);
+	CHECK(TestStruct::copyConstructed == 0);
+	for (auto i = 0; i < 64; ++i) CHECK(map.at(i).value == i);
+}
+
+TEST_CASE("small_map::swap(small_map&)") {
+	small_map<int, int, 2> a{{1, 1}, {2, 2}, {3, 3}};
+	small_map<int, int, 2> b{{4, 4}};
+	a.swap(b);
+	CHECK(a.size() == 1);
+	CHECK_FALSE(a.is_indexed());
+	CHECK(a.at(4) == 4);
+	CHECK(b.size() == 3);
+	CHECK(b.is_indexed());
+	CHECK(b.at(3) == 3);
+	CHECK_FALSE(b.contains(4));
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "catch.hpp"
+#include <perfvect/small_string.h>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+
+using namespace std::literals;
+using namespace perfvect;
+
+TEST_CASE("small_string(), small_string::size(), small_string::capacity()") {
+	small_string<31> str;
+	CHECK(str.size() == 0);
+	CHECK(str.empty());
+	CHECK(str.capacity() == 31);
+	CHECK(str.c_str()[0] == '\0');
+}
+
+TEST_CASE("small_string(const CharT*), small_string(std::string_view)") {
+	SECTION("static variant") {
+		small_string<8> str("hello");
+		CHECK(str.size() == 5);
+		CHECK(std::strcmp(str.c_str(), "hello") == 0);
+	}
+
+	SECTION("dynamic variant") {
+		small_string<8> str("hello world, this is long"sv);
+		CHECK(str.capacity() >= 25);
+		CHECK(str.size() == 25);
+		CHECK(std::strcmp(str.c_str(), "hello world, this is long") == 0);
+	}
+}
+
+TEST_CASE("static_string(size_type, CharT)") {
+	static_string<4> str(3, 'x');
+	CHECK(str.capacity() == 4);
+	CHECK(str == "xxx");
+	CHECK(str.c_str()[3] == '\0');
+}
+
+TEST_CASE("small_string::append(), small_string::push_back(), small_string::pop_back()") {
+	small_string<4> str;
+
+	SECTION("stays null terminated across growth") {
+		str.append("ab").append(3, 'c');
+		str += 'd';
+		str += "ef"sv;
+		CHECK(str == "abcccdef");
+		CHECK(str.c_str()[8] == '\0');
+		str.pop_back();
+		CHECK(str == "abcccde");
+		CHECK(str.c_str()[7] == '\0');
+	}
+
+	SECTION("appending a view of itself") {
+		str = "abcdefgh";
+		str += str.view();
+		CHECK(str == "abcdefghabcdefgh");
+		str.append(str.view().substr(2, 3));
+		CHECK(str == "abcdefghabcdefghcde");
+		CHECK(str.c_str()[19] == '\0');
+	}
+
+	SECTION("clear") {
+		str = "some longer string";
+		str.clear();
+		CHECK(str.empty());
+		CHECK(str.c_str()[0] == '\0');
+	}
+}
+
+TEST_CASE("small_string::append_uninitialized(size_type)") {
+	small_string<16> str("id:");
+	auto dest = str.append_uninitialized(4);
+	std::memcpy(dest, "1234", 4);
+	CHECK(str == "id:1234");
+	CHECK(str.c_str()[7] == '\0');
+}
+
+TEST_CASE("small_string::resize(), small_string::resize_uninitialized()") {
+	small_string<4> str("abc");
+	str.resize(6, 'z');
+	CHECK(str == "abczzz");
+	str.resize(2);
+	CHECK(str == "ab");
+	str.resize_uninitialized(3);
+	str[2] = 'q';
+	CHECK(str == "abq");
+	CHECK(str.c_str()[3] == '\0');
+}
+
+TEST_CASE("small_string::find(), small_string::rfind(), small_string::contains()") {
+	small_string<16> str("abcabc");
+	CHECK(str.find('b') == 1);
+	CHECK(str.find('b', 2) == 4);
+	CHECK(str.find('z') == str.npos);
+	CHECK(str.find("ca") == 2);
+	CHECK(str.rfind('a') == 3);
+	CHECK(str.rfind("bc") == 4);
+	CHECK(str.contains("cab"));
+	CHECK(!str.contains('d'));
+	CHECK(str.starts_with("abc"));
+	CHECK(str.ends_with("bc"));
+	CHECK(!str.ends_with("abcabcabc"));
+}
+
+TEST_CASE("small_string comparison") {
+	small_string<8> lhs("apple");
+	static_string<16> rhs("banana");
+
+	CHECK(lhs == "apple");
+	CHECK("apple" == lhs);
+	CHECK(lhs == "apple"s);
+	CHECK(lhs == "apple"sv);
+	CHECK("apple"sv == lhs);
+	CHECK(lhs != rhs);
+	CHECK(lhs < rhs);
+	CHECK(rhs > lhs);
+	CHECK(lhs <= "apple");
+	CHECK("banana" >= rhs);
+	CHECK(lhs.compare("apples") < 0);
+}
+
+TEST_CASE("small_string interoperates with std::string") {
+	small_string<8> str("text");
+	std::string_view view = str;
+	std::string copy(str);
+	CHECK(view == "text");
+	CHECK(copy == "text");
+
+	std::unordered_set<small_string<8>> set;
+	set.insert(str);
+	CHECK(set.count(small_string<8>("text")) == 1);
+}
\ No newline at end of file
@@ -1,7 +1,15 @@
 #include "catch.hpp"
 #include "helper.h"
 #include <perfvect/small_vector.h>
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
 #include <vector>
 #include <iostream>
 #include <chrono>
@@ -448,6 +456,19 @@ TEST_CASE("small_vector::reserve(size_type)") {
 	CHECK(vec.capacity() == 8);
 }
 
+TEST_CASE("small_vector::fill(const value_type&)") {
+	small_vector<int, 4> vec;
+	vec.fill(7);
+	REQUIRE(vec.size() == 4);
+	CHECK(vec[0] == 7);
+	CHECK(vec[3] == 7);
+
+	vec.reserve(6);
+	vec.fill(8);
+	CHECK(vec.size() == vec.capacity());
+	CHECK(std::all_of(vec.begin(), vec.end(), [](const int value) { return value == 8; }));
+}
+
 TEST_CASE("small_vector::shrink_to_fit()") {
 	auto vec = small_vector<int, 2, 4>({1});
 	vec.shrink_to_fit();
@@ -491,4 +512,263 @@ TEST_CASE("small_vector::insert(const_iterator, T&&)") {
 	CHECK(it->wasMoveConstructed);
 	it = vec.insert(vec.begin() + 1, std::move(arr[1]));
 	CHECK(it->wasMoveConstructed);
-}
\ No newline at end of file
+}
+
+TEST_CASE("small_vector::resize_default_init(size_type)") {
+	SECTION("static variant") {
+		small_vector<TestStruct, 4> vec{1, 2};
+		TestStruct::setup();
+		vec.resize_default_init(4);
+		CHECK(vec.is_static());
+		CHECK(vec.size() == 4);
+		CHECK(TestStruct::defaultConstructed == 2);
+		CHECK(vec[0] == 1);
+	}
+
+	SECTION("dynamic variant") {
+		small_vector<int, 2, 8> vec{1, 2};
+		vec.resize_default_init(5);
+		CHECK(vec.is_dynamic());
+		CHECK(vec.size() == 5);
+		CHECK(vec.capacity() == 8);
+		CHECK(vec[1] == 2);
+	}
+
+	SECTION("shrink") {
+		small_vector<int, 4> vec{1, 2, 3};
+		vec.resize_default_init(1);
+		CHECK(vec.size() == 1);
+	}
+}
+namespace {
+	enum class colour : std::uint16_t { red, green, blue };
+
+	template<typename T>
+	auto value_at(const std::size_t idx) {
+		if constexpr (std::is_enum_v<T>) return static_cast<T>(idx % 3);
+		else return static_cast<T>(idx % 97);
+	}
+}
+
+TEMPLATE_TEST_CASE("small_vector::find(const value_type&), small_vector::count(const value_type&), operator==(...)", "", std::int8_t, std::uint16_t, int, std::uint64_t, float, double, colour) {
+	// every instruction set available here must agree with the scalar kernels, for every size around the block widths
+	std::vector<detail::simd_level> levels;
+	for (auto level = detail::simd_level::scalar; level <= detail::simd_level_supported(); level = static_cast<detail::simd_level>(static_cast<int>(level) + 1)) {
+		levels.push_back(level);
+	}
+
+	for (std::size_t size = 0; size <= 200; ++size) {
+		small_vector<TestType, 16> vec;
+		for (std::size_t i = 0; i < size; ++i) vec.push_back(value_at<TestType>(i * 7 + 3));
+		const auto needle = value_at<TestType>(size * 5);
+		const TestType needles[] = {value_at<TestType>(size + 40), needle};
+
+		const auto find = detail::find_eq_scalar(vec.data(), size, needle);
+		const auto count = detail::count_eq_scalar(vec.data(), size, needle);
+		const auto find_any = detail::find_eq_any_scalar(vec.data(), size, needles, 2);
+		for (const auto level : levels) {
+			REQUIRE(detail::find_eq(vec.data(), size, needle, level) == find);
+			REQUIRE(detail::count_eq(vec.data(), size, needle, level) == count);
+			REQUIRE(detail::find_eq_any(vec.data(), size, needles, 2, level) == find_any);
+		}
+
+		auto other = vec;
+		if (size) other[size / 2] = value_at<TestType>(size / 2 * 7 + 4);
+		for (const auto level : levels) {
+			REQUIRE(detail::mismatch(vec.data(), vec.data(), size, level) == size);
+			REQUIRE(detail::mismatch(vec.data(), other.data(), size, level) == (size ? size / 2 : 0));
+		}
+		CHECK(vec == vec);
+		CHECK((vec == other) == !size);
+
+		CHECK(vec.find(needle) == vec.begin() + static_cast<std::ptrdiff_t>(find));
+		CHECK(vec.contains(needle) == (find != size));
+		CHECK(vec.count(needle) == count);
+		CHECK(vec.find_if_eq_any(needles, 2) == vec.begin() + static_cast<std::ptrdiff_t>(find_any));
+	}
+}
+
+TEST_CASE("small_vector::find_if_eq_any(std::initializer_list)") {
+	small_vector<int, 4> vec{5, 1, 4, 1, 5, 9, 2, 6};
+	CHECK(vec.find_if_eq_any({9, 4}) == vec.begin() + 2);
+	CHECK(vec.find_if_eq_any({7, 8}) == vec.end());
+	CHECK(vec.find_if_eq_any({}) == vec.end());
+
+	small_vector<std::string, 4> strings{"a", "b", "c"};
+	CHECK(strings.find("b") == strings.begin() + 1);
+	CHECK(strings.count("c") == 1);
+	CHECK(strings.find_if_eq_any({"x", "c"}) == strings.begin() + 2);
+}
+
+TEST_CASE("small_vector::find(const value_type&) with floating point") {
+	small_vector<double, 4> vec{1.0, -0.0, std::numeric_limits<double>::quiet_NaN(), 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+	CHECK(vec.find(0.0) == vec.begin() + 1);
+	CHECK_FALSE(vec.contains(std::numeric_limits<double>::quiet_NaN()));
+}
+TEMPLATE_TEST_CASE("small_vector::erase_if(Pred)", "", std::uint8_t, std::int16_t, int, float, std::uint64_t, double) {
+	std::vector<detail::simd_level> levels{detail::simd_level::scalar};
+	if (detail::simd_level_supported() == detail::simd_level::avx512) levels.push_back(detail::simd_level::avx512);
+
+	for (std::size_t size = 0; size <= 300; size += 13) {
+		for (const auto divisor : {1, 2, 3, 7, 1000}) {
+			std::vector<TestType> source;
+			for (std::size_t i = 0; i < size; ++i) source.push_back(static_cast<TestType>(i % 100));
+			const auto pred = [divisor](const TestType value) { return static_cast<int>(value) % divisor == 0; };
+
+			std::vector<TestType> expected = source;
+			expected.erase(std::remove_if(expected.begin(), expected.end(), pred), expected.end());
+
+			for (const auto level : levels) {
+				auto compacted = source;
+				auto calls = std::size_t{0};
+				auto counting = [&](const TestType value) { ++calls; return pred(value); };
+				const auto kept = detail::compact_if(compacted.data(), compacted.size(), counting, level);
+				REQUIRE(kept == expected.size());
+				REQUIRE(calls == size);
+				compacted.resize(kept);
+				REQUIRE(compacted == expected);
+			}
+
+			small_vector<TestType, 16> vec(source.begin(), source.end());
+			CHECK(vec.erase_if(pred) == size - expected.size());
+			REQUIRE(vec.size() == expected.size());
+			CHECK(std::equal(vec.begin(), vec.end(), expected.begin()));
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("detail::compact_if(...) over whole blocks", "", int, std::uint64_t) {
+	std::vector<detail::simd_level> levels{detail::simd_level::scalar};
+	if (detail::simd_level_supported() == detail::simd_level::avx512) levels.push_back(detail::simd_level::avx512);
+	const auto odd = [](const TestType value) { return value % 2 != 0; };
+
+	// exactly one 64-byte vector, and exactly one and two blocks of 64 elements, so that no tail is left over
+	for (const std::size_t size : {64 / sizeof(TestType), std::size_t{64}, std::size_t{128}}) {
+		std::vector<TestType> source(size);
+		std::iota(source.begin(), source.end(), TestType{1});
+		std::vector<TestType> expected = source;
+		expected.erase(std::remove_if(expected.begin(), expected.end(), odd), expected.end());
+
+		for (const auto level : levels) {
+			auto compacted = source;
+			compacted.resize(detail::compact_if(compacted.data(), compacted.size(), odd, level));
+			CHECK(compacted == expected);
+		}
+	}
+}
+
+TEST_CASE("small_vector::erase_if(Pred) with non-trivial elements") {
+	small_vector<std::string, 2> vec{"keep", "drop", "keep too", "drop", "drop", "last"};
+	CHECK(vec.erase_if([](const std::string& str) { return str == "drop"; }) == 3);
+	CHECK(vec == small_vector<std::string, 2>{"keep", "keep too", "last"});
+	CHECK(vec.erase_if([](const std::string&) { return false; }) == 0);
+	CHECK(vec.size() == 3);
+}
+
+TEST_CASE("small_vector::erase_indices(const size_type*, size_type)") {
+	small_vector<int, 4> vec{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+	SECTION("runs between indices move down once") {
+		CHECK(vec.erase_indices({1, 2, 5, 9}) == 4);
+		CHECK(vec == small_vector<int, 4>{0, 3, 4, 6, 7, 8});
+	}
+
+	SECTION("repeated indices are ignored") {
+		const std::size_t indices[] = {0, 0, 3, 3, 3};
+		CHECK(vec.erase_indices(indices, 5) == 2);
+		CHECK(vec == small_vector<int, 4>{1, 2, 4, 5, 6, 7, 8, 9});
+	}
+
+	SECTION("no indices") {
+		CHECK(vec.erase_indices({}) == 0);
+		CHECK(vec.size() == 10);
+	}
+
+	SECTION("non-trivial elements") {
+		small_vector<std::string, 2> strings{"a", "b", "c", "d"};
+		CHECK(strings.erase_indices({0, 2}) == 2);
+		CHECK(strings == small_vector<std::string, 2>{"b", "d"});
+	}
+}
+TEMPLATE_TEST_CASE("small_vector::sort()", "", bool, std::int8_t, std::uint16_t, int, std::uint32_t, std::int64_t, float, double) {
+	std::mt19937_64 rng(7);
+	for (const std::size_t size : {0, 1, 2, 7, 8, 9, 31, 33, 64, 65, 200, 511, 512, 3000}) {
+		std::vector<TestType> expected;
+		for (std::size_t i = 0; i < size; ++i) {
+			if constexpr (std::is_floating_point_v<TestType>) expected.push_back(static_cast<TestType>(std::uniform_real_distribution<double>(-1e6, 1e6)(rng)));
+			else expected.push_back(static_cast<TestType>(rng()));
+		}
+		small_vector<TestType, 16> vec(expected.begin(), expected.end());
+		std::sort(expected.begin(), expected.end());
+
+		vec.sort();
+		REQUIRE(vec.size() == size);
+		CHECK(std::equal(vec.begin(), vec.end(), expected.begin()));
+	}
+}
+
+TEST_CASE("small_vector::sort() with floating point") {
+	small_vector<double, 4> vec{
+		2.0, -0.0, std::numeric_limits<double>::infinity(), -1.5, 0.0, -std::numeric_limits<double>::infinity(), 1e-300, -2.0
+	};
+	vec.sort();
+	CHECK(vec == small_vector<double, 4>{
+		-std::numeric_limits<double>::infinity(), -2.0, -1.5, -0.0, 0.0, 1e-300, 2.0, std::numeric_limits<double>::infinity()
+	});
+	CHECK(std::signbit(vec[3]));
+}
+
+TEST_CASE("small_vector::sort_by_key(Proj)") {
+	struct record {
+		std::string name;
+		std::int32_t rank;
+	};
+
+	for (const std::size_t size : {0, 5, 100, 2000}) {
+		small_vector<record, 8> vec;
+		for (std::size_t i = 0; i < size; ++i) vec.push_back({std::to_string(i), static_cast<std::int32_t>((i * 7919) % 1000) - 500});
+
+		vec.sort_by_key([](const record& rec) { return rec.rank; });
+		REQUIRE(vec.size() == size);
+		CHECK(std::is_sorted(vec.begin(), vec.end(), [](const record& a, const record& b) { return a.rank < b.rank; }));
+		for (const auto& rec : vec) CHECK(static_cast<std::int32_t>((std::stoul(rec.name) * 7919) % 1000) - 500 == rec.rank);
+	}
+
+	SECTION("non-arithmetic keys") {
+		small_vector<std::string, 2> strings{"pear", "fig", "apple", "banana"};
+		strings.sort_by_key([](const std::string& str) { return str.substr(1); });
+		CHECK(strings == small_vector<std::string, 2>{"banana", "pear", "fig", "apple"});
+	}
+}
+TEMPLATE_TEST_CASE("small_vector::dedup(), small_vector::dedup_unordered()", "", std::int8_t, std::uint16_t, int, std::uint64_t, double) {
+	std::mt19937_64 rng(11);
+	for (const std::size_t size : {0, 1, 2, 15, 16, 17, 128, 129, 1000}) {
+		std::vector<TestType> values;
+		for (std::size_t i = 0; i < size; ++i) values.push_back(static_cast<TestType>(rng() % (size / 3 + 1)));
+
+		std::vector<TestType> first_of_each;
+		for (const auto value : values) {
+			if (std::find(first_of_each.begin(), first_of_each.end(), value) == first_of_each.end()) first_of_each.push_back(value);
+		}
+		small_vector<TestType, 16> unordered(values.begin(), values.end());
+		CHECK(unordered.dedup_unordered() == size - first_of_each.size());
+		CHECK(std::equal(unordered.begin(), unordered.end(), first_of_each.begin(), first_of_each.end()));
+
+		auto sorted = values;
+		std::sort(sorted.begin(), sorted.end());
+		small_vector<TestType, 16> adjacent(sorted.begin(), sorted.end());
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+		CHECK(adjacent.dedup() == size - sorted.size());
+		CHECK(std::equal(adjacent.begin(), adjacent.end(), sorted.begin(), sorted.end()));
+	}
+}
+
+TEST_CASE("small_vector::dedup_unordered_by(Proj)") {
+	small_vector<std::string, 2> strings{"apple", "avocado", "banana", "cherry", "blueberry", "apricot", "cranberry"};
+	CHECK(strings.dedup_unordered_by([](const std::string& str) { return str.front(); }) == 4);
+	CHECK(strings == small_vector<std::string, 2>{"apple", "banana", "cherry"});
+
+	small_vector<std::string, 2> sorted{"a", "a", "b", "c", "c"};
+	CHECK(sorted.dedup() == 2);
+	CHECK(sorted == small_vector<std::string, 2>{"a", "b", "c"});
+}
@@ -0,0 +1,122 @@
+#include "catch.hpp"
+#include <perfvect/sorted_vector.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace perfvect;
+
+template<typename SortedVector>
+static auto sorted_contents(const SortedVector& vec) {
+	std::vector<typename SortedVector::value_type> out;
+	vec.for_each_sorted([&out](const auto& value) { out.push_back(value); });
+	return out;
+}
+
+TEMPLATE_TEST_CASE("sorted_vector(iterator, iterator)", "",
+	(sorted_vector<int, 8, sorted_layout::sorted>),
+	(sorted_vector<int, 8, sorted_layout::eytzinger>)) {
+	const std::vector<int> values{5, 3, 9, 1, 7, 3};
+	TestType vec(values.begin(), values.end());
+	CHECK(vec.size() == 6);
+	CHECK(sorted_contents(vec) == std::vector<int>{1, 3, 3, 5, 7, 9});
+}
+
+TEST_CASE("sorted_vector layouts") {
+	SECTION("sorted layout stores ascending order") {
+		sorted_vector<int, 8, sorted_layout::sorted> vec{4, 2, 6, 1, 3, 5, 7};
+		CHECK(std::vector<int>(vec.begin(), vec.end()) == std::vector<int>{1, 2, 3, 4, 5, 6, 7});
+	}
+
+	SECTION("eytzinger layout stores breadth-first order") {
+		sorted_vector<int, 8, sorted_layout::eytzinger> vec{4, 2, 6, 1, 3, 5, 7};
+		CHECK(std::vector<int>(vec.begin(), vec.end()) == std::vector<int>{4, 2, 6, 1, 3, 5, 7});
+	}
+}
+
+TEMPLATE_TEST_CASE("sorted_vector::lower_bound(), sorted_vector::find(), sorted_vector::contains()", "",
+	(sorted_vector<std::uint64_t, 16, sorted_layout::sorted>),
+	(sorted_vector<std::uint64_t, 16, sorted_layout::eytzinger>)) {
+	SECTION("empty") {
+		TestType vec;
+		CHECK(vec.lower_bound(1) == vec.end());
+		CHECK(!vec.contains(1));
+	}
+
+	SECTION("matches std::lower_bound for every size") {
+		for (std::uint64_t n = 1; n < 70; ++n) {
+			std::vector<std::uint64_t> values;
+			for (std::uint64_t i = 0; i < n; ++i) values.push_back(i * 2 + 1);
+			TestType vec(values.begin(), values.end());
+
+			for (std::uint64_t key = 0; key <= n * 2 + 1; ++key) {
+				const auto expected = std::lower_bound(values.begin(), values.end(), key);
+				const auto found = vec.lower_bound(key);
+				if (expected == values.end()) {
+					CHECK(found == vec.end());
+				}
+				else {
+					REQUIRE(found != vec.end());
+					CHECK(*found == *expected);
+				}
+				CHECK(vec.contains(key) == (key % 2 == 1 && key < n * 2));
+			}
+		}
+	}
+}
+
+TEST_CASE("sorted_vector with custom comparator") {
+	sorted_vector<int, 4, sorted_layout::eytzinger, std::greater<int>> vec{1, 5, 3};
+	CHECK(sorted_contents(vec) == std::vector<int>{5, 3, 1});
+	CHECK(*vec.lower_bound(4) == 3);
+	CHECK(vec.contains(5));
+}
+
+TEMPLATE_TEST_CASE("sorted_vector::insert()", "",
+	(sorted_vector<int, 4, sorted_layout::sorted>),
+	(sorted_vector<int, 4, sorted_layout::eytzinger>)) {
+	TestType vec{10, 20, 30};
+
+	SECTION("single value") {
+		vec.insert(15);
+		vec.insert(35);
+		vec.insert(5);
+		CHECK(sorted_contents(vec) == std::vector<int>{5, 10, 15, 20, 30, 35});
+		CHECK(vec.contains(15));
+	}
+
+	SECTION("batch merge") {
+		std::vector<int> batch{25, 1, 40, 20};
+		vec.insert(batch.begin(), batch.end());
+		CHECK(sorted_contents(vec) == std::vector<int>{1, 10, 20, 20, 25, 30, 40});
+		CHECK(vec.contains(25));
+		CHECK(!vec.contains(26));
+	}
+
+	SECTION("large random batches") {
+		std::mt19937 rng(42);
+		std::vector<int> all(vec.begin(), vec.end());
+		for (auto round = 0; round < 5; ++round) {
+			std::vector<int> batch(50);
+			for (auto& value : batch) value = static_cast<int>(rng() % 1000);
+			vec.insert(batch.begin(), batch.end());
+			all.insert(all.end(), batch.begin(), batch.end());
+		}
+		std::sort(all.begin(), all.end());
+		CHECK(sorted_contents(vec) == all);
+		for (const auto value : all) CHECK(vec.contains(value));
+	}
+}
+
+TEMPLATE_TEST_CASE("sorted_vector::erase(const T&)", "",
+	(sorted_vector<int, 4, sorted_layout::sorted>),
+	(sorted_vector<int, 4, sorted_layout::eytzinger>)) {
+	TestType vec{3, 1, 2, 3, 4};
+	CHECK(vec.erase(3) == 2);
+	CHECK(vec.erase(9) == 0);
+	CHECK(sorted_contents(vec) == std::vector<int>{1, 2, 4});
+	CHECK(!vec.contains(3));
+	CHECK(vec.contains(4));
+}
\ No newline at end of file
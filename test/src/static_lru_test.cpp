@@ -0,0 +1,179 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/static_lru.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace perfvect;
+
+namespace {
+	template<typename Cache>
+	auto recency_order(const Cache& cache) {
+		std::vector<int> keys;
+		cache.for_each([&](const int key, const auto&) { keys.push_back(key); });
+		return keys;
+	}
+}
+
+TEST_CASE("static_lru(), static_lru::size(), static_lru::empty()") {
+	static_lru<int, int, 4> cache;
+	CHECK(cache.size() == 0);
+	CHECK(cache.empty());
+	CHECK_FALSE(cache.full());
+	CHECK(cache.capacity() == 4);
+	CHECK(cache.find(1) == nullptr);
+	CHECK(cache.misses() == 1);
+	CHECK(cache.hits() == 0);
+}
+
+TEST_CASE("static_lru::insert_or_assign(K&&, M&&), static_lru::find(const key_type&)") {
+	static_lru<std::string, int, 3> cache;
+	cache.insert_or_assign("a", 1);
+	cache.insert_or_assign("b", 2);
+	cache.insert_or_assign("c", 3);
+	CHECK(cache.full());
+	CHECK(cache.front().first == "c");
+	CHECK(cache.back().first == "a");
+
+	SECTION("find marks the entry most recently used") {
+		REQUIRE(cache.find("a") != nullptr);
+		CHECK(*cache.find("a") == 1);
+		CHECK(cache.front().first == "a");
+		CHECK(cache.back().first == "b");
+		CHECK(cache.hits() == 2);
+	}
+
+	SECTION("inserting into a full cache evicts the least recently used entry") {
+		cache.insert_or_assign("d", 4);
+		CHECK(cache.size() == 3);
+		CHECK_FALSE(cache.contains("a"));
+		CHECK(cache.evictions() == 1);
+		CHECK(cache.back().first == "b");
+	}
+
+	SECTION("assigning an existing key replaces its value") {
+		CHECK(cache.insert_or_assign("a", 10) == 10);
+		CHECK(cache.size() == 3);
+		CHECK(*cache.peek("a") == 10);
+		CHECK(cache.front().first == "a");
+	}
+
+	SECTION("peek leaves recency and counters alone") {
+		CHECK(*cache.peek("a") == 1);
+		CHECK(cache.front().first == "c");
+		CHECK(cache.hits() == 0);
+		CHECK(cache.misses() == 0);
+		CHECK(cache.peek("z") == nullptr);
+	}
+}
+
+TEST_CASE("static_lru::try_emplace(K&&, Args&&...), static_lru::get_or_insert_with(K&&, Make&&)") {
+	static_lru<int, TestStruct, 2> cache;
+	TestStruct::setup();
+
+	auto [value, inserted] = cache.try_emplace(1, 10);
+	CHECK(inserted);
+	CHECK(value.value == 10);
+	CHECK(TestStruct::valueConstructed == 1);
+	CHECK(TestStruct::moveConstructed == 0);
+	CHECK_FALSE(cache.try_emplace(1, 11).second);
+	CHECK(cache.peek(1)->value == 10);
+
+	auto calls = 0;
+	const auto make = [&] { ++calls; return TestStruct(20); };
+	CHECK(cache.get_or_insert_with(2, make).value == 20);
+	CHECK(cache.get_or_insert_with(2, make).value == 20);
+	CHECK(calls == 1);
+	CHECK(cache.misses() == 1);
+	CHECK(cache.hits() == 1);
+
+	cache.reset_stats();
+	CHECK(cache.hits() == 0);
+	CHECK(cache.misses() == 0);
+}
+
+TEST_CASE("static_lru inserting from the entry it evicts") {
+	static_lru<std::string, std::string, 2> cache;
+	cache.insert_or_assign(std::string("first key, long enough for the heap"), std::string("first value, long enough for the heap"));
+	cache.insert_or_assign(std::string("second key"), std::string("second value"));
+
+	SECTION("insert_or_assign(K&&, M&&)") {
+		cache.insert_or_assign(std::string("third key"), *cache.peek("first key, long enough for the heap"));
+		CHECK(*cache.peek("third key") == "first value, long enough for the heap");
+	}
+
+	SECTION("try_emplace(K&&, Args&&...)") {
+		CHECK(cache.try_emplace(cache.back().first + " again", cache.back().second).second);
+		CHECK(*cache.peek("first key, long enough for the heap again") == "first value, long enough for the heap");
+	}
+
+	CHECK(cache.evictions() == 1);
+	CHECK(cache.size() == 2);
+	CHECK(cache.back().first == "second key");
+}
+
+TEST_CASE("static_lru::erase(const key_type&), static_lru::pop_back()") {
+	static_lru<int, int, 16, clustered_hash> cache;
+	for (auto i = 0; i < 16; ++i) cache.insert_or_assign(i, i * 10);
+
+	SECTION("removing entries keeps every other key reachable") {
+		for (auto i = 0; i < 16; i += 3) CHECK(cache.erase(i));
+		CHECK_FALSE(cache.erase(0));
+		for (auto i = 0; i < 16; ++i) {
+			if (i % 3 == 0) CHECK_FALSE(cache.contains(i));
+			else CHECK(*cache.peek(i) == i * 10);
+		}
+		CHECK(recency_order(cache) == std::vector<int>{14, 13, 11, 10, 8, 7, 5, 4, 2, 1});
+	}
+
+	SECTION("pop_back removes the least recently used entry") {
+		cache.pop_back();
+		CHECK_FALSE(cache.contains(0));
+		CHECK(cache.back().first == 1);
+		CHECK(cache.size() == 15);
+	}
+
+	SECTION("clear") {
+		cache.clear();
+		CHECK(cache.empty());
+		CHECK_FALSE(cache.contains(3));
+		cache.insert_or_assign(3, 3);
+		CHECK(recency_order(cache) == std::vector<int>{3});
+	}
+}
+
+TEST_CASE("static_lru matches a reference model") {
+	constexpr auto capacity = 32;
+	static_lru<int, int, capacity> cache;
+	std::vector<int> order;
+	std::unordered_map<int, int> values;
+	std::mt19937 rng(7);
+
+	for (auto i = 0; i < 5000; ++i) {
+		const auto key = static_cast<int>(rng() % 64);
+		const auto it = std::find(order.begin(), order.end(), key);
+		if (rng() % 4 == 0) {
+			CHECK(cache.erase(key) == (it != order.end()));
+			if (it != order.end()) {
+				order.erase(it);
+				values.erase(key);
+			}
+			continue;
+		}
+
+		cache.insert_or_assign(key, i);
+		if (it != order.end()) order.erase(it);
+		else if (order.size() == capacity) {
+			values.erase(order.back());
+			order.pop_back();
+		}
+		order.insert(order.begin(), key);
+		values[key] = i;
+
+		REQUIRE(recency_order(cache) == order);
+	}
+	for (const auto& [key, value] : values) CHECK(*cache.peek(key) == value);
+}
\ No newline at end of file
@@ -744,4 +744,171 @@ TEST_CASE("static_vector::crbegin(), static_vector::crend()") {
 		++it;
 		REQUIRE(it == vec.crend());
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("static_vector::find(const value_type&), static_vector::count(const value_type&)") {
+	SECTION("unrolled over a small capacity") {
+		static_vector<std::uint16_t, 8> vec{3, 1, 4, 1, 5};
+		CHECK(vec.find(1) == vec.begin() + 1);
+		CHECK(vec.find(9) == vec.end());
+		CHECK(vec.contains(5));
+		CHECK_FALSE(vec.contains(0));
+		CHECK(vec.count(1) == 2);
+		CHECK(vec.find_if_eq_any({5, 4}) == vec.begin() + 2);
+
+		const auto& cvec = vec;
+		CHECK(cvec.find(4) == cvec.begin() + 2);
+	}
+
+	SECTION("SIMD over a larger capacity") {
+		static_vector<int, 100> vec;
+		for (auto i = 0; i < 70; ++i) vec.push_back(i % 10);
+		CHECK(vec.find(7) == vec.begin() + 7);
+		CHECK(vec.count(7) == 7);
+		CHECK_FALSE(vec.contains(10));
+	}
+}
+TEST_CASE("static_vector::erase_unordered(iterator)") {
+	static_vector<int, 8> vec{0, 1, 2, 3, 4};
+
+	SECTION("the last element fills the hole") {
+		const auto it = vec.erase_unordered(vec.begin() + 1);
+		CHECK(it == vec.begin() + 1);
+		CHECK(vec == static_vector<int, 8>{0, 4, 2, 3});
+	}
+
+	SECTION("erasing the last element") {
+		const auto it = vec.erase_unordered(vec.end() - 1);
+		CHECK(it == vec.end());
+		CHECK(vec == static_vector<int, 8>{0, 1, 2, 3});
+	}
+
+	SECTION("moves rather than copies") {
+		static_vector<TestStruct, 4> structs{1, 2, 3};
+		TestStruct::setup();
+		structs.erase_unordered(structs.begin());
+		CHECK(TestStruct::moveAssigned == 1);
+		CHECK(TestStruct::copyAssigned == 0);
+		CHECK(TestStruct::destructed == 1);
+		CHECK(structs[0].value == 3);
+		CHECK(structs[1].value == 2);
+	}
+}
+
+TEST_CASE("static_vector::erase_unordered(iterator, iterator)") {
+	static_vector<int, 10> vec{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+	SECTION("holes filled from a longer tail") {
+		vec.erase_unordered(vec.begin() + 1, vec.begin() + 3);
+		CHECK(vec == static_vector<int, 10>{0, 8, 9, 3, 4, 5, 6, 7});
+	}
+
+	SECTION("tail shorter than the removed range") {
+		vec.erase_unordered(vec.begin() + 2, vec.begin() + 8);
+		CHECK(vec == static_vector<int, 10>{0, 1, 8, 9});
+	}
+
+	SECTION("tail overlapping the range it would be taken from") {
+		vec.erase_unordered(vec.begin() + 4, vec.begin() + 7);
+		CHECK(vec == static_vector<int, 10>{0, 1, 2, 3, 7, 8, 9});
+	}
+
+	SECTION("range reaching the end") {
+		vec.erase_unordered(vec.begin() + 6, vec.end());
+		CHECK(vec == static_vector<int, 10>{0, 1, 2, 3, 4, 5});
+	}
+
+	SECTION("empty range") {
+		CHECK(vec.erase_unordered(vec.begin() + 3, vec.begin() + 3) == vec.begin() + 3);
+		CHECK(vec.size() == 10);
+	}
+}
+
+TEST_CASE("static_vector::erase_unordered_if(Pred)") {
+	static_vector<int, 16> vec{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	auto calls = 0;
+	CHECK(vec.erase_unordered_if([&](const int value) { ++calls; return value % 3 != 1; }) == 6);
+	CHECK(calls == 10);
+	std::sort(vec.begin(), vec.end());
+	CHECK(vec == static_vector<int, 16>{1, 4, 7, 10});
+
+	CHECK(vec.erase_unordered_if([](const int) { return true; }) == 4);
+	CHECK(vec.empty());
+}
+TEST_CASE("static_vector::sort(), static_vector::sort_by_key(Proj)") {
+	SECTION("every size the sorting network covers") {
+		for (std::size_t size = 0; size <= 64; ++size) {
+			static_vector<std::int16_t, 64> vec;
+			for (std::size_t i = 0; i < size; ++i) vec.push_back(static_cast<std::int16_t>((i * 40503) % 997) - 498);
+			vec.sort();
+			REQUIRE(vec.size() == size);
+			CHECK(std::is_sorted(vec.begin(), vec.end()));
+		}
+	}
+
+	SECTION("repeated values") {
+		static_vector<std::uint8_t, 16> vec{3, 1, 3, 255, 0, 1, 255, 3};
+		vec.sort();
+		CHECK(vec == static_vector<std::uint8_t, 16>{0, 1, 1, 3, 3, 3, 255, 255});
+	}
+
+	SECTION("radix sort without an allocator") {
+		static_vector<float, 1024> vec;
+		for (auto i = 0; i < 1024; ++i) vec.push_back(static_cast<float>((i * 37) % 1024) - 512.5f);
+		vec.sort();
+		CHECK(std::is_sorted(vec.begin(), vec.end()));
+		CHECK(vec.front() == -512.5f);
+	}
+
+	SECTION("by key") {
+		static_vector<std::pair<int, char>, 8> vec{{3, 'c'}, {-1, 'a'}, {2, 'b'}};
+		vec.sort_by_key([](const std::pair<int, char>& entry) { return entry.first; });
+		CHECK(vec == static_vector<std::pair<int, char>, 8>{{-1, 'a'}, {2, 'b'}, {3, 'c'}});
+	}
+}
+TEST_CASE("static_vector::dedup(), static_vector::dedup_by(Proj)") {
+	SECTION("runs of equal elements") {
+		static_vector<int, 16> vec{1, 1, 2, 3, 3, 3, 1, 4, 4};
+		CHECK(vec.dedup() == 4);
+		CHECK(vec == static_vector<int, 16>{1, 2, 3, 1, 4});
+		CHECK(vec.dedup() == 0);
+		CHECK(vec == static_vector<int, 16>{1, 2, 3, 1, 4});
+	}
+
+	SECTION("short and empty") {
+		static_vector<int, 4> empty;
+		CHECK(empty.dedup() == 0);
+		static_vector<int, 4> single{7};
+		CHECK(single.dedup() == 0);
+		static_vector<int, 4> same{7, 7, 7, 7};
+		CHECK(same.dedup() == 3);
+		CHECK(same == static_vector<int, 4>{7});
+	}
+
+	SECTION("by key") {
+		static_vector<std::pair<int, char>, 8> vec{{1, 'a'}, {1, 'b'}, {2, 'c'}, {2, 'd'}, {1, 'e'}};
+		CHECK(vec.dedup_by([](const std::pair<int, char>& entry) { return entry.first; }) == 2);
+		CHECK(vec == static_vector<std::pair<int, char>, 8>{{1, 'a'}, {2, 'c'}, {1, 'e'}});
+	}
+}
+
+TEST_CASE("static_vector::dedup_unordered(), static_vector::dedup_unordered_by(Proj)") {
+	SECTION("the first of each value is kept in order") {
+		static_vector<std::uint64_t, 16> vec{5, 3, 5, 1, 3, 3, 9, 1, 5};
+		CHECK(vec.dedup_unordered() == 5);
+		CHECK(vec == static_vector<std::uint64_t, 16>{5, 3, 1, 9});
+	}
+
+	SECTION("a table too large for the stack without an allocator") {
+		static_vector<int, 1000> vec;
+		for (auto i = 0; i < 1000; ++i) vec.push_back((i * 37) % 250);
+		CHECK(vec.dedup_unordered() == 750);
+		REQUIRE(vec.size() == 250);
+		for (auto i = 0; i < 250; ++i) CHECK(vec[i] == (i * 37) % 250);
+	}
+
+	SECTION("by key") {
+		static_vector<std::pair<int, char>, 8> vec{{2, 'a'}, {1, 'b'}, {2, 'c'}, {3, 'd'}, {1, 'e'}};
+		CHECK(vec.dedup_unordered_by([](const std::pair<int, char>& entry) { return entry.first; }) == 2);
+		CHECK(vec == static_vector<std::pair<int, char>, 8>{{2, 'a'}, {1, 'b'}, {3, 'd'}});
+	}
+}
@@ -0,0 +1,127 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/string_vector.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace perfvect;
+using namespace std::string_view_literals;
+
+namespace {
+	template<typename Vec>
+	auto to_strings(const Vec& vec) {
+		return std::vector<std::string>(vec.begin(), vec.end());
+	}
+}
+
+TEST_CASE("string_vector(), string_vector::size(), string_vector::empty()") {
+	string_vector vec;
+	CHECK(vec.size() == 0);
+	CHECK(vec.empty());
+	CHECK(vec.char_count() == 0);
+	CHECK(vec.begin() == vec.end());
+}
+
+TEST_CASE("string_vector::push_back(std::string_view)") {
+	string_vector vec;
+	vec.push_back("alpha");
+	vec.push_back("");
+	vec.push_back(std::string("gamma"));
+
+	REQUIRE(vec.size() == 3);
+	CHECK(vec[0] == "alpha");
+	CHECK(vec[1].empty());
+	CHECK(vec.back() == "gamma");
+	CHECK(vec.at(2) == "gamma");
+	CHECK_THROWS_AS(vec.at(3), std::out_of_range);
+	CHECK(vec.chars() == "alphagamma");
+	CHECK(vec[2].data() == vec[0].data() + 5);
+
+	vec.pop_back();
+	CHECK(vec.size() == 2);
+	CHECK(vec.char_count() == 5);
+}
+
+TEST_CASE("string_vector::append(InputIt, InputIt)") {
+	const std::vector<std::string> words{"one", "two", "three"};
+	string_vector vec{"zero"sv};
+	vec.append(words.begin(), words.end());
+	CHECK(to_strings(vec) == std::vector<std::string>{"zero", "one", "two", "three"});
+	CHECK(vec.end() - vec.begin() == 4);
+	CHECK(vec.begin()[3] == "three");
+}
+
+TEST_CASE("string_vector::append_split(std::string_view, char)") {
+	string_vector vec;
+	vec.append_split("  the quick  brown fox ", ' ');
+	CHECK(to_strings(vec) == std::vector<std::string>{"the", "quick", "brown", "fox"});
+	CHECK(vec.char_count() == 16);
+	vec.append_split("", ' ');
+	vec.append_split("jumps", ' ');
+	CHECK(vec.size() == 5);
+	CHECK(vec.back() == "jumps");
+}
+
+TEST_CASE("string_vector::erase()") {
+	string_vector vec{"a"sv, "bb"sv, "ccc"sv, "dddd"sv, "eeeee"sv};
+
+	SECTION("erase(const_iterator)") {
+		const auto it = vec.erase(vec.begin() + 1);
+		CHECK(*it == "ccc");
+		CHECK(to_strings(vec) == std::vector<std::string>{"a", "ccc", "dddd", "eeeee"});
+		CHECK(vec.chars() == "acccddddeeeee");
+	}
+
+	SECTION("erase(const_iterator, const_iterator) to the end") {
+		vec.erase(vec.begin() + 3, vec.end());
+		CHECK(to_strings(vec) == std::vector<std::string>{"a", "bb", "ccc"});
+		CHECK(vec.char_count() == 6);
+	}
+
+	SECTION("erase_if(Pred)") {
+		CHECK(vec.erase_if([](std::string_view str) { return str.size() % 2 == 1; }) == 3);
+		CHECK(to_strings(vec) == std::vector<std::string>{"bb", "dddd"});
+		CHECK(vec.chars() == "bbdddd");
+		vec.push_back("f");
+		CHECK(vec.back() == "f");
+	}
+}
+
+TEST_CASE("small_string_vector") {
+	small_string_vector<16, 4> vec;
+	vec.append_split("a b c d", ' ');
+	CHECK(vec.size() == 4);
+	vec.append_split("lengthy tokens spill to the heap", ' ');
+	CHECK(to_strings(vec) == std::vector<std::string>{"a", "b", "c", "d", "lengthy", "tokens", "spill", "to", "the", "heap"});
+
+	small_string_vector<16, 4> other;
+	other.swap(vec);
+	CHECK(vec.empty());
+	CHECK(other.size() == 10);
+}
+TEST_CASE("string_vector appending views of its own strings") {
+	small_string_vector<4, 2> vec{"abcd"sv};
+
+	SECTION("push_back(std::string_view)") {
+		vec.push_back(vec[0]);
+		vec.push_back(vec[1].substr(1, 2));
+		CHECK(to_strings(vec) == std::vector<std::string>{"abcd", "abcd", "bc"});
+	}
+
+	SECTION("append(InputIt, InputIt)") {
+		vec.push_back("efgh");
+		const std::vector<std::string_view> views{vec[1], vec[0], vec[1]};
+		vec.append(views.begin(), views.end());
+		CHECK(to_strings(vec) == std::vector<std::string>{"abcd", "efgh", "efgh", "abcd", "efgh"});
+		vec.append(vec.begin(), vec.end());
+		CHECK(vec.size() == 10);
+		CHECK(vec.chars() == "abcdefghefghabcdefghabcdefghefghabcdefgh");
+	}
+
+	SECTION("append_split(std::string_view, char)") {
+		vec.push_back("ef gh ij");
+		vec.append_split(vec[1], ' ');
+		CHECK(to_strings(vec) == std::vector<std::string>{"abcd", "ef gh ij", "ef", "gh", "ij"});
+	}
+}
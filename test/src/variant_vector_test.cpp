@@ -0,0 +1,110 @@
+#include "catch.hpp"
+#include "helper.h"
+#include <perfvect/variant_vector.h>
+#include <string>
+#include <vector>
+
+using namespace perfvect;
+
+namespace {
+	using mixed = variant_vector<int, double, std::string>;
+}
+
+TEST_CASE("variant_vector(), variant_vector::size(), variant_vector::empty()") {
+	mixed vec;
+	CHECK(vec.size() == 0);
+	CHECK(vec.empty());
+	CHECK(vec.count<int>() == 0);
+}
+
+TEST_CASE("variant_vector::push_back(T&&), variant_vector::emplace_back<T>(Args&&...)") {
+	mixed vec;
+	vec.push_back(1);
+	vec.push_back(2.5);
+	vec.emplace_back<std::string>("xxx");
+	vec.push_back(4);
+	vec.push_back(mixed::variant_type(std::string("five")));
+
+	REQUIRE(vec.size() == 5);
+	CHECK(vec.count<int>() == 2);
+	CHECK(vec.count<double>() == 1);
+	CHECK(vec.count<std::string>() == 2);
+
+	SECTION("positional access") {
+		CHECK(vec.index(0) == 0);
+		CHECK(vec.index(2) == 2);
+		CHECK(vec.holds<double>(1));
+		CHECK(vec.get<int>(3) == 4);
+		CHECK(vec.get<std::string>(2) == "xxx");
+		CHECK(vec.get_if<int>(1) == nullptr);
+		CHECK(*vec.get_if<double>(1) == 2.5);
+		CHECK_THROWS_AS(vec.get<int>(4), std::bad_variant_access);
+		CHECK(vec.to_variant(4) == mixed::variant_type(std::string("five")));
+		CHECK(vec.visit(0, [](const auto& value) { return sizeof(value); }) == sizeof(int));
+	}
+
+	SECTION("visit_ordered() follows insertion order") {
+		std::vector<std::size_t> order;
+		vec.visit_ordered([&order](const auto& value) {
+			order.push_back(mixed::index_of<std::decay_t<decltype(value)>>);
+		});
+		CHECK(order == std::vector<std::size_t>{0, 1, 2, 0, 2});
+	}
+
+	SECTION("visit_batched() groups by alternative") {
+		std::vector<std::size_t> order;
+		vec.visit_batched([&order](auto& value) {
+			order.push_back(mixed::index_of<std::decay_t<decltype(value)>>);
+			if constexpr (std::is_same_v<std::decay_t<decltype(value)>, int>) value *= 10;
+		});
+		CHECK(order == std::vector<std::size_t>{0, 0, 1, 2, 2});
+		CHECK(vec.get<int>(0) == 10);
+		CHECK(vec.get<int>(3) == 40);
+	}
+
+	SECTION("for_each_column() passes each column whole") {
+		std::vector<std::size_t> counts;
+		vec.for_each_column([&counts](const auto*, const std::size_t count) { counts.push_back(count); });
+		CHECK(counts == std::vector<std::size_t>{2, 1, 2});
+	}
+
+	SECTION("pop_back()") {
+		vec.pop_back();
+		vec.pop_back();
+		CHECK(vec.size() == 3);
+		CHECK(vec.count<int>() == 1);
+		CHECK(vec.count<std::string>() == 1);
+		CHECK(vec.column<std::string>()[0] == "xxx");
+	}
+}
+
+TEST_CASE("variant_vector::clear()") {
+	TestStruct::setup();
+	variant_vector<int, TestStruct> vec;
+	vec.reserve<TestStruct>(2);
+	vec.emplace_back<TestStruct>(1);
+	vec.emplace_back<TestStruct>(2);
+	vec.push_back(3);
+	vec.clear();
+	CHECK(vec.empty());
+	CHECK(vec.count<TestStruct>() == 0);
+	CHECK(TestStruct::destructed == 2);
+}
+
+TEST_CASE("unordered_variant_vector") {
+	unordered_variant_vector<int, double> vec;
+	vec.push_back(1);
+	vec.push_back(2.0);
+	vec.push_back(3);
+	CHECK(vec.size() == 3);
+
+	auto sum = 0.0;
+	vec.visit_batched([&sum](const auto value) { sum += value; });
+	CHECK(sum == 6.0);
+
+	unordered_variant_vector<int, double> other;
+	other.push_back(4.0);
+	vec.swap(other);
+	CHECK(vec.size() == 1);
+	CHECK(other.count<int>() == 2);
+}
\ No newline at end of file
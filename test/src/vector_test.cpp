@@ -1,10 +1,36 @@
 #include <perfvect/vector.h>
+#include <perfvect/small_vector.h>
+#include <perfvect/static_vector.h>
 #include <array>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
 #include "catch.hpp"
 #include "helper.h"
 
 using namespace perfvect;
 
+namespace {
+	// equal by key alone, although its tag makes the bytes differ
+	struct keyed {
+		int key;
+		int tag;
+
+		auto operator==(const keyed& other) const noexcept {
+			return key == other.key;
+		}
+	};
+}
+
+template<>
+struct std::hash<keyed> {
+	auto operator()(const keyed& value) const noexcept {
+		return std::hash<int>()(value.key);
+	}
+};
+
 TEST_CASE("vector()") {
 	SECTION("default constructor") {
 		vector<int> vec;
@@ -139,4 +165,153 @@ TEST_CASE("vector::reserve(size_type)") {
 		CHECK(vec[0].wasMoveConstructed);
 		CHECK(vec[1].wasMoveConstructed);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("vector::fill(const value_type&)") {
+	vector<int> vec{1, 2};
+	vec.reserve(5);
+	vec.fill(7);
+	REQUIRE(vec.size() == 5);
+	CHECK(vec == vector<int>{7, 7, 7, 7, 7});
+}
+
+TEST_CASE("operator==(const static_vector_base&, const static_vector_base&)") {
+	const vector<int> a{1, 2, 3};
+	const small_vector<int, 2> b{1, 2, 3};
+	const static_vector<int, 8> c{1, 2, 4};
+	const small_vector<int, 16> d{1, 2};
+
+	CHECK(a == b);
+	CHECK(b == a);
+	CHECK_FALSE(a != b);
+	CHECK(a != c);
+	CHECK(a != d);
+	CHECK(vector<int>{} == static_vector<int, 4>{});
+
+	SECTION("floating point follows element equality") {
+		const small_vector<double, 2> x{0.0, 1.0, 2.0, 3.0, 4.0};
+		const vector<double> y{-0.0, 1.0, 2.0, 3.0, 4.0};
+		CHECK(x == y);
+		const vector<double> nan{std::numeric_limits<double>::quiet_NaN()};
+		CHECK(nan != nan);
+	}
+
+	SECTION("long vectors differing only at the end") {
+		vector<std::uint16_t> long_a(1000, 7);
+		small_vector<std::uint16_t, 8> long_b(long_a.begin(), long_a.end());
+		CHECK(long_a == long_b);
+		long_b.back() = 8;
+		CHECK(long_a != long_b);
+	}
+
+	SECTION("non-trivial elements") {
+		CHECK(vector<std::string>{"a", "b"} == small_vector<std::string, 1>{"a", "b"});
+		CHECK(vector<std::string>{"a", "b"} != small_vector<std::string, 1>{"a", "c"});
+	}
+}
+
+TEST_CASE("operator<(const static_vector_base&, const static_vector_base&)") {
+	const vector<int> a{1, 2, 3};
+	CHECK(a < small_vector<int, 2>{1, 2, 4});
+	CHECK(a < static_vector<int, 4>{1, 2, 3, 0});
+	CHECK_FALSE(a < vector<int>{1, 2, 3});
+	CHECK(a <= vector<int>{1, 2, 3});
+	CHECK(a >= vector<int>{1, 2, 3});
+	CHECK(a > vector<int>{1, 2});
+	CHECK(a > vector<int>{0, 9, 9, 9});
+	CHECK(vector<int>{-1} < vector<int>{1});
+	CHECK(vector<std::uint32_t>{0x100} > vector<std::uint32_t>{0xFF});
+
+	vector<std::int64_t> long_a(300, 5);
+	vector<std::int64_t> long_b(300, 5);
+	long_b[250] = -5;
+	CHECK(long_b < long_a);
+	CHECK(vector<std::string>{"a", "b"} < vector<std::string>{"a", "c"});
+}
+
+TEST_CASE("std::hash<vector>") {
+	const vector<int> a{1, 2, 3};
+	const small_vector<int, 2> b{1, 2, 3};
+	const static_vector<int, 8> c{1, 2, 3};
+	CHECK(std::hash<vector<int>>()(a) == std::hash<small_vector<int, 2>>()(b));
+	CHECK(std::hash<vector<int>>()(a) == std::hash<static_vector<int, 8>>()(c));
+	CHECK(std::hash<vector<int>>()(a) != std::hash<vector<int>>()(vector<int>{1, 2}));
+
+	std::unordered_map<small_vector<std::uint32_t, 4>, int> counts;
+	for (std::uint32_t i = 0; i < 100; ++i) ++counts[small_vector<std::uint32_t, 4>{i % 10, i % 3}];
+	CHECK(counts.size() == 30);
+	CHECK((counts[small_vector<std::uint32_t, 4>{1, 1}]) == 4);
+
+	std::unordered_map<vector<std::string>, int> by_strings;
+	by_strings[vector<std::string>{"x", "y"}] = 1;
+	CHECK(by_strings.count(vector<std::string>{"x", "y"}) == 1);
+
+	SECTION("equal vectors hash equally when == ignores part of the element") {
+		static_assert(std::has_unique_object_representations_v<keyed>);
+		const vector<keyed> lhs{{1, 2}, {4, 5}};
+		const small_vector<keyed, 4> rhs{{1, 3}, {4, 6}};
+		REQUIRE(lhs == rhs);
+		CHECK(std::hash<vector<keyed>>()(lhs) == std::hash<small_vector<keyed, 4>>()(rhs));
+	}
+}
+
+TEST_CASE("vector::sort() takes its scratch buffer from the allocator") {
+	struct counting_resource : std::pmr::memory_resource {
+		std::size_t allocations = 0;
+
+		auto do_allocate(const std::size_t bytes, const std::size_t align)->void* override {
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, align);
+		}
+
+		auto do_deallocate(void* ptr, const std::size_t bytes, const std::size_t align)->void override {
+			std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+		}
+
+		auto do_is_equal(const std::pmr::memory_resource& other) const noexcept->bool override {
+			return this == &other;
+		}
+	};
+
+	counting_resource resource;
+	const std::pmr::polymorphic_allocator<std::uint32_t> alloc(&resource);
+	vector<std::uint32_t> vec(alloc);
+	for (std::uint32_t i = 0; i < 1000; ++i) vec.push_back((i * 2654435761u) >> 7);
+	const auto before = resource.allocations;
+	vec.sort();
+	CHECK(resource.allocations == before + 1);
+	CHECK(std::is_sorted(vec.begin(), vec.end()));
+}
+TEST_CASE("vector::dedup_unordered() takes a large hash table from the allocator") {
+	struct counting_resource : std::pmr::memory_resource {
+		std::size_t allocations = 0;
+
+		auto do_allocate(const std::size_t bytes, const std::size_t align)->void* override {
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, align);
+		}
+
+		auto do_deallocate(void* ptr, const std::size_t bytes, const std::size_t align)->void override {
+			std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+		}
+
+		auto do_is_equal(const std::pmr::memory_resource& other) const noexcept->bool override {
+			return this == &other;
+		}
+	};
+
+	counting_resource resource;
+	const std::pmr::polymorphic_allocator<std::uint32_t> alloc(&resource);
+	vector<std::uint32_t> vec(alloc);
+	for (std::uint32_t i = 0; i < 100; ++i) vec.push_back(i % 10);
+	auto before = resource.allocations;
+	CHECK(vec.dedup_unordered() == 90);
+	CHECK(resource.allocations == before);
+
+	for (std::uint32_t i = 0; i < 1000; ++i) vec.push_back(i % 500);
+	before = resource.allocations;
+	CHECK(vec.dedup_unordered() == 510);
+	CHECK(resource.allocations == before + 1);
+	REQUIRE(vec.size() == 500);
+	for (std::uint32_t i = 0; i < 500; ++i) CHECK(vec[i] == i);
+}